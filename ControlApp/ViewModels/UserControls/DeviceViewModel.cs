@@ -107,10 +107,14 @@ public partial class DeviceViewModel : ObservableObject
     public PnPDevice Device { get; }
 
     /// <summary>
-    ///     Current HID device emulation mode.
+    ///     Current HID device emulation mode, <see cref="SettingsContext.Unknown" /> for modes without app settings
+    ///     (e.g. raw passthrough).
     /// </summary>
     public SettingsContext HidEmulationMode =>
-        DshmDriverTranslationUtils.HidDeviceMode[Device.GetProperty<byte>(DsHidMiniDriver.HidDeviceModeProperty)];
+        DshmDriverTranslationUtils.HidDeviceMode.TryGetValue(
+            Device.GetProperty<byte>(DsHidMiniDriver.HidDeviceModeProperty), out SettingsContext mode)
+            ? mode
+            : SettingsContext.Unknown;
 
     public HidModeShort HidModeShort => (HidModeShort)HidEmulationMode;
 
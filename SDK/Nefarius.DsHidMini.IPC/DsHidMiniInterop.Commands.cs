@@ -52,13 +52,11 @@ public partial class DsHidMiniInterop
 
         ValidateDeviceIndex(deviceIndex);
 
-        ref IPC_HID_INPUT_REPORT_MESSAGE message = ref Unsafe.AsRef<IPC_HID_INPUT_REPORT_MESSAGE>(_hidView);
+        ref IPC_HID_INPUT_REPORT_MESSAGE message = ref GetHidInputReportMessage(deviceIndex);
 
         if (timeout.HasValue)
         {
-            _inputReportEvent ??= GetHidReportWaitHandle(deviceIndex);
-
-            _inputReportEvent.WaitOne(timeout.Value);
+            GetInputReportEvent(deviceIndex).WaitOne(timeout.Value);
         }
 
         //
@@ -66,6 +64,7 @@ public partial class DsHidMiniInterop
         // 
         if (message.SlotIndex == 0)
         {
+            ReleaseInputReportEvent(deviceIndex);
             return false;
         }
 
@@ -82,6 +81,97 @@ public partial class DsHidMiniInterop
         return true;
     }
 
+    /// <summary>
+    ///     Attempts to read the <see cref="DS3_RAW_INPUT_REPORT" /> and the matching calibrated
+    ///     <see cref="DS3_MOTION_SAMPLE" /> from a given device instance.
+    /// </summary>
+    /// <remarks>Behaves like <see cref="GetRawInputReport" />, see remarks there.</remarks>
+    /// <param name="deviceIndex">The one-based device index.</param>
+    /// <param name="report">The <see cref="DS3_RAW_INPUT_REPORT" /> to populate.</param>
+    /// <param name="motion">The <see cref="DS3_MOTION_SAMPLE" /> to populate.</param>
+    /// <param name="isUpdated">
+    ///     FALSE if waiting for a report update timed out, the returned values are the ones already read
+    ///     before. Always TRUE if no <paramref name="timeout" /> was given.
+    /// </param>
+    /// <param name="timeout">Optional timeout to wait for a report update to arrive. Default invocation returns immediately.</param>
+    /// <returns>
+    ///     TRUE if <paramref name="report" /> and <paramref name="motion" /> got filled in or FALSE if the given
+    ///     <paramref name="deviceIndex" /> is not occupied.
+    /// </returns>
+    [SuppressMessage("ReSharper", "UnusedMember.Global")]
+    public unsafe bool GetRawInputReport(int deviceIndex, ref DS3_RAW_INPUT_REPORT report, ref DS3_MOTION_SAMPLE motion,
+        out bool isUpdated, TimeSpan? timeout = null)
+    {
+        isUpdated = true;
+
+        if (_hidView is null)
+        {
+            throw new DsHidMiniInteropUnavailableException();
+        }
+
+        ValidateDeviceIndex(deviceIndex);
+
+        ref IPC_HID_INPUT_REPORT_MESSAGE message = ref GetHidInputReportMessage(deviceIndex);
+        ref IPC_HID_MOTION_MESSAGE motionMessage = ref Unsafe.As<byte, IPC_HID_MOTION_MESSAGE>(ref Unsafe.Add(
+            ref Unsafe.AsRef<byte>(_hidView),
+            HidMotionRegionOffset + (deviceIndex - 1) * Marshal.SizeOf<IPC_HID_MOTION_MESSAGE>()));
+
+        if (timeout.HasValue)
+        {
+            isUpdated = GetInputReportEvent(deviceIndex).WaitOne(timeout.Value);
+        }
+
+        //
+        // The driver bumps the sequence before and after updating both slots, so an unchanged even
+        // sequence guarantees the report and motion values were taken from the same input report
+        // 
+        for (int attempt = 0; attempt < MaxSequenceReadAttempts; attempt++)
+        {
+            int sequence = Volatile.Read(ref motionMessage.Sequence);
+
+            if ((sequence & 1) != 0)
+            {
+                Thread.SpinWait(1);
+                continue;
+            }
+
+            uint slotIndex = message.SlotIndex;
+            DS3_RAW_INPUT_REPORT reportCopy = message.InputReport;
+            DS3_MOTION_SAMPLE motionCopy = motionMessage.Motion;
+
+            Interlocked.MemoryBarrier();
+
+            if (Volatile.Read(ref motionMessage.Sequence) != sequence)
+            {
+                continue;
+            }
+
+            //
+            // Device is/got disconnected
+            // 
+            if (slotIndex == 0)
+            {
+                ReleaseInputReportEvent(deviceIndex);
+                return false;
+            }
+
+            //
+            // Index mismatch is not supposed to happen
+            // 
+            if (slotIndex != deviceIndex)
+            {
+                throw new DsHidMiniInteropUnexpectedReplyException();
+            }
+
+            report = reportCopy;
+            motion = motionCopy;
+
+            return true;
+        }
+
+        throw new DsHidMiniInteropUnexpectedReplyException();
+    }
+
     /// <summary>
     ///     Send a PING to the driver and awaits the reply.
     /// </summary>
@@ -302,4 +392,151 @@ public partial class DsHidMiniInterop
             _commandMutex.ReleaseMutex();
         }
     }
+
+    /// <summary>
+    ///     Reads the per-stage input latency statistics of the given device.
+    /// </summary>
+    /// <param name="deviceIndex">The one-based device index.</param>
+    /// <exception cref="DsHidMiniInteropUnavailableException">
+    ///     Driver IPC unavailable, make sure that at least one compatible
+    ///     controller is connected and operational.
+    /// </exception>
+    /// <exception cref="DsHidMiniInteropInvalidDeviceIndexException">
+    ///     The <paramref name="deviceIndex" /> was outside a valid
+    ///     range.
+    /// </exception>
+    /// <exception cref="DsHidMiniInteropConcurrencyException">A different thread is currently performing a data exchange.</exception>
+    /// <exception cref="DsHidMiniInteropReplyTimeoutException">The driver didn't respond within an expected period.</exception>
+    /// <exception cref="DsHidMiniInteropUnexpectedReplyException">
+    ///     The driver returned unexpected or malformed data, this is
+    ///     also the case if the driver got built without input latency instrumentation.
+    /// </exception>
+    /// <returns>The <see cref="InputLatencyStatistics" /> accumulated since the device got connected.</returns>
+    [SuppressMessage("ReSharper", "UnusedMember.Global")]
+    public unsafe InputLatencyStatistics GetInputLatencyStatistics(int deviceIndex)
+    {
+        if (_commandMutex is null || _cmdView is null)
+        {
+            throw new DsHidMiniInteropUnavailableException();
+        }
+
+        ValidateDeviceIndex(deviceIndex);
+
+        AcquireCommandLock();
+
+        try
+        {
+            ref DSHM_IPC_MSG_HEADER request = ref Unsafe.AsRef<DSHM_IPC_MSG_HEADER>(_cmdView);
+
+            request.Type = DSHM_IPC_MSG_TYPE.DSHM_IPC_MSG_TYPE_RESPONSE_ONLY;
+            request.Target = DSHM_IPC_MSG_TARGET.DSHM_IPC_MSG_TARGET_DEVICE;
+            request.Command.Device = DSHM_IPC_MSG_CMD_DEVICE.DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_LATENCY;
+            request.TargetIndex = (uint)deviceIndex;
+            request.Size = (uint)Marshal.SizeOf<DSHM_IPC_MSG_HEADER>();
+
+            if (!SendAndWait())
+            {
+                throw new DsHidMiniInteropReplyTimeoutException();
+            }
+
+            ref DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE reply =
+                ref Unsafe.AsRef<DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE>(_cmdView);
+
+            //
+            // Plausibility check
+            // 
+            if (reply.Header is
+                {
+                    Type: DSHM_IPC_MSG_TYPE.DSHM_IPC_MSG_TYPE_RESPONSE_ONLY,
+                    Target: DSHM_IPC_MSG_TARGET.DSHM_IPC_MSG_TARGET_CLIENT,
+                    Command.Device: DSHM_IPC_MSG_CMD_DEVICE.DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_LATENCY
+                }
+                && reply.Header.TargetIndex == deviceIndex
+                && reply.Header.Size == Marshal.SizeOf<DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE>())
+            {
+                return new InputLatencyStatistics
+                {
+                    Frequency = reply.Frequency,
+                    IpcPublish = reply.IpcPublish,
+                    PostTransform = reply.PostTransform,
+                    HidSubmit = reply.HidSubmit
+                };
+            }
+
+            throw new DsHidMiniInteropUnexpectedReplyException(ref reply.Header);
+        }
+        finally
+        {
+            _commandMutex.ReleaseMutex();
+        }
+    }
+
+    /// <summary>
+    ///     Reads the input report inter-arrival statistics of the given device.
+    /// </summary>
+    /// <param name="deviceIndex">The one-based device index.</param>
+    /// <exception cref="DsHidMiniInteropUnavailableException">
+    ///     Driver IPC unavailable, make sure that at least one compatible
+    ///     controller is connected and operational.
+    /// </exception>
+    /// <exception cref="DsHidMiniInteropInvalidDeviceIndexException">
+    ///     The <paramref name="deviceIndex" /> was outside a valid
+    ///     range.
+    /// </exception>
+    /// <exception cref="DsHidMiniInteropConcurrencyException">A different thread is currently performing a data exchange.</exception>
+    /// <exception cref="DsHidMiniInteropReplyTimeoutException">The driver didn't respond within an expected period.</exception>
+    /// <exception cref="DsHidMiniInteropUnexpectedReplyException">The driver returned unexpected or malformed data.</exception>
+    /// <returns>The <see cref="InputIntervalStatistics" /> accumulated since the device got connected.</returns>
+    [SuppressMessage("ReSharper", "UnusedMember.Global")]
+    public unsafe InputIntervalStatistics GetInputIntervalStatistics(int deviceIndex)
+    {
+        if (_commandMutex is null || _cmdView is null)
+        {
+            throw new DsHidMiniInteropUnavailableException();
+        }
+
+        ValidateDeviceIndex(deviceIndex);
+
+        AcquireCommandLock();
+
+        try
+        {
+            ref DSHM_IPC_MSG_HEADER request = ref Unsafe.AsRef<DSHM_IPC_MSG_HEADER>(_cmdView);
+
+            request.Type = DSHM_IPC_MSG_TYPE.DSHM_IPC_MSG_TYPE_RESPONSE_ONLY;
+            request.Target = DSHM_IPC_MSG_TARGET.DSHM_IPC_MSG_TARGET_DEVICE;
+            request.Command.Device = DSHM_IPC_MSG_CMD_DEVICE.DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_INTERVAL;
+            request.TargetIndex = (uint)deviceIndex;
+            request.Size = (uint)Marshal.SizeOf<DSHM_IPC_MSG_HEADER>();
+
+            if (!SendAndWait())
+            {
+                throw new DsHidMiniInteropReplyTimeoutException();
+            }
+
+            ref DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE reply =
+                ref Unsafe.AsRef<DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE>(_cmdView);
+
+            //
+            // Plausibility check
+            // 
+            if (reply.Header is
+                {
+                    Type: DSHM_IPC_MSG_TYPE.DSHM_IPC_MSG_TYPE_RESPONSE_ONLY,
+                    Target: DSHM_IPC_MSG_TARGET.DSHM_IPC_MSG_TARGET_CLIENT,
+                    Command.Device: DSHM_IPC_MSG_CMD_DEVICE.DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_INTERVAL
+                }
+                && reply.Header.TargetIndex == deviceIndex
+                && reply.Header.Size == Marshal.SizeOf<DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE>())
+            {
+                return reply.Statistics;
+            }
+
+            throw new DsHidMiniInteropUnexpectedReplyException(ref reply.Header);
+        }
+        finally
+        {
+            _commandMutex.ReleaseMutex();
+        }
+    }
 }
\ No newline at end of file
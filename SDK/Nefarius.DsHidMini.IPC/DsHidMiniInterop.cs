@@ -29,6 +29,16 @@ public sealed partial class DsHidMiniInterop : IDisposable
     private const string WriteEventName = "Global\\DsHidMiniWriteEvent";
     private const string MutexName = "Global\\DsHidMiniCommandMutex";
 
+    /// <summary>
+    ///     Offset of the <see cref="IPC_HID_MOTION_MESSAGE" /> array within the HID view.
+    /// </summary>
+    private const int HidMotionRegionOffset = 0x8000;
+
+    /// <summary>
+    ///     How often a consistent copy of a HID slot is attempted before giving up.
+    /// </summary>
+    private const int MaxSequenceReadAttempts = 100;
+
     private readonly Dictionary<int, PnPDevice> _connectedDevices = new();
     private readonly DeviceNotificationListener _deviceListener = new();
     private MEMORY_MAPPED_VIEW_ADDRESS? _cmdView;
@@ -38,7 +48,10 @@ public sealed partial class DsHidMiniInterop : IDisposable
     private SafeFileHandle? _fileMapping;
     private MEMORY_MAPPED_VIEW_ADDRESS? _hidView;
 
-    private EventWaitHandle? _inputReportEvent;
+    /// <summary>
+    ///     Input report wait handles of each device index, only valid as long as the device stays connected.
+    /// </summary>
+    private readonly Dictionary<int, EventWaitHandle> _inputReportEvents = new();
 
     private EventWaitHandle? _readEvent;
     private EventWaitHandle? _writeEvent;
@@ -53,7 +66,15 @@ public sealed partial class DsHidMiniInterop : IDisposable
     /// </exception>
     public DsHidMiniInterop()
     {
-        Reconnect();
+        try
+        {
+            Reconnect();
+        }
+        catch
+        {
+            _deviceListener.Dispose();
+            throw;
+        }
 
         _deviceListener.RegisterDeviceArrived(DsHidMiniDeviceArrived, DsHidMiniDriver.DeviceInterfaceGuid);
         _deviceListener.RegisterDeviceRemoved(DsHidMiniDeviceRemoved, DsHidMiniDriver.DeviceInterfaceGuid);
@@ -84,24 +105,49 @@ public sealed partial class DsHidMiniInterop : IDisposable
 
     /// <inheritdoc />
     public void Dispose()
+    {
+        _deviceListener.Dispose();
+
+        ReleaseSharedResources();
+    }
+
+    /// <summary>
+    ///     Lets go of all driver objects, <see cref="Reconnect" /> acquires them again.
+    /// </summary>
+    private void ReleaseSharedResources()
     {
         if (_cmdView.HasValue)
         {
             PInvoke.UnmapViewOfFile(_cmdView.Value);
+            _cmdView = null;
         }
 
         if (_hidView.HasValue)
         {
             PInvoke.UnmapViewOfFile(_hidView.Value);
+            _hidView = null;
         }
 
         _fileMapping?.Dispose();
+        _fileMapping = null;
 
         _readEvent?.Dispose();
+        _readEvent = null;
         _writeEvent?.Dispose();
-        _inputReportEvent?.Dispose();
+        _writeEvent = null;
+
+        lock (_inputReportEvents)
+        {
+            foreach (EventWaitHandle inputReportEvent in _inputReportEvents.Values)
+            {
+                inputReportEvent.Dispose();
+            }
+
+            _inputReportEvents.Clear();
+        }
 
         _commandMutex?.Dispose();
+        _commandMutex = null;
     }
 
     /// <summary>
@@ -187,7 +233,7 @@ public sealed partial class DsHidMiniInterop : IDisposable
         // 
         if (_connectedDevices.Count == 0)
         {
-            Dispose();
+            ReleaseSharedResources();
         }
     }
 
@@ -212,6 +258,49 @@ public sealed partial class DsHidMiniInterop : IDisposable
         RefreshDevices();
     }
 
+    /// <summary>
+    ///     Gets the input report slot of the given device within the HID view.
+    /// </summary>
+    private unsafe ref IPC_HID_INPUT_REPORT_MESSAGE GetHidInputReportMessage(int deviceIndex)
+    {
+        return ref Unsafe.As<byte, IPC_HID_INPUT_REPORT_MESSAGE>(ref Unsafe.Add(
+            ref Unsafe.AsRef<byte>(_hidView),
+            (deviceIndex - 1) * Marshal.SizeOf<IPC_HID_INPUT_REPORT_MESSAGE>()));
+    }
+
+    /// <summary>
+    ///     Gets the cached input report wait handle of the given device or requests it from the driver.
+    /// </summary>
+    /// <remarks>Serialized so multiple threads sharing this instance don't compete for the command region.</remarks>
+    private EventWaitHandle GetInputReportEvent(int deviceIndex)
+    {
+        lock (_inputReportEvents)
+        {
+            if (!_inputReportEvents.TryGetValue(deviceIndex, out EventWaitHandle? inputReportEvent))
+            {
+                inputReportEvent = GetHidReportWaitHandle(deviceIndex);
+                _inputReportEvents.Add(deviceIndex, inputReportEvent);
+            }
+
+            return inputReportEvent;
+        }
+    }
+
+    /// <summary>
+    ///     Drops the cached input report wait handle of a device that got disconnected, the next device occupying the
+    ///     same index comes with its own.
+    /// </summary>
+    private void ReleaseInputReportEvent(int deviceIndex)
+    {
+        lock (_inputReportEvents)
+        {
+            if (_inputReportEvents.Remove(deviceIndex, out EventWaitHandle? inputReportEvent))
+            {
+                inputReportEvent.Dispose();
+            }
+        }
+    }
+
     /// <summary>
     ///     Gets the input report wait handle from the driver and duplicates it into the current process.
     /// </summary>
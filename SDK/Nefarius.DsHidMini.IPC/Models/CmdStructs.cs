@@ -146,3 +146,36 @@ internal struct DSHM_IPC_MSG_GET_HID_WAIT_HANDLE_RESPONSE
     /// <remarks>The requester of this handle must duplicate it into the current process before it becomes usable.</remarks>
     public IntPtr WaitHandle;
 }
+
+/// <summary>
+///     Requests the per-stage input latency histograms of a given device
+/// </summary>
+[SuppressMessage("ReSharper", "InconsistentNaming")]
+[StructLayout(LayoutKind.Sequential)]
+internal struct DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE
+{
+    public DSHM_IPC_MSG_HEADER Header;
+
+    /// <summary>
+    ///     QPC frequency to convert the raw bucket boundaries
+    /// </summary>
+    public UInt64 Frequency;
+
+    public DSHM_INPUT_LATENCY_STAGE IpcPublish;
+
+    public DSHM_INPUT_LATENCY_STAGE PostTransform;
+
+    public DSHM_INPUT_LATENCY_STAGE HidSubmit;
+}
+
+/// <summary>
+///     Requests the input report inter-arrival statistics of a given device
+/// </summary>
+[SuppressMessage("ReSharper", "InconsistentNaming")]
+[StructLayout(LayoutKind.Sequential)]
+internal struct DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE
+{
+    public DSHM_IPC_MSG_HEADER Header;
+
+    public InputIntervalStatistics Statistics;
+}
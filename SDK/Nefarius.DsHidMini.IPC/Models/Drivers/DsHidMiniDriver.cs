@@ -34,6 +34,13 @@ public static class DsHidMiniDriver
         Guid.Parse("{3FECF510-CC94-4FBE-8839-738201F84D59}"), 5,
         typeof(int));
 
+    /// <summary>
+    ///     The point in time the device has last been powered up by the driver.
+    /// </summary>
+    public static DevicePropertyKey LastConnectedTimeProperty => CustomDeviceProperty.CreateCustomDeviceProperty(
+        Guid.Parse("{3FECF510-CC94-4FBE-8839-738201F84D59}"), 6,
+        typeof(DateTimeOffset));
+
     #endregion
 
     #region Common device properties
@@ -163,5 +170,11 @@ public enum DsHidDeviceMode : byte
     ///     Xbox One Controller mode.
     /// </summary>
     [Description("XInput (Xbox One)")]
-    XInput = 0x05
+    XInput = 0x05,
+
+    /// <summary>
+    ///     Vendor defined device exposing the unmodified DS3 input report.
+    /// </summary>
+    [Description("Raw (passthrough)")]
+    Raw = 0x06
 }
\ No newline at end of file
@@ -104,5 +104,15 @@ internal enum DSHM_IPC_MSG_CMD_DEVICE : UInt32
     /// <summary>
     ///     Requests a wait handle for input report state changes
     /// </summary>
-    DSHM_IPC_MSG_CMD_DEVICE_GET_HID_WAIT_HANDLE
+    DSHM_IPC_MSG_CMD_DEVICE_GET_HID_WAIT_HANDLE,
+
+    /// <summary>
+    ///     Requests the per-stage input latency histograms
+    /// </summary>
+    DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_LATENCY,
+
+    /// <summary>
+    ///     Requests the input report inter-arrival statistics
+    /// </summary>
+    DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_INTERVAL
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace Nefarius.DsHidMini.IPC.Models;
 /// <summary>
 ///     Represents the most current raw DS3 HID input report.
 /// </summary>
-[StructLayout(LayoutKind.Sequential)]
+[StructLayout(LayoutKind.Sequential, Pack = 1)]
 [SuppressMessage("ReSharper", "InconsistentNaming")]
 internal struct IPC_HID_INPUT_REPORT_MESSAGE
 {
@@ -21,4 +21,27 @@ internal struct IPC_HID_INPUT_REPORT_MESSAGE
     ///     The <see cref="DS3_RAW_INPUT_REPORT" /> coming directly from the device with no transformations applied.
     /// </summary>
     public DS3_RAW_INPUT_REPORT InputReport;
+}
+
+/// <summary>
+///     Represents the calibrated motion values of the most current raw DS3 HID input report.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+[SuppressMessage("ReSharper", "InconsistentNaming")]
+internal struct IPC_HID_MOTION_MESSAGE
+{
+    /// <summary>
+    ///     The one-based device index these values belong to.
+    /// </summary>
+    public UInt32 SlotIndex;
+
+    /// <summary>
+    ///     Odd while the driver updates the input report and motion slots of this device.
+    /// </summary>
+    public Int32 Sequence;
+
+    /// <summary>
+    ///     The <see cref="DS3_MOTION_SAMPLE" /> calculated from <see cref="IPC_HID_INPUT_REPORT_MESSAGE.InputReport" />.
+    /// </summary>
+    public DS3_MOTION_SAMPLE Motion;
 }
\ No newline at end of file
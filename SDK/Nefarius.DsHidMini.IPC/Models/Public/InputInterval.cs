@@ -0,0 +1,66 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Nefarius.DsHidMini.IPC.Models.Public;
+
+/// <summary>
+///     Input report inter-arrival statistics of a device, useful to spot bursty or lossy (wireless) links.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct InputIntervalStatistics
+{
+    /// <summary>
+    ///     Number of histogram buckets.
+    /// </summary>
+    public const int BucketCount = 32;
+
+    /// <summary>
+    ///     Number of recorded intervals.
+    /// </summary>
+    public ulong Count;
+
+    /// <summary>
+    ///     Shortest interval in microseconds.
+    /// </summary>
+    public uint MinMicroseconds;
+
+    /// <summary>
+    ///     Longest interval in microseconds.
+    /// </summary>
+    public uint MaxMicroseconds;
+
+    /// <summary>
+    ///     Mean interval in microseconds.
+    /// </summary>
+    public uint MeanMicroseconds;
+
+    /// <summary>
+    ///     Interval variance in microseconds squared.
+    /// </summary>
+    public ulong Variance;
+
+    /// <summary>
+    ///     Intervals long enough (twice the expected one or more) to indicate lost reports.
+    /// </summary>
+    public ulong GapCount;
+
+    /// <summary>
+    ///     Estimated number of reports lost in all gaps.
+    /// </summary>
+    public ulong MissedReports;
+
+    /// <summary>
+    ///     Bucket N counts intervals of [N, N + 1) milliseconds, the last one also takes everything beyond.
+    /// </summary>
+    public fixed uint Buckets[BucketCount];
+
+    /// <summary>
+    ///     Standard deviation (jitter) in microseconds.
+    /// </summary>
+    public double StandardDeviationMicroseconds => Math.Sqrt(Variance);
+
+    public override string ToString()
+    {
+        return $"Intervals: {Count}, min/mean/max: {MinMicroseconds}/{MeanMicroseconds}/{MaxMicroseconds} us, " +
+               $"jitter: {StandardDeviationMicroseconds:F0} us, gaps: {GapCount}, missed: {MissedReports}";
+    }
+}
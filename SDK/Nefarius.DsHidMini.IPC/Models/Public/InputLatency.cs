@@ -0,0 +1,79 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Runtime.InteropServices;
+
+namespace Nefarius.DsHidMini.IPC.Models.Public;
+
+/// <summary>
+///     Latency histogram of a single input processing stage, measured from the interrupt IN completion.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+[SuppressMessage("ReSharper", "InconsistentNaming")]
+public unsafe struct DSHM_INPUT_LATENCY_STAGE
+{
+    /// <summary>
+    ///     Number of histogram buckets.
+    /// </summary>
+    public const int BucketCount = 32;
+
+    /// <summary>
+    ///     Number of recorded samples.
+    /// </summary>
+    public ulong Count;
+
+    /// <summary>
+    ///     Median in microseconds (upper bound of the bucket it falls into).
+    /// </summary>
+    public uint P50Microseconds;
+
+    /// <summary>
+    ///     99th percentile in microseconds (upper bound of the bucket it falls into).
+    /// </summary>
+    public uint P99Microseconds;
+
+    /// <summary>
+    ///     Longest sample in microseconds.
+    /// </summary>
+    public uint MaxMicroseconds;
+
+    /// <summary>
+    ///     Bucket 0 counts samples of 0 ticks, bucket N counts [2^(N-1), 2^N) QPC ticks, the last one also takes
+    ///     everything beyond.
+    /// </summary>
+    public fixed uint Buckets[BucketCount];
+
+    public override string ToString()
+    {
+        return $"Samples: {Count}, p50/p99/max: {P50Microseconds}/{P99Microseconds}/{MaxMicroseconds} us";
+    }
+}
+
+/// <summary>
+///     Per-stage input latency statistics of a device.
+/// </summary>
+public struct InputLatencyStatistics
+{
+    /// <summary>
+    ///     QPC frequency to convert the raw bucket boundaries into time.
+    /// </summary>
+    public ulong Frequency;
+
+    /// <summary>
+    ///     Time until the raw report got copied to the IPC shared memory region.
+    /// </summary>
+    public DSHM_INPUT_LATENCY_STAGE IpcPublish;
+
+    /// <summary>
+    ///     Time until the raw report got converted into the HID mode report.
+    /// </summary>
+    public DSHM_INPUT_LATENCY_STAGE PostTransform;
+
+    /// <summary>
+    ///     Time until the report got delivered to the HID stack.
+    /// </summary>
+    public DSHM_INPUT_LATENCY_STAGE HidSubmit;
+
+    public override string ToString()
+    {
+        return $"IPC publish: [{IpcPublish}], post transform: [{PostTransform}], HID submit: [{HidSubmit}]";
+    }
+}
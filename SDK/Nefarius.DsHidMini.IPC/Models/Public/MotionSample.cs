@@ -0,0 +1,54 @@
+﻿using System.Diagnostics.CodeAnalysis;
+using System.Runtime.InteropServices;
+
+namespace Nefarius.DsHidMini.IPC.Models.Public;
+
+/// <summary>
+///     Calibrated motion sensor values and orientation estimate computed by the driver.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 1)]
+[SuppressMessage("ReSharper", "InconsistentNaming")]
+public struct DS3_MOTION_SAMPLE
+{
+    /// <summary>
+    ///     Accelerometer X axis in 1/8192 g.
+    /// </summary>
+    public short AccelerometerX;
+
+    /// <summary>
+    ///     Accelerometer Y axis in 1/8192 g.
+    /// </summary>
+    public short AccelerometerY;
+
+    /// <summary>
+    ///     Accelerometer Z axis in 1/8192 g.
+    /// </summary>
+    public short AccelerometerZ;
+
+    /// <summary>
+    ///     Yaw rate in 1/16 degrees per second with the estimated bias removed.
+    /// </summary>
+    public short Gyroscope;
+
+    /// <summary>
+    ///     Pitch estimate in 1/100 degrees, valid if <see cref="IsTiltValid" /> is set.
+    /// </summary>
+    public short Pitch;
+
+    /// <summary>
+    ///     Roll estimate in 1/100 degrees, valid if <see cref="IsTiltValid" /> is set.
+    /// </summary>
+    public short Roll;
+
+    internal byte Flags;
+
+    /// <summary>
+    ///     True once the gyroscope bias has been estimated while the controller was resting.
+    /// </summary>
+    public bool IsCalibrated => (Flags & 0x01) != 0;
+
+    /// <summary>
+    ///     True if <see cref="Pitch" /> and <see cref="Roll" /> carry an estimate.
+    /// </summary>
+    public bool IsTiltValid => (Flags & 0x02) != 0;
+}
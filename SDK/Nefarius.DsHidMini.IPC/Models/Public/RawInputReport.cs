@@ -117,7 +117,7 @@ public unsafe struct DS3_RAW_INPUT_REPORT
         ///     Gets or sets the PS button state.
         /// </summary>
         [SuppressMessage("ReSharper", "InconsistentNaming")]
-        public bool PS { get => GetBit(packedButtons, 16); set => SetBit(ref packedButtons, 16, value); }
+        public bool PS { get => GetBit(lButtons, 16); set => SetBit(ref lButtons, 16, value); }
 
         // Helper methods to manipulate individual bits
         private static bool GetBit(ushort value, int bitNumber)
@@ -136,6 +136,26 @@ public unsafe struct DS3_RAW_INPUT_REPORT
                 value &= (ushort)~(1 << bitNumber);
             }
         }
+
+        //
+        // PS sits in the third button byte, out of reach of the packed 16 bits
+        //
+        private static bool GetBit(uint value, int bitNumber)
+        {
+            return (value & (1u << bitNumber)) != 0;
+        }
+
+        private static void SetBit(ref uint value, int bitNumber, bool bitValue)
+        {
+            if (bitValue)
+            {
+                value |= 1u << bitNumber;
+            }
+            else
+            {
+                value &= ~(1u << bitNumber);
+            }
+        }
     }
 
     /// <summary>
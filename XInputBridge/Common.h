@@ -12,6 +12,7 @@
 // 
 #include <DsHidMini/ScpTypes.h>
 #include <DsHidMini/Ds3Types.h>
+#include <DsHidMini/Ds3Shared.h>
 #include <DsHidMini/dshmguid.h>
 
 //
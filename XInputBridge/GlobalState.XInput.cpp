@@ -181,39 +181,7 @@ DWORD GlobalState::ProxyXInputGetState(_In_ DWORD dwUserIndex, _Out_ XINPUT_STAT
 		//
 		// D-Pad translation
 		// 
-		switch (pReport->Buttons.bButtons[0] & ~0xF)
-		{
-		case 0x10: // N
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
-			break;
-		case 0x30: // NE
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
-			break;
-		case 0x20: // E
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
-			break;
-		case 0x60: // SE
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
-			break;
-		case 0x40: // S
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
-			break;
-		case 0xC0: // SW
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
-			break;
-		case 0x80: // W
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
-			break;
-		case 0x90: // NW
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
-			break;
-		default: // Released
-			break;
-		}
+		pState->Gamepad.wButtons |= G_DS3_DPAD_TO_XINPUT_BUTTONS[DS3_RAW_DPAD_NIBBLE(pReport)];
 
 		//
 		// Start/Select
@@ -551,39 +519,7 @@ DWORD GlobalState::ProxyXInputGetStateEx(_In_ DWORD dwUserIndex, _Out_ XINPUT_ST
 		//
 		// D-Pad translation
 		// 
-		switch (pReport->Buttons.bButtons[0] & ~0xF)
-		{
-		case 0x10: // N
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
-			break;
-		case 0x30: // NE
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
-			break;
-		case 0x20: // E
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
-			break;
-		case 0x60: // SE
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
-			break;
-		case 0x40: // S
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
-			break;
-		case 0xC0: // SW
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
-			break;
-		case 0x80: // W
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
-			break;
-		case 0x90: // NW
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
-			pState->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
-			break;
-		default: // Released
-			break;
-		}
+		pState->Gamepad.wButtons |= G_DS3_DPAD_TO_XINPUT_BUTTONS[DS3_RAW_DPAD_NIBBLE(pReport)];
 
 		//
 		// Start/Select
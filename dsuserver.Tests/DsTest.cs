@@ -0,0 +1,80 @@
+﻿using System.Diagnostics;
+using System.Runtime.CompilerServices;
+
+namespace Nefarius.DsHidMini.DsuServer.Tests;
+
+/// <summary>
+///     Tiny assertion and timing helpers, same conventions as the native test harness under tests/.
+/// </summary>
+internal static class DsTest
+{
+    private static int _failures;
+
+    public static int Result => _failures == 0 ? 0 : 1;
+
+    public static void Assert(bool condition, [CallerArgumentExpression(nameof(condition))] string expression = "",
+        [CallerFilePath] string file = "", [CallerLineNumber] int line = 0)
+    {
+        if (!condition)
+        {
+            Console.Error.WriteLine($"{Path.GetFileName(file)}:{line}: assertion failed: {expression}");
+            _failures++;
+        }
+    }
+
+    public static void AssertEqual<T>(T actual, T expected,
+        [CallerArgumentExpression(nameof(actual))] string expression = "",
+        [CallerFilePath] string file = "", [CallerLineNumber] int line = 0)
+    {
+        if (!EqualityComparer<T>.Default.Equals(actual, expected))
+        {
+            Console.Error.WriteLine($"{Path.GetFileName(file)}:{line}: {expression} == {actual}, expected {expected}");
+            _failures++;
+        }
+    }
+
+    public static void Run(Action test, [CallerArgumentExpression(nameof(test))] string name = "")
+    {
+        int before = _failures;
+
+        try
+        {
+            test();
+        }
+        catch (Exception ex)
+        {
+            Console.Error.WriteLine($"{name}: {ex}");
+            _failures++;
+        }
+
+        Console.WriteLine($"{(_failures == before ? "PASS" : "FAIL")} {name}");
+    }
+
+    /// <summary>
+    ///     Converts a <see cref="Stopwatch" /> tick delta to microseconds.
+    /// </summary>
+    public static double TicksToMicroseconds(long ticks)
+    {
+        return ticks * 1_000_000.0 / Stopwatch.Frequency;
+    }
+
+    /// <summary>
+    ///     Bitwise CRC-32 (IEEE 802.3), independent of the table driven implementation the server uses.
+    /// </summary>
+    public static uint ReferenceCrc32(ReadOnlySpan<byte> data)
+    {
+        uint crc = 0xFFFFFFFF;
+
+        foreach (byte value in data)
+        {
+            crc ^= value;
+
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+            }
+        }
+
+        return ~crc;
+    }
+}
@@ -0,0 +1,257 @@
+﻿using System.Buffers.Binary;
+using System.Diagnostics;
+using System.Net;
+using System.Net.Sockets;
+
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer.Tests;
+
+/// <summary>
+///     Runs the server on loopback with a UDP client subscribed to it.
+/// </summary>
+internal static class DsuLoopbackTests
+{
+    private const int ReportCount = 500;
+
+    private const int BenchmarkWarmup = 1000;
+
+    private const int BenchmarkIterations = 10000;
+
+    private static Socket CreateClient()
+    {
+        Socket client = new(AddressFamily.InterNetwork, SocketType.Dgram, ProtocolType.Udp);
+
+        client.Bind(new IPEndPoint(IPAddress.Loopback, 0));
+        client.ReceiveTimeout = 1000;
+
+        return client;
+    }
+
+    /// <summary>
+    ///     Receives the next packet of the given type, skipping others.
+    /// </summary>
+    /// <returns>The packet length or -1 if nothing arrived in time.</returns>
+    private static int Receive(Socket client, byte[] buffer, uint messageType)
+    {
+        while (true)
+        {
+            int length;
+
+            try
+            {
+                length = client.Receive(buffer);
+            }
+            catch (SocketException ex) when (ex.SocketErrorCode == SocketError.TimedOut)
+            {
+                return -1;
+            }
+
+            if (length >= 20 && BinaryPrimitives.ReadUInt32LittleEndian(buffer.AsSpan(16)) == messageType)
+            {
+                return length;
+            }
+        }
+    }
+
+    /// <summary>
+    ///     Requests the port info of a slot.
+    /// </summary>
+    /// <returns>The reported slot state.</returns>
+    private static byte QuerySlot(Socket client, EndPoint server, byte slot, byte[] buffer)
+    {
+        client.SendTo(DsuProtocolTests.ClientPacket(DsuProtocol.MessageTypePortInfo, [1, 0, 0, 0, slot]), server);
+
+        int length = Receive(client, buffer, DsuProtocol.MessageTypePortInfo);
+
+        DsTest.AssertEqual(length, DsuProtocol.PortInfoLength);
+
+        if (length < 0)
+        {
+            return byte.MaxValue;
+        }
+
+        DsTest.Assert(DsuProtocolTests.IsCrcValid(buffer.AsSpan(0, length)));
+        DsTest.AssertEqual(buffer[20], slot);
+
+        return buffer[21];
+    }
+
+    /// <summary>
+    ///     Sends a pad data request, the port info round trip after it guarantees the server processed the
+    ///     subscription since requests are handled in order.
+    /// </summary>
+    private static void Subscribe(Socket client, EndPoint server, byte flags, byte slot, byte[] buffer)
+    {
+        client.SendTo(DsuProtocolTests.ClientPacket(DsuProtocol.MessageTypePadData, [flags, slot, 0, 0, 0, 0, 0, 0]),
+            server);
+
+        QuerySlot(client, server, slot, buffer);
+    }
+
+    private static string Percentiles(List<double> values)
+    {
+        values.Sort();
+
+        return values.Count == 0
+            ? "n/a"
+            : $"median {values[values.Count / 2]:F1} us, p99 {values[values.Count * 99 / 100]:F1} us, max {values[^1]:F1} us";
+    }
+
+    /// <summary>
+    ///     Simulated shared memory producer -> slot reader -> server -> UDP client, checks every packet that arrives and
+    ///     the slot state following the device.
+    /// </summary>
+    public static void SimulatedProducerLoopback()
+    {
+        SimulatedReportSource source = new(1, ReportCount);
+        DsuServer server = new(new IPEndPoint(IPAddress.Loopback, 0), () => source);
+        DsuSlotReader reader = new(server, 0);
+        using Socket client = CreateClient();
+        byte[] buffer = new byte[1024];
+
+        client.SendTo(DsuProtocolTests.ClientPacket(DsuProtocol.MessageTypeVersion, []), server.LocalEndPoint);
+
+        int length = Receive(client, buffer, DsuProtocol.MessageTypeVersion);
+
+        DsTest.AssertEqual(length, DsuProtocol.VersionLength);
+        DsTest.Assert(length > 0 && DsuProtocolTests.IsCrcValid(buffer.AsSpan(0, length)));
+
+        Subscribe(client, server.LocalEndPoint, 0x01, 0, buffer);
+
+        Thread producer = new(() =>
+        {
+            for (short number = 1; number <= ReportCount; number++)
+            {
+                source.Produce(number);
+                Thread.Sleep(1);
+            }
+        });
+
+        producer.Start();
+
+        List<double> latencies = [];
+        uint expectedPacketNumber = 0;
+        int lastNumber = 0;
+        int repeated = 0;
+
+        while (lastNumber < ReportCount && (length = Receive(client, buffer, DsuProtocol.MessageTypePadData)) > 0)
+        {
+            long receivedAt = Stopwatch.GetTimestamp();
+            Span<byte> packet = buffer.AsSpan(0, length);
+
+            DsTest.AssertEqual(length, DsuProtocol.PadDataLength);
+            DsTest.Assert(DsuProtocolTests.IsCrcValid(packet));
+            DsTest.AssertEqual(packet[20], (byte)0);
+            DsTest.AssertEqual(packet[21], (byte)2);
+            DsTest.AssertEqual(packet[30], (byte)0x05);
+
+            DsTest.AssertEqual(BinaryPrimitives.ReadUInt32LittleEndian(packet[32..]), expectedPacketNumber++);
+
+            int number = (int)MathF.Round(-BinaryPrimitives.ReadSingleLittleEndian(packet[92..]) * 16.0f);
+
+            //
+            // Reports may get coalesced, never reordered. A reader waking up for a report it already copied
+            // along with the previous signal publishes it once more, same as against the driver.
+            //
+            DsTest.Assert(number >= lastNumber && number <= ReportCount);
+            DsTest.AssertEqual(packet[40], (byte)number);
+
+            if (number < lastNumber || number > ReportCount)
+            {
+                break;
+            }
+
+            if (number == lastNumber)
+            {
+                repeated++;
+                continue;
+            }
+
+            latencies.Add(DsTest.TicksToMicroseconds(receivedAt - source.ProducedAt[number]));
+            lastNumber = number;
+        }
+
+        producer.Join();
+
+        Console.WriteLine(
+            $"loopback: received {latencies.Count}/{ReportCount} reports ({repeated} repeated), produce-to-receive {Percentiles(latencies)}");
+
+        //
+        // The latest state always makes it out, whatever got coalesced on the way
+        //
+        DsTest.AssertEqual(lastNumber, ReportCount);
+        DsTest.Assert(latencies.Count >= ReportCount / 10);
+
+        DsTest.AssertEqual(QuerySlot(client, server.LocalEndPoint, 0, buffer), (byte)2);
+
+        source.Disconnect();
+
+        byte state = 2;
+
+        for (int attempt = 0; attempt < 100 && state != 0; attempt++)
+        {
+            Thread.Sleep(10);
+            state = QuerySlot(client, server.LocalEndPoint, 0, buffer);
+        }
+
+        DsTest.AssertEqual(state, (byte)0);
+
+        reader.Dispose();
+        server.Dispose();
+    }
+
+    /// <summary>
+    ///     Time spent in <see cref="DsuServer.Publish" /> (encode and send) and until the client received the packet.
+    /// </summary>
+    public static void BenchmarkPublishLatency()
+    {
+        using DsuServer server = new(new IPEndPoint(IPAddress.Loopback, 0),
+            () => throw new InvalidOperationException("not used"));
+        using Socket client = CreateClient();
+        byte[] buffer = new byte[1024];
+        DS3_RAW_INPUT_REPORT report = new() { ReportId = 0x01, BatteryStatus = 0x05 };
+        DS3_MOTION_SAMPLE motion = new() { AccelerometerZ = 8192 };
+        List<double> send = new(BenchmarkIterations);
+        List<double> receive = new(BenchmarkIterations);
+
+        //
+        // No flags subscribes to all slots
+        //
+        Subscribe(client, server.LocalEndPoint, 0x00, 0, buffer);
+
+        for (int i = 0; i < BenchmarkWarmup + BenchmarkIterations; i++)
+        {
+            report.LeftThumbX = (byte)i;
+
+            long start = Stopwatch.GetTimestamp();
+
+            server.Publish(0, report, motion, DsuServer.TimestampMicroseconds());
+
+            long sent = Stopwatch.GetTimestamp();
+            int length = Receive(client, buffer, DsuProtocol.MessageTypePadData);
+            long received = Stopwatch.GetTimestamp();
+
+            DsTest.AssertEqual(length, DsuProtocol.PadDataLength);
+
+            if (length < 0)
+            {
+                break;
+            }
+
+            if (i >= BenchmarkWarmup)
+            {
+                send.Add(DsTest.TicksToMicroseconds(sent - start));
+                receive.Add(DsTest.TicksToMicroseconds(received - start));
+            }
+        }
+
+        Console.WriteLine($"publish-to-send: {Percentiles(send)}");
+        Console.WriteLine($"publish-to-receive: {Percentiles(receive)}");
+
+        //
+        // Loose bound, a single loopback datagram takes tens of microseconds
+        //
+        DsTest.Assert(receive.Count == BenchmarkIterations && receive[receive.Count / 2] < 1000.0);
+    }
+}
@@ -0,0 +1,249 @@
+﻿using System.Buffers.Binary;
+
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer.Tests;
+
+/// <summary>
+///     Packet layout and CRC of the encoded replies and validation of client requests.
+/// </summary>
+/// <remarks>
+///     Offsets are absolute packet offsets taken from https://v1993.github.io/cemuhook-protocol/ rather than derived from
+///     the encoder, so a shifted field shows up as a failure.
+/// </remarks>
+internal static class DsuProtocolTests
+{
+    private const uint ServerId = 0x11223344;
+
+    /// <summary>
+    ///     Builds a client request the way cemuhook clients do.
+    /// </summary>
+    public static byte[] ClientPacket(uint messageType, ReadOnlySpan<byte> payload, ushort version = DsuProtocol.ProtocolVersion)
+    {
+        byte[] packet = new byte[DsuProtocol.HeaderLength + sizeof(uint) + payload.Length];
+
+        "DSUC"u8.CopyTo(packet);
+        BinaryPrimitives.WriteUInt16LittleEndian(packet.AsSpan(4), version);
+        BinaryPrimitives.WriteUInt16LittleEndian(packet.AsSpan(6), (ushort)(packet.Length - DsuProtocol.HeaderLength));
+        BinaryPrimitives.WriteUInt32LittleEndian(packet.AsSpan(12), 0xC0FFEE);
+        BinaryPrimitives.WriteUInt32LittleEndian(packet.AsSpan(16), messageType);
+        payload.CopyTo(packet.AsSpan(20));
+        BinaryPrimitives.WriteUInt32LittleEndian(packet.AsSpan(8), DsTest.ReferenceCrc32(packet));
+
+        return packet;
+    }
+
+    /// <summary>
+    ///     Checks the CRC of a server packet, the field is calculated with itself zeroed out.
+    /// </summary>
+    public static bool IsCrcValid(ReadOnlySpan<byte> packet)
+    {
+        byte[] copy = packet.ToArray();
+        uint crc = BinaryPrimitives.ReadUInt32LittleEndian(copy.AsSpan(8));
+
+        BinaryPrimitives.WriteUInt32LittleEndian(copy.AsSpan(8), 0);
+
+        return DsTest.ReferenceCrc32(copy) == crc;
+    }
+
+    private static void AssertServerHeader(ReadOnlySpan<byte> packet, uint messageType)
+    {
+        DsTest.Assert(packet[..4].SequenceEqual("DSUS"u8));
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt16LittleEndian(packet[4..]), DsuProtocol.ProtocolVersion);
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt16LittleEndian(packet[6..]), (ushort)(packet.Length - 16));
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt32LittleEndian(packet[12..]), ServerId);
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt32LittleEndian(packet[16..]), messageType);
+        DsTest.Assert(IsCrcValid(packet));
+    }
+
+    public static void ReferenceCrc32()
+    {
+        //
+        // Standard check value, guards the reference the other tests rely on
+        //
+        DsTest.AssertEqual(DsTest.ReferenceCrc32("123456789"u8), 0xCBF43926u);
+    }
+
+    public static void PadDataLayout()
+    {
+        DS3_RAW_INPUT_REPORT report = new() { LeftThumbX = 0x10, LeftThumbY = 0x20, RightThumbX = 0x30, RightThumbY = 0xF0 };
+        DS3_MOTION_SAMPLE motion = new() { AccelerometerX = 8192, AccelerometerY = -4096, AccelerometerZ = 2048, Gyroscope = 160 };
+
+        report.BatteryStatus = 0x04;
+        report.Buttons.Left = true;
+        report.Buttons.Start = true;
+        report.Buttons.L3 = true;
+        report.Buttons.Triangle = true;
+        report.Buttons.Square = true;
+        report.Buttons.L2 = true;
+        report.Buttons.PS = true;
+        report.Pressure.Values.Left = 0xA1;
+        report.Pressure.Values.Down = 0xA2;
+        report.Pressure.Values.Right = 0xA3;
+        report.Pressure.Values.Up = 0xA4;
+        report.Pressure.Values.Triangle = 0xA5;
+        report.Pressure.Values.Circle = 0xA6;
+        report.Pressure.Values.Cross = 0xA7;
+        report.Pressure.Values.Square = 0xA8;
+        report.Pressure.Values.R1 = 0xA9;
+        report.Pressure.Values.L1 = 0xAA;
+        report.Pressure.Values.R2 = 0xAB;
+        report.Pressure.Values.L2 = 0xAC;
+
+        byte[] packet = new byte[DsuProtocol.PadDataLength];
+
+        packet.AsSpan().Fill(0xCC);
+
+        DsuProtocol.WritePadData(packet, ServerId, new DsuSlotState(2, true, report.BatteryStatus), 0x01020304, report,
+            motion, 0x1122334455667788);
+
+        AssertServerHeader(packet, DsuProtocol.MessageTypePadData);
+        DsTest.AssertEqual(packet.Length, 100);
+
+        //
+        // Shared controller header
+        //
+        DsTest.AssertEqual(packet[20], (byte)2); // slot
+        DsTest.AssertEqual(packet[21], (byte)2); // connected
+        DsTest.AssertEqual(packet[22], (byte)2); // full gyro
+        DsTest.AssertEqual(packet[23], (byte)0); // connection type
+        DsTest.Assert(packet.AsSpan(24, 6).SequenceEqual(new byte[] { 0, 0, 0, 0, 0, 3 }));
+        DsTest.AssertEqual(packet[30], (byte)0x04); // battery
+
+        //
+        // Controller data
+        //
+        DsTest.AssertEqual(packet[31], (byte)1); // is active
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt32LittleEndian(packet.AsSpan(32)), 0x01020304u);
+        DsTest.AssertEqual(packet[36], (byte)(0x80 | 0x08 | 0x02)); // D-Pad Left, Options, L3
+        DsTest.AssertEqual(packet[37], (byte)(0x80 | 0x10 | 0x01)); // Triangle, Square, L2
+        DsTest.AssertEqual(packet[38], (byte)1); // Home
+        DsTest.AssertEqual(packet[39], (byte)0); // Touch
+        DsTest.AssertEqual(packet[40], (byte)0x10);
+        DsTest.AssertEqual(packet[41], (byte)(0xFF - 0x20));
+        DsTest.AssertEqual(packet[42], (byte)0x30);
+        DsTest.AssertEqual(packet[43], (byte)(0xFF - 0xF0));
+
+        for (int i = 0; i < 12; i++)
+        {
+            DsTest.AssertEqual(packet[44 + i], (byte)(0xA1 + i));
+        }
+
+        DsTest.Assert(packet.AsSpan(56, 12).IndexOfAnyExcept((byte)0) < 0); // touch points
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt64LittleEndian(packet.AsSpan(68)), 0x1122334455667788ul);
+
+        //
+        // Accelerometer in g, gyroscope in deg/s
+        //
+        DsTest.AssertEqual(BinaryPrimitives.ReadSingleLittleEndian(packet.AsSpan(76)), -1.0f);
+        DsTest.AssertEqual(BinaryPrimitives.ReadSingleLittleEndian(packet.AsSpan(80)), 0.25f);
+        DsTest.AssertEqual(BinaryPrimitives.ReadSingleLittleEndian(packet.AsSpan(84)), 0.5f);
+        DsTest.AssertEqual(BinaryPrimitives.ReadSingleLittleEndian(packet.AsSpan(88)), 0.0f);
+        DsTest.AssertEqual(BinaryPrimitives.ReadSingleLittleEndian(packet.AsSpan(92)), -10.0f);
+        DsTest.AssertEqual(BinaryPrimitives.ReadSingleLittleEndian(packet.AsSpan(96)), 0.0f);
+    }
+
+    public static void PadDataCrc()
+    {
+        DS3_RAW_INPUT_REPORT report = new() { LeftThumbX = 0x80, LeftThumbY = 0x80 };
+        DS3_MOTION_SAMPLE motion = new() { AccelerometerZ = 8192 };
+        byte[] packet = new byte[DsuProtocol.PadDataLength];
+
+        for (uint packetNumber = 0; packetNumber < 256; packetNumber++)
+        {
+            report.RightThumbX = (byte)packetNumber;
+
+            DsuProtocol.WritePadData(packet, ServerId, new DsuSlotState(0, true, 0x05), packetNumber, report, motion,
+                packetNumber * 1000);
+
+            DsTest.Assert(IsCrcValid(packet));
+        }
+
+        //
+        // Any single corrupted byte is detected
+        //
+        for (int offset = 0; offset < packet.Length; offset++)
+        {
+            packet[offset] ^= 0x01;
+            DsTest.Assert(!IsCrcValid(packet));
+            packet[offset] ^= 0x01;
+        }
+    }
+
+    public static void PadDataDisconnected()
+    {
+        DS3_RAW_INPUT_REPORT report = new() { BatteryStatus = 0x05 };
+        DS3_MOTION_SAMPLE motion = new();
+        byte[] packet = new byte[DsuProtocol.PadDataLength];
+
+        DsuProtocol.WritePadData(packet, ServerId, new DsuSlotState(1, false, 0x05), 7, report, motion, 0);
+
+        AssertServerHeader(packet, DsuProtocol.MessageTypePadData);
+        DsTest.AssertEqual(packet[20], (byte)1);
+        DsTest.AssertEqual(packet[21], (byte)0);
+        DsTest.AssertEqual(packet[22], (byte)0);
+        DsTest.Assert(packet.AsSpan(24, 6).IndexOfAnyExcept((byte)0) < 0);
+        DsTest.AssertEqual(packet[30], (byte)0);
+        DsTest.AssertEqual(packet[31], (byte)0);
+    }
+
+    public static void VersionAndPortInfoLayout()
+    {
+        byte[] version = new byte[64];
+
+        DsuProtocol.WriteVersion(version, ServerId);
+
+        AssertServerHeader(version.AsSpan(0, DsuProtocol.VersionLength), DsuProtocol.MessageTypeVersion);
+        DsTest.AssertEqual(BinaryPrimitives.ReadUInt16LittleEndian(version.AsSpan(20)), DsuProtocol.ProtocolVersion);
+
+        //
+        // Nothing written past the packet
+        //
+        DsTest.Assert(version.AsSpan(DsuProtocol.VersionLength).IndexOfAnyExcept((byte)0) < 0);
+
+        byte[] portInfo = new byte[DsuProtocol.PortInfoLength];
+
+        DsuProtocol.WritePortInfo(portInfo, ServerId, new DsuSlotState(3, true, 0xEE));
+
+        AssertServerHeader(portInfo, DsuProtocol.MessageTypePortInfo);
+        DsTest.AssertEqual(portInfo[20], (byte)3);
+        DsTest.AssertEqual(portInfo[21], (byte)2);
+        DsTest.AssertEqual(portInfo[22], (byte)2);
+        DsTest.Assert(portInfo.AsSpan(24, 6).SequenceEqual(new byte[] { 0, 0, 0, 0, 0, 4 }));
+        DsTest.AssertEqual(portInfo[30], (byte)0xEE);
+        DsTest.AssertEqual(portInfo[31], (byte)0);
+    }
+
+    public static void ClientPacketValidation()
+    {
+        byte[] payload = [0x01, 0x02, 0, 0, 0, 0, 0, 0];
+        byte[] packet = ClientPacket(DsuProtocol.MessageTypePadData, payload);
+
+        DsTest.Assert(DsuProtocol.TryParseClientPacket(packet.ToArray(), out uint messageType,
+            out ReadOnlySpan<byte> parsed));
+        DsTest.AssertEqual(messageType, DsuProtocol.MessageTypePadData);
+        DsTest.Assert(parsed.SequenceEqual(payload));
+
+        //
+        // Trailing bytes past the announced length are not part of the CRC nor the payload
+        //
+        byte[] padded = [.. packet, 0xFF, 0xFF];
+
+        DsTest.Assert(DsuProtocol.TryParseClientPacket(padded, out _, out parsed));
+        DsTest.AssertEqual(parsed.Length, payload.Length);
+
+        byte[] corrupted = packet.ToArray();
+        corrupted[20] ^= 0x01;
+        DsTest.Assert(!DsuProtocol.TryParseClientPacket(corrupted, out _, out _));
+
+        byte[] serverMagic = packet.ToArray();
+        "DSUS"u8.CopyTo(serverMagic);
+        DsTest.Assert(!DsuProtocol.TryParseClientPacket(serverMagic, out _, out _));
+
+        DsTest.Assert(!DsuProtocol.TryParseClientPacket(
+            ClientPacket(DsuProtocol.MessageTypeVersion, [], DsuProtocol.ProtocolVersion + 1), out _, out _));
+
+        DsTest.Assert(!DsuProtocol.TryParseClientPacket(packet.AsSpan(0, packet.Length - 1).ToArray(), out _, out _));
+        DsTest.Assert(!DsuProtocol.TryParseClientPacket(packet.AsSpan(0, 16).ToArray(), out _, out _));
+    }
+}
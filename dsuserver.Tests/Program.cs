@@ -0,0 +1,18 @@
+﻿// Tests and benchmarks of the DSU server which don't need a driver instance
+//
+// Usage: dsuserver.Tests
+//   Runs the packet encoding tests, the loopback test against a simulated IPC producer and the
+//   publish-to-receive latency benchmark, exits with 1 if any of them failed
+
+using Nefarius.DsHidMini.DsuServer.Tests;
+
+DsTest.Run(DsuProtocolTests.ReferenceCrc32);
+DsTest.Run(DsuProtocolTests.PadDataLayout);
+DsTest.Run(DsuProtocolTests.PadDataCrc);
+DsTest.Run(DsuProtocolTests.PadDataDisconnected);
+DsTest.Run(DsuProtocolTests.VersionAndPortInfoLayout);
+DsTest.Run(DsuProtocolTests.ClientPacketValidation);
+DsTest.Run(DsuLoopbackTests.SimulatedProducerLoopback);
+DsTest.Run(DsuLoopbackTests.BenchmarkPublishLatency);
+
+return DsTest.Result;
@@ -0,0 +1,104 @@
+﻿using System.Diagnostics;
+
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer.Tests;
+
+/// <summary>
+///     Stands in for the driver side of the IPC input report shared memory of one device.
+/// </summary>
+/// <remarks>
+///     Mirrors what the driver does per input report: bump the sequence to odd, update report and motion, bump it back
+///     to even and signal the auto-reset input report event. Readers retry until they saw the same even sequence before
+///     and after copying, like <c>DsHidMiniInterop.GetRawInputReport</c>. Each report carries its number in the yaw rate
+///     so the receiving end can tell which one it got.
+/// </remarks>
+internal sealed class SimulatedReportSource : IDsuReportSource
+{
+    private readonly AutoResetEvent _inputReportEvent = new(false);
+
+    private readonly int _deviceIndex;
+
+    private DS3_RAW_INPUT_REPORT _report;
+
+    private DS3_MOTION_SAMPLE _motion;
+
+    private int _sequence;
+
+    private volatile bool _isOccupied = true;
+
+    public SimulatedReportSource(int deviceIndex, int capacity)
+    {
+        _deviceIndex = deviceIndex;
+        ProducedAt = new long[capacity + 1];
+    }
+
+    /// <summary>
+    ///     <see cref="Stopwatch" /> timestamp each report number got written at.
+    /// </summary>
+    public long[] ProducedAt { get; }
+
+    public void Dispose()
+    {
+        _inputReportEvent.Dispose();
+    }
+
+    public bool GetRawInputReport(int deviceIndex, ref DS3_RAW_INPUT_REPORT report, ref DS3_MOTION_SAMPLE motion,
+        out bool isUpdated, TimeSpan timeout)
+    {
+        isUpdated = _inputReportEvent.WaitOne(timeout);
+
+        if (deviceIndex != _deviceIndex || !_isOccupied)
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            int sequence = Volatile.Read(ref _sequence);
+
+            if ((sequence & 1) != 0)
+            {
+                Thread.SpinWait(1);
+                continue;
+            }
+
+            report = _report;
+            motion = _motion;
+
+            if (Volatile.Read(ref _sequence) == sequence)
+            {
+                return true;
+            }
+        }
+    }
+
+    /// <summary>
+    ///     Writes report number <paramref name="number" /> and signals readers.
+    /// </summary>
+    public void Produce(short number)
+    {
+        ProducedAt[number] = Stopwatch.GetTimestamp();
+
+        Interlocked.Increment(ref _sequence);
+
+        _report.ReportId = 0x01;
+        _report.LeftThumbX = (byte)number;
+        _report.BatteryStatus = 0x05;
+        _motion.AccelerometerZ = 8192;
+        _motion.Gyroscope = number;
+
+        Interlocked.Increment(ref _sequence);
+
+        _inputReportEvent.Set();
+    }
+
+    /// <summary>
+    ///     Emulates the device getting removed, readers see the slot as unoccupied.
+    /// </summary>
+    public void Disconnect()
+    {
+        _isOccupied = false;
+        _inputReportEvent.Set();
+    }
+}
@@ -0,0 +1,26 @@
+﻿using Nefarius.DsHidMini.IPC;
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer;
+
+/// <summary>
+///     Reads the input reports from the driver IPC shared memory.
+/// </summary>
+/// <exception cref="Nefarius.DsHidMini.IPC.Exceptions.DsHidMiniInteropUnavailableException">
+///     No driver instance is available (yet).
+/// </exception>
+internal sealed class DsHidMiniReportSource : IDsuReportSource
+{
+    private readonly DsHidMiniInterop _interop = new();
+
+    public void Dispose()
+    {
+        _interop.Dispose();
+    }
+
+    public bool GetRawInputReport(int deviceIndex, ref DS3_RAW_INPUT_REPORT report, ref DS3_MOTION_SAMPLE motion,
+        out bool isUpdated, TimeSpan timeout)
+    {
+        return _interop.GetRawInputReport(deviceIndex, ref report, ref motion, out isUpdated, timeout);
+    }
+}
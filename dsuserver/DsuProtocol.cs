@@ -0,0 +1,231 @@
+﻿using System.Buffers.Binary;
+using System.IO.Hashing;
+
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer;
+
+/// <summary>
+///     Packet layout and encoding of the cemuhook/DSU protocol.
+/// </summary>
+/// <remarks>https://v1993.github.io/cemuhook-protocol/</remarks>
+internal static class DsuProtocol
+{
+    public const int DefaultPort = 26760;
+
+    public const ushort ProtocolVersion = 1001;
+
+    public const int MaxSlots = 4;
+
+    public const int HeaderLength = 16;
+
+    public const uint MessageTypeVersion = 0x100000;
+    public const uint MessageTypePortInfo = 0x100001;
+    public const uint MessageTypePadData = 0x100002;
+
+    /// <summary>
+    ///     Size of a complete controller data packet.
+    /// </summary>
+    public const int PadDataLength = 100;
+
+    /// <summary>
+    ///     Size of a complete port info packet.
+    /// </summary>
+    public const int PortInfoLength = 32;
+
+    /// <summary>
+    ///     Size of a complete version packet.
+    /// </summary>
+    public const int VersionLength = 22;
+
+    private static ReadOnlySpan<byte> ServerMagic => "DSUS"u8;
+
+    private static ReadOnlySpan<byte> ClientMagic => "DSUC"u8;
+
+    /// <summary>
+    ///     Validates an incoming client packet and extracts its message type.
+    /// </summary>
+    /// <returns>TRUE if magic, version, length and CRC check out.</returns>
+    public static bool TryParseClientPacket(Span<byte> packet, out uint messageType, out ReadOnlySpan<byte> payload)
+    {
+        messageType = 0;
+        payload = default;
+
+        if (packet.Length < HeaderLength + sizeof(uint) || !packet[..4].SequenceEqual(ClientMagic))
+        {
+            return false;
+        }
+
+        if (BinaryPrimitives.ReadUInt16LittleEndian(packet[4..]) > ProtocolVersion)
+        {
+            return false;
+        }
+
+        int length = BinaryPrimitives.ReadUInt16LittleEndian(packet[6..]);
+
+        if (HeaderLength + length > packet.Length || length < sizeof(uint))
+        {
+            return false;
+        }
+
+        packet = packet[..(HeaderLength + length)];
+
+        uint crc = BinaryPrimitives.ReadUInt32LittleEndian(packet[8..]);
+
+        //
+        // CRC is calculated with the field itself zeroed out
+        //
+        BinaryPrimitives.WriteUInt32LittleEndian(packet[8..], 0);
+
+        if (Crc32.HashToUInt32(packet) != crc)
+        {
+            return false;
+        }
+
+        messageType = BinaryPrimitives.ReadUInt32LittleEndian(packet[HeaderLength..]);
+        payload = packet[(HeaderLength + sizeof(uint))..];
+
+        return true;
+    }
+
+    /// <summary>
+    ///     Writes the packet header and message type, the CRC gets filled in by <see cref="Seal" />.
+    /// </summary>
+    private static void WriteHeader(Span<byte> packet, uint serverId, uint messageType)
+    {
+        ServerMagic.CopyTo(packet);
+        BinaryPrimitives.WriteUInt16LittleEndian(packet[4..], ProtocolVersion);
+        BinaryPrimitives.WriteUInt16LittleEndian(packet[6..], (ushort)(packet.Length - HeaderLength));
+        BinaryPrimitives.WriteUInt32LittleEndian(packet[8..], 0);
+        BinaryPrimitives.WriteUInt32LittleEndian(packet[12..], serverId);
+        BinaryPrimitives.WriteUInt32LittleEndian(packet[HeaderLength..], messageType);
+    }
+
+    private static void Seal(Span<byte> packet)
+    {
+        BinaryPrimitives.WriteUInt32LittleEndian(packet[8..], Crc32.HashToUInt32(packet));
+    }
+
+    /// <summary>
+    ///     Writes the controller header shared by port info and pad data replies.
+    /// </summary>
+    private static void WriteSlotHeader(Span<byte> slot, in DsuSlotState state)
+    {
+        slot[0] = state.Index;
+        slot[1] = (byte)(state.IsConnected ? 2 : 0); // connected / not connected
+        slot[2] = (byte)(state.IsConnected ? 2 : 0); // full gyro / not applicable
+        slot[3] = 0; // connection type not applicable
+        state.WriteMacAddress(slot[4..10]);
+        //
+        // DS3 battery states map 1:1 to the protocol values
+        //
+        slot[10] = state.IsConnected ? state.BatteryStatus : (byte)0;
+    }
+
+    public static void WriteVersion(Span<byte> packet, uint serverId)
+    {
+        packet = packet[..VersionLength];
+
+        WriteHeader(packet, serverId, MessageTypeVersion);
+        BinaryPrimitives.WriteUInt16LittleEndian(packet[20..], ProtocolVersion);
+        Seal(packet);
+    }
+
+    public static void WritePortInfo(Span<byte> packet, uint serverId, in DsuSlotState state)
+    {
+        packet = packet[..PortInfoLength];
+
+        WriteHeader(packet, serverId, MessageTypePortInfo);
+        WriteSlotHeader(packet[20..], state);
+        packet[31] = 0;
+        Seal(packet);
+    }
+
+    /// <summary>
+    ///     Encodes a controller data packet from the driver's input report and motion sample.
+    /// </summary>
+    /// <remarks>
+    ///     Motion is expressed in the same coordinate space the driver uses for its DS4 emulation; the DS3 only
+    ///     provides a yaw rate so gyro pitch and roll are always reported as zero.
+    /// </remarks>
+    public static void WritePadData(Span<byte> packet, uint serverId, in DsuSlotState state, uint packetNumber,
+        in DS3_RAW_INPUT_REPORT report, in DS3_MOTION_SAMPLE motion, ulong timestampMicroseconds)
+    {
+        packet = packet[..PadDataLength];
+
+        WriteHeader(packet, serverId, MessageTypePadData);
+        WriteSlotHeader(packet[20..], state);
+
+        Span<byte> data = packet[31..];
+
+        data[0] = (byte)(state.IsConnected ? 1 : 0);
+        BinaryPrimitives.WriteUInt32LittleEndian(data[1..], packetNumber);
+
+        DS3_RAW_INPUT_REPORT.ButtonUnion buttons = report.Buttons;
+
+        data[5] = (byte)(
+            (buttons.Left ? 0x80 : 0) |
+            (buttons.Down ? 0x40 : 0) |
+            (buttons.Right ? 0x20 : 0) |
+            (buttons.Up ? 0x10 : 0) |
+            (buttons.Start ? 0x08 : 0) |
+            (buttons.R3 ? 0x04 : 0) |
+            (buttons.L3 ? 0x02 : 0) |
+            (buttons.Select ? 0x01 : 0)
+        );
+        data[6] = (byte)(
+            (buttons.Triangle ? 0x80 : 0) |
+            (buttons.Circle ? 0x40 : 0) |
+            (buttons.Cross ? 0x20 : 0) |
+            (buttons.Square ? 0x10 : 0) |
+            (buttons.R1 ? 0x08 : 0) |
+            (buttons.L1 ? 0x04 : 0) |
+            (buttons.R2 ? 0x02 : 0) |
+            (buttons.L2 ? 0x01 : 0)
+        );
+        data[7] = (byte)(buttons.PS ? 1 : 0);
+        data[8] = 0; // touch button
+
+        //
+        // Protocol expects Y axes with up being positive
+        //
+        data[9] = report.LeftThumbX;
+        data[10] = (byte)(byte.MaxValue - report.LeftThumbY);
+        data[11] = report.RightThumbX;
+        data[12] = (byte)(byte.MaxValue - report.RightThumbY);
+
+        DS3_RAW_INPUT_REPORT.PressureUnion.PressureValues pressure = report.Pressure.Values;
+
+        data[13] = pressure.Left;
+        data[14] = pressure.Down;
+        data[15] = pressure.Right;
+        data[16] = pressure.Up;
+        data[17] = pressure.Triangle;
+        data[18] = pressure.Circle;
+        data[19] = pressure.Cross;
+        data[20] = pressure.Square;
+        data[21] = pressure.R1;
+        data[22] = pressure.L1;
+        data[23] = pressure.R2;
+        data[24] = pressure.L2;
+
+        //
+        // Two inactive touch points
+        //
+        data[25..37].Clear();
+
+        BinaryPrimitives.WriteUInt64LittleEndian(data[37..], timestampMicroseconds);
+
+        const float unitsPerG = 8192.0f;
+        const float unitsPerDps = 16.0f;
+
+        BinaryPrimitives.WriteSingleLittleEndian(data[45..], -motion.AccelerometerX / unitsPerG);
+        BinaryPrimitives.WriteSingleLittleEndian(data[49..], motion.AccelerometerZ / unitsPerG);
+        BinaryPrimitives.WriteSingleLittleEndian(data[53..], -motion.AccelerometerY / unitsPerG);
+        BinaryPrimitives.WriteSingleLittleEndian(data[57..], 0.0f);
+        BinaryPrimitives.WriteSingleLittleEndian(data[61..], -motion.Gyroscope / unitsPerDps);
+        BinaryPrimitives.WriteSingleLittleEndian(data[65..], 0.0f);
+
+        Seal(packet);
+    }
+}
@@ -0,0 +1,329 @@
+﻿using System.Buffers.Binary;
+using System.Diagnostics;
+using System.Net;
+using System.Net.Sockets;
+
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer;
+
+/// <summary>
+///     cemuhook/DSU UDP server, serves up to <see cref="DsuProtocol.MaxSlots" /> controllers.
+/// </summary>
+/// <remarks>
+///     Client requests are answered from a dedicated receive thread, controller data is pushed to subscribed clients
+///     from <see cref="Publish" /> so packets leave as soon as the driver signalled a new input report.
+/// </remarks>
+internal sealed class DsuServer : IDisposable
+{
+    /// <summary>
+    ///     Clients have to renew their pad data request within this period, most send one each second.
+    /// </summary>
+    private static readonly long SubscriptionTimeout = Stopwatch.Frequency * 5;
+
+    private readonly Dictionary<EndPoint, Subscriber> _subscribers = new();
+
+    private readonly Thread _receiveThread;
+
+    private readonly uint _serverId = (uint)Random.Shared.Next();
+
+    private readonly DsuSlotState[] _slots = new DsuSlotState[DsuProtocol.MaxSlots];
+
+    private readonly object _sourceLock = new();
+
+    private readonly Func<IDsuReportSource> _sourceFactory;
+
+    private IDsuReportSource? _source;
+
+    private readonly Socket _socket;
+
+    /// <param name="endPoint">Local end point to listen on.</param>
+    /// <param name="sourceFactory">Creates the report source shared by all slot readers on first use.</param>
+    public DsuServer(IPEndPoint endPoint, Func<IDsuReportSource> sourceFactory)
+    {
+        _sourceFactory = sourceFactory;
+
+        _socket = new Socket(endPoint.AddressFamily, SocketType.Dgram, ProtocolType.Udp);
+
+        //
+        // Prevent ICMP port unreachable replies of vanished clients from failing the receive call
+        //
+        if (OperatingSystem.IsWindows())
+        {
+            const int SIO_UDP_CONNRESET = -1744830452;
+
+            _socket.IOControl(SIO_UDP_CONNRESET, [0], null);
+        }
+
+        _socket.Bind(endPoint);
+
+        for (byte slot = 0; slot < _slots.Length; slot++)
+        {
+            _slots[slot] = new DsuSlotState(slot, false, 0);
+        }
+
+        _receiveThread = new Thread(ReceiveLoop) { IsBackground = true, Name = "DSU receive" };
+        _receiveThread.Start();
+    }
+
+    public EndPoint LocalEndPoint => _socket.LocalEndPoint!;
+
+    public void Dispose()
+    {
+        _socket.Dispose();
+        _receiveThread.Join();
+
+        lock (_sourceLock)
+        {
+            _source?.Dispose();
+            _source = null;
+        }
+    }
+
+    /// <summary>
+    ///     Gets the report source shared by all slot readers, creates it on first use.
+    /// </summary>
+    /// <exception cref="Nefarius.DsHidMini.IPC.Exceptions.DsHidMiniInteropUnavailableException">
+    ///     No driver instance is available (yet).
+    /// </exception>
+    public IDsuReportSource GetReportSource()
+    {
+        lock (_sourceLock)
+        {
+            return _source ??= _sourceFactory();
+        }
+    }
+
+    /// <summary>
+    ///     Current time in microseconds, split to not overflow on long uptimes.
+    /// </summary>
+    public static ulong TimestampMicroseconds()
+    {
+        long now = Stopwatch.GetTimestamp();
+
+        return (ulong)(now / Stopwatch.Frequency * 1_000_000 + now % Stopwatch.Frequency * 1_000_000 / Stopwatch.Frequency);
+    }
+
+    /// <summary>
+    ///     Sends a new controller state to all clients subscribed to the given slot.
+    /// </summary>
+    public void Publish(byte slot, in DS3_RAW_INPUT_REPORT report, in DS3_MOTION_SAMPLE motion, ulong timestamp)
+    {
+        DsuSlotState state = new(slot, true, report.BatteryStatus);
+        Span<byte> packet = stackalloc byte[DsuProtocol.PadDataLength];
+        long now = Stopwatch.GetTimestamp();
+
+        lock (_subscribers)
+        {
+            _slots[slot] = state;
+
+            foreach ((EndPoint endPoint, Subscriber subscriber) in _subscribers)
+            {
+                if (!subscriber.IsSubscribed(slot, now))
+                {
+                    continue;
+                }
+
+                DsuProtocol.WritePadData(packet, _serverId, state, subscriber.PacketNumbers[slot]++, report, motion,
+                    timestamp);
+
+                Send(packet, endPoint);
+            }
+        }
+    }
+
+    /// <summary>
+    ///     Marks a slot as unoccupied.
+    /// </summary>
+    public void Disconnect(byte slot)
+    {
+        lock (_subscribers)
+        {
+            _slots[slot] = new DsuSlotState(slot, false, 0);
+        }
+    }
+
+    private void Send(ReadOnlySpan<byte> packet, EndPoint endPoint)
+    {
+        try
+        {
+            _socket.SendTo(packet, SocketFlags.None, endPoint);
+        }
+        catch (SocketException)
+        {
+            //
+            // Best effort, the client will re-request if it's still around
+            //
+        }
+    }
+
+    private void ReceiveLoop()
+    {
+        byte[] buffer = new byte[1024];
+        EndPoint any = new IPEndPoint(
+            _socket.AddressFamily == AddressFamily.InterNetworkV6 ? IPAddress.IPv6Any : IPAddress.Any, 0);
+
+        while (true)
+        {
+            int length;
+            EndPoint remote = any;
+
+            try
+            {
+                length = _socket.ReceiveFrom(buffer, ref remote);
+            }
+            catch (SocketException)
+            {
+                continue;
+            }
+            catch (ObjectDisposedException)
+            {
+                return;
+            }
+
+            if (!DsuProtocol.TryParseClientPacket(buffer.AsSpan(0, length), out uint messageType,
+                    out ReadOnlySpan<byte> payload))
+            {
+                continue;
+            }
+
+            switch (messageType)
+            {
+                case DsuProtocol.MessageTypeVersion:
+                    OnVersionRequest(remote);
+                    break;
+                case DsuProtocol.MessageTypePortInfo:
+                    OnPortInfoRequest(remote, payload);
+                    break;
+                case DsuProtocol.MessageTypePadData:
+                    OnPadDataRequest(remote, payload);
+                    break;
+            }
+        }
+    }
+
+    private void OnVersionRequest(EndPoint remote)
+    {
+        Span<byte> packet = stackalloc byte[DsuProtocol.VersionLength];
+
+        DsuProtocol.WriteVersion(packet, _serverId);
+
+        Send(packet, remote);
+    }
+
+    private void OnPortInfoRequest(EndPoint remote, ReadOnlySpan<byte> payload)
+    {
+        if (payload.Length < sizeof(int))
+        {
+            return;
+        }
+
+        int count = Math.Min(BinaryPrimitives.ReadInt32LittleEndian(payload), DsuProtocol.MaxSlots);
+        Span<byte> packet = stackalloc byte[DsuProtocol.PortInfoLength];
+
+        for (int i = 0; i < count && sizeof(int) + i < payload.Length; i++)
+        {
+            byte slot = payload[sizeof(int) + i];
+
+            if (slot >= DsuProtocol.MaxSlots)
+            {
+                continue;
+            }
+
+            DsuSlotState state;
+
+            lock (_subscribers)
+            {
+                state = _slots[slot];
+            }
+
+            DsuProtocol.WritePortInfo(packet, _serverId, state);
+
+            Send(packet, remote);
+        }
+    }
+
+    private void OnPadDataRequest(EndPoint remote, ReadOnlySpan<byte> payload)
+    {
+        if (payload.Length < 8)
+        {
+            return;
+        }
+
+        byte flags = payload[0];
+        byte slot = payload[1];
+        ReadOnlySpan<byte> macAddress = payload[2..8];
+        long now = Stopwatch.GetTimestamp();
+
+        lock (_subscribers)
+        {
+            //
+            // Forget about clients that stopped asking for data
+            //
+            foreach ((EndPoint endPoint, Subscriber expired) in _subscribers)
+            {
+                if (!expired.IsAlive(now))
+                {
+                    _subscribers.Remove(endPoint);
+                }
+            }
+
+            if (!_subscribers.TryGetValue(remote, out Subscriber? subscriber))
+            {
+                subscriber = new Subscriber();
+                _subscribers.Add(remote, subscriber);
+            }
+
+            //
+            // No flags set subscribes to all slots
+            //
+            if (flags == 0)
+            {
+                subscriber.AllSlotsRequested = now;
+                return;
+            }
+
+            if ((flags & 0x01) != 0 && slot < DsuProtocol.MaxSlots)
+            {
+                subscriber.SlotRequested[slot] = now;
+            }
+
+            if ((flags & 0x02) != 0)
+            {
+                Span<byte> slotMacAddress = stackalloc byte[6];
+
+                foreach (DsuSlotState state in _slots)
+                {
+                    state.WriteMacAddress(slotMacAddress);
+
+                    if (state.IsConnected && slotMacAddress.SequenceEqual(macAddress))
+                    {
+                        subscriber.SlotRequested[state.Index] = now;
+                    }
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    ///     Subscription state and per-slot packet counters of one client.
+    /// </summary>
+    private sealed class Subscriber
+    {
+        public long AllSlotsRequested { get; set; }
+
+        public long[] SlotRequested { get; } = new long[DsuProtocol.MaxSlots];
+
+        public uint[] PacketNumbers { get; } = new uint[DsuProtocol.MaxSlots];
+
+        public bool IsSubscribed(byte slot, long now)
+        {
+            return now - AllSlotsRequested < SubscriptionTimeout || now - SlotRequested[slot] < SubscriptionTimeout;
+        }
+
+        public bool IsAlive(long now)
+        {
+            return now - Math.Max(AllSlotsRequested, SlotRequested.Max()) < SubscriptionTimeout;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+﻿using Nefarius.DsHidMini.IPC.Exceptions;
+using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer;
+
+/// <summary>
+///     Forwards the input reports of one driver device to its DSU slot.
+/// </summary>
+/// <remarks>
+///     All readers share the <see cref="IDsuReportSource" /> instance of the server, the driver IPC keeps one input
+///     report wait handle per device. Reads block on that handle, so a report is published right after the driver signalled it.
+/// </remarks>
+internal sealed class DsuSlotReader : IDisposable
+{
+    /// <summary>
+    ///     Upper bound of how long a read blocks without a new report arriving.
+    /// </summary>
+    private static readonly TimeSpan ReportTimeout = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    ///     Delay before looking for a device again after the slot became or was found empty.
+    /// </summary>
+    private static readonly TimeSpan RetryInterval = TimeSpan.FromSeconds(2);
+
+    private readonly CancellationTokenSource _cancellation = new();
+
+    private readonly DsuServer _server;
+
+    private readonly byte _slot;
+
+    private readonly Thread _thread;
+
+    public DsuSlotReader(DsuServer server, byte slot)
+    {
+        _server = server;
+        _slot = slot;
+
+        _thread = new Thread(ReadLoop) { IsBackground = true, Name = $"DSU slot {slot}" };
+        _thread.Start();
+    }
+
+    public void Dispose()
+    {
+        _cancellation.Cancel();
+        _thread.Join();
+        _cancellation.Dispose();
+    }
+
+    private void ReadLoop()
+    {
+        CancellationToken token = _cancellation.Token;
+        DS3_RAW_INPUT_REPORT report = new();
+        DS3_MOTION_SAMPLE motion = new();
+
+        while (!token.IsCancellationRequested)
+        {
+            try
+            {
+                IDsuReportSource source = _server.GetReportSource();
+
+                //
+                // Driver device indexes are one-based
+                //
+                while (!token.IsCancellationRequested &&
+                       source.GetRawInputReport(_slot + 1, ref report, ref motion, out bool isUpdated, ReportTimeout))
+                {
+                    //
+                    // Nothing arrived in time, don't send the previous state again as a new packet
+                    //
+                    if (!isUpdated)
+                    {
+                        continue;
+                    }
+
+                    _server.Publish(_slot, report, motion, DsuServer.TimestampMicroseconds());
+                }
+            }
+            catch (Exception ex) when (ex is DsHidMiniInteropUnavailableException
+                                           or DsHidMiniInteropUnexpectedReplyException
+                                           or DsHidMiniInteropReplyTimeoutException
+                                           or DsHidMiniInteropConcurrencyException)
+            {
+                //
+                // No driver instance or device in this slot (yet), try again later
+                //
+            }
+
+            _server.Disconnect(_slot);
+
+            token.WaitHandle.WaitOne(RetryInterval);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+﻿namespace Nefarius.DsHidMini.DsuServer;
+
+/// <summary>
+///     Per-slot controller information shared by all reply types.
+/// </summary>
+internal readonly struct DsuSlotState
+{
+    public DsuSlotState(byte index, bool isConnected, byte batteryStatus)
+    {
+        Index = index;
+        IsConnected = isConnected;
+        BatteryStatus = batteryStatus;
+    }
+
+    /// <summary>
+    ///     Zero-based protocol slot, maps to the one-based driver device index.
+    /// </summary>
+    public byte Index { get; }
+
+    public bool IsConnected { get; }
+
+    public byte BatteryStatus { get; }
+
+    /// <summary>
+    ///     Clients only use this to tell controllers apart, so a stable per-slot value is sufficient.
+    /// </summary>
+    public void WriteMacAddress(Span<byte> destination)
+    {
+        destination[..6].Clear();
+
+        if (IsConnected)
+        {
+            destination[5] = (byte)(Index + 1);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+﻿using Nefarius.DsHidMini.IPC.Models.Public;
+
+namespace Nefarius.DsHidMini.DsuServer;
+
+/// <summary>
+///     Supplies the input reports and motion samples of the driver devices to the slot readers.
+/// </summary>
+/// <remarks>
+///     <see cref="DsHidMiniReportSource" /> reads them from the driver IPC shared memory; the abstraction exists so the
+///     server can be exercised against a simulated producer.
+/// </remarks>
+internal interface IDsuReportSource : IDisposable
+{
+    /// <summary>
+    ///     Waits up to <paramref name="timeout" /> for a new report of the given device and copies it out.
+    /// </summary>
+    /// <param name="deviceIndex">The one-based device index.</param>
+    /// <param name="report">The <see cref="DS3_RAW_INPUT_REPORT" /> to populate.</param>
+    /// <param name="motion">The <see cref="DS3_MOTION_SAMPLE" /> to populate.</param>
+    /// <param name="isUpdated">FALSE if nothing new arrived in time, the values are the ones already read before.</param>
+    /// <param name="timeout">How long to wait for a report update to arrive.</param>
+    /// <returns>TRUE if the values got filled in or FALSE if the given <paramref name="deviceIndex" /> is not occupied.</returns>
+    bool GetRawInputReport(int deviceIndex, ref DS3_RAW_INPUT_REPORT report, ref DS3_MOTION_SAMPLE motion,
+        out bool isUpdated, TimeSpan timeout);
+}
@@ -0,0 +1,36 @@
+﻿// cemuhook/DSU motion server fed from the DsHidMini IPC input report shared memory
+//
+// Usage: dsuserver [port] [--any]
+//   port   UDP port to listen on, defaults to 26760
+//   --any  listen on all interfaces instead of loopback only
+
+using System.Net;
+
+using Nefarius.DsHidMini.DsuServer;
+
+int port = args.Select(a => int.TryParse(a, out int p) ? p : 0).FirstOrDefault(p => p is > 0 and <= ushort.MaxValue,
+    DsuProtocol.DefaultPort);
+IPAddress address = args.Contains("--any") ? IPAddress.Any : IPAddress.Loopback;
+
+using ManualResetEventSlim exit = new();
+
+Console.CancelKeyPress += (_, e) =>
+{
+    e.Cancel = true;
+    exit.Set();
+};
+
+using DsuServer server = new(new IPEndPoint(address, port), () => new DsHidMiniReportSource());
+
+List<DsuSlotReader> readers = [];
+
+for (byte slot = 0; slot < DsuProtocol.MaxSlots; slot++)
+{
+    readers.Add(new DsuSlotReader(server, slot));
+}
+
+Console.WriteLine($"DSU server listening on {server.LocalEndPoint}, press CTRL+C to exit");
+
+exit.Wait();
+
+readers.ForEach(r => r.Dispose());
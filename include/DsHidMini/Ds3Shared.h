@@ -0,0 +1,79 @@
+#pragma once
+
+//
+// Extracts the D-Pad nibble (Left [3], Down [2], Right [1], Up [0]) of a raw input report
+//
+#define DS3_RAW_DPAD_NIBBLE(_report_)	((UCHAR)((_report_)->Buttons.bButtons[0] >> 4))
+
+//
+// D-Pad nibble to HAT switch value, 0 (N) to 7 (NW) clockwise, 8 = released
+//   Invalid combinations (e.g. Up + Down) are reported as released
+//
+static const UCHAR G_DS3_DPAD_TO_HAT[16] =
+{
+	8, // (none)
+	0, // N
+	2, // E
+	1, // NE
+	4, // S
+	8, // N + S
+	3, // SE
+	8, // N + E + S
+	6, // W
+	7, // NW
+	8, // E + W
+	8, // N + E + W
+	5, // SW
+	8, // N + S + W
+	8, // E + S + W
+	8, // N + E + S + W
+};
+
+//
+// D-Pad nibble to HAT switch value, 1 (N) to 8 (NW) clockwise, 0 = released
+//   Invalid combinations (e.g. Up + Down) are reported as released
+//
+static const UCHAR G_DS3_DPAD_TO_HAT_ONE_BASED[16] =
+{
+	0, // (none)
+	1, // N
+	3, // E
+	2, // NE
+	5, // S
+	0, // N + S
+	4, // SE
+	0, // N + E + S
+	7, // W
+	8, // NW
+	0, // E + W
+	0, // N + E + W
+	6, // SW
+	0, // N + S + W
+	0, // E + S + W
+	0, // N + E + S + W
+};
+
+//
+// D-Pad nibble to XINPUT_GAMEPAD wButtons bits
+//   UP = 0x0001, DOWN = 0x0002, LEFT = 0x0004, RIGHT = 0x0008
+//   Invalid combinations (e.g. Up + Down) are reported as released
+//
+static const USHORT G_DS3_DPAD_TO_XINPUT_BUTTONS[16] =
+{
+	0x0000, // (none)
+	0x0001, // N
+	0x0008, // E
+	0x0009, // NE
+	0x0002, // S
+	0x0000, // N + S
+	0x000A, // SE
+	0x0000, // N + E + S
+	0x0004, // W
+	0x0005, // NW
+	0x0000, // E + W
+	0x0000, // N + E + W
+	0x0006, // SW
+	0x0000, // N + S + W
+	0x0000, // E + S + W
+	0x0000, // N + E + S + W
+};
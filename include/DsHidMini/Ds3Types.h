@@ -216,3 +216,32 @@ typedef struct _XINPUT_HID_INPUT_REPORT
 	 UCHAR  GEN_GamePadBatteryStrength;               // Usage 0x00060020: Battery Strength, Value = 0 to 255
  } XINPUT_HID_INPUT_REPORT, * PXINPUT_HID_INPUT_REPORT;
 #include <poppack.h>
+
+#include <pshpack1.h>
+/**
+ * Input Report of the raw passthrough HID device mode.
+ */
+typedef struct _DS3_RAW_PASSTHROUGH_HID_INPUT_REPORT
+{
+	//
+	// Report ID (always 0x01)
+	// 
+	UCHAR ReportId;
+
+	//
+	// Unmodified native input report, including its own Report ID
+	// 
+	DS3_RAW_INPUT_REPORT Report;
+
+	//
+	// Incremented with every delivered report, wraps around
+	// 
+	ULONG SequenceNumber;
+
+	//
+	// Arrival time of the native report in microseconds (monotonic, arbitrary epoch)
+	// 
+	ULONGLONG Timestamp;
+
+} DS3_RAW_PASSTHROUGH_HID_INPUT_REPORT, * PDS3_RAW_PASSTHROUGH_HID_INPUT_REPORT;
+#include <poppack.h>
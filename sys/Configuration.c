@@ -141,6 +141,60 @@ static DS_LED_AUTHORITY DS_LED_AUTHORITY_FROM_NAME(_In_ const PSTR AuthorityName
 	return DsLEDAuthorityAutomatic;
 }
 
+//
+// Translates a friendly name string into the corresponding DS_RESPONSE_CURVE_TYPE value
+// 
+static DS_RESPONSE_CURVE_TYPE DS_RESPONSE_CURVE_TYPE_FROM_NAME(_In_ const PSTR TypeName)
+{
+	if (!_strcmpi(TypeName, G_RESPONSE_CURVE_TYPE_NAMES[2]))
+	{
+		return DsResponseCurveTypeSCurve;
+	}
+
+	if (!_strcmpi(TypeName, G_RESPONSE_CURVE_TYPE_NAMES[1]))
+	{
+		return DsResponseCurveTypeExponential;
+	}
+
+	return DsResponseCurveTypeLinear;
+}
+
+//
+// Translates a friendly name string into the corresponding DS_INPUT_RATE_LIMIT_POLICY value
+// 
+static DS_INPUT_RATE_LIMIT_POLICY DS_INPUT_RATE_LIMIT_POLICY_FROM_NAME(_In_ const PSTR PolicyName)
+{
+	if (!_strcmpi(PolicyName, G_INPUT_RATE_LIMIT_POLICY_NAMES[2]))
+	{
+		return DsInputRateLimitPolicyImmediateOnChange;
+	}
+
+	if (!_strcmpi(PolicyName, G_INPUT_RATE_LIMIT_POLICY_NAMES[1]))
+	{
+		return DsInputRateLimitPolicyLatestWins;
+	}
+
+	return DsInputRateLimitPolicyDisabled;
+}
+
+//
+// Translates a friendly name string into the corresponding DS_BUTTON_COMBO_ACTION value
+// 
+static DS_BUTTON_COMBO_ACTION DS_BUTTON_COMBO_ACTION_FROM_NAME(_In_ const PSTR ActionName)
+{
+	if (!_strcmpi(ActionName, G_DS_BUTTON_COMBO_ACTION_NAMES[2]))
+	{
+		return DsButtonComboActionToggleAlternativeRumble;
+	}
+
+	if (!_strcmpi(ActionName, G_DS_BUTTON_COMBO_ACTION_NAMES[1]))
+	{
+		return DsButtonComboActionWirelessDisconnect;
+	}
+
+	return DsButtonComboActionNone;
+}
+
 #pragma endregion
 
 //
@@ -195,6 +249,285 @@ ConfigParseButtonComboSettings(
 }
 #pragma warning(pop)
 
+//
+// Parse input report change detection settings
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseInputChangeDetectionSettings(
+	_In_ const cJSON* ChangeDetectionSettings,
+	_Inout_ PDS_INPUT_CHANGE_DETECTION_SETTINGS Settings
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(ChangeDetectionSettings, "IsEnabled")))
+	{
+		Settings->IsEnabled = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(ChangeDetectionSettings->string, "IsEnabled",
+			Settings->IsEnabled);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(ChangeDetectionSettings, "HeartbeatPeriodMs")))
+	{
+		Settings->HeartbeatPeriodMs = (ULONG)cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingUInt(ChangeDetectionSettings->string, "HeartbeatPeriodMs",
+			Settings->HeartbeatPeriodMs);
+	}
+}
+#pragma warning(pop)
+
+//
+// Parse input report backlog settings
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseInputReportBacklogSettings(
+	_In_ const cJSON* BacklogSettings,
+	_Inout_ PDS_INPUT_REPORT_BACKLOG_SETTINGS Settings
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(BacklogSettings, "Depth")))
+	{
+		const ULONG depth = (ULONG)cJSON_GetNumberValue(pNode);
+		if (depth <= DS_INPUT_REPORT_BACKLOG_MAX_DEPTH)
+		{
+			Settings->Depth = (UCHAR)depth;
+			EventWriteOverrideSettingUInt(BacklogSettings->string, "Depth",
+				Settings->Depth);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided input report backlog depth %d out of range, ignoring",
+				depth
+			);
+		}
+	}
+
+	if ((pNode = cJSON_GetObjectItem(BacklogSettings, "IsLatestOnly")))
+	{
+		Settings->IsLatestOnly = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(BacklogSettings->string, "IsLatestOnly",
+			Settings->IsLatestOnly);
+	}
+}
+#pragma warning(pop)
+
+//
+// Parse input report rate limit settings
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseInputRateLimitSettings(
+	_In_ const cJSON* RateLimitSettings,
+	_Inout_ PDS_INPUT_RATE_LIMIT_SETTINGS Settings
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(RateLimitSettings, "Policy")))
+	{
+		Settings->Policy = DS_INPUT_RATE_LIMIT_POLICY_FROM_NAME(cJSON_GetStringValue(pNode));
+		EventWriteOverrideSettingUInt(RateLimitSettings->string, "Policy",
+			Settings->Policy);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(RateLimitSettings, "MinimumIntervalMs")))
+	{
+		const ULONG interval = (ULONG)cJSON_GetNumberValue(pNode);
+		if (interval >= 1 && interval <= 1000)
+		{
+			Settings->MinimumIntervalMs = interval;
+			EventWriteOverrideSettingUInt(RateLimitSettings->string, "MinimumIntervalMs",
+				Settings->MinimumIntervalMs);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided input rate limit interval %d out of range, ignoring",
+				interval
+			);
+		}
+	}
+}
+#pragma warning(pop)
+
+//
+// Parse Bluetooth input read pipeline settings
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseBthInputPipelineSettings(
+	_In_ const cJSON* PipelineSettings,
+	_Inout_ PDS_BTH_INPUT_PIPELINE_SETTINGS Settings
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(PipelineSettings, "RequestCount")))
+	{
+		const ULONG count = (ULONG)cJSON_GetNumberValue(pNode);
+		if (count >= 1 && count <= DS_BTH_INPUT_PIPELINE_MAX_DEPTH)
+		{
+			Settings->RequestCount = (UCHAR)count;
+			EventWriteOverrideSettingUInt(PipelineSettings->string, "RequestCount",
+				Settings->RequestCount);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided Bluetooth input request count %d out of range, ignoring",
+				count
+			);
+		}
+	}
+
+	if ((pNode = cJSON_GetObjectItem(PipelineSettings, "BufferCount")))
+	{
+		const ULONG count = (ULONG)cJSON_GetNumberValue(pNode);
+		if (count >= 1 && count <= DS_BTH_INPUT_PIPELINE_MAX_DEPTH)
+		{
+			Settings->BufferCount = (UCHAR)count;
+			EventWriteOverrideSettingUInt(PipelineSettings->string, "BufferCount",
+				Settings->BufferCount);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided Bluetooth input buffer count %d out of range, ignoring",
+				count
+			);
+		}
+	}
+}
+#pragma warning(pop)
+
+//
+// Parse USB input continuous reader settings
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseUsbInputPipelineSettings(
+	_In_ const cJSON* PipelineSettings,
+	_Inout_ PDS_USB_INPUT_PIPELINE_SETTINGS Settings
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(PipelineSettings, "RequestCount")))
+	{
+		const ULONG count = (ULONG)cJSON_GetNumberValue(pNode);
+		if (count >= 1 && count <= DS_USB_INPUT_PIPELINE_MAX_DEPTH)
+		{
+			Settings->RequestCount = (UCHAR)count;
+			EventWriteOverrideSettingUInt(PipelineSettings->string, "RequestCount",
+				Settings->RequestCount);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided USB input request count %d out of range, ignoring",
+				count
+			);
+		}
+	}
+
+	if ((pNode = cJSON_GetObjectItem(PipelineSettings, "TransferLength")))
+	{
+		const ULONG length = (ULONG)cJSON_GetNumberValue(pNode);
+		if (length >= DS_USB_INPUT_PIPELINE_MIN_TRANSFER_LENGTH && length <= DS_USB_INPUT_PIPELINE_MAX_TRANSFER_LENGTH)
+		{
+			Settings->TransferLength = (USHORT)length;
+			EventWriteOverrideSettingUInt(PipelineSettings->string, "TransferLength",
+				Settings->TransferLength);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided USB input transfer length %d out of range, ignoring",
+				length
+			);
+		}
+	}
+
+	if ((pNode = cJSON_GetObjectItem(PipelineSettings, "IsValidationEnabled")))
+	{
+		Settings->IsValidationEnabled = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(PipelineSettings->string, "IsValidationEnabled",
+			Settings->IsValidationEnabled);
+	}
+}
+#pragma warning(pop)
+
+//
+// Parse motion sensor pipeline settings
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseMotionSettings(
+	_In_ const cJSON* MotionSettings,
+	_Inout_ PDS_MOTION_SETTINGS Settings
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(MotionSettings, "IsCalibrationEnabled")))
+	{
+		Settings->IsCalibrationEnabled = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(MotionSettings->string, "IsCalibrationEnabled",
+			Settings->IsCalibrationEnabled);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(MotionSettings, "CalibrationWindow")))
+	{
+		const ULONG window = (ULONG)cJSON_GetNumberValue(pNode);
+		if (window > 0 && window <= MAXUSHORT)
+		{
+			Settings->CalibrationWindow = (USHORT)window;
+			EventWriteOverrideSettingUInt(MotionSettings->string, "CalibrationWindow",
+				Settings->CalibrationWindow);
+		}
+		else
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"Provided motion calibration window %d out of range, ignoring",
+				window
+			);
+		}
+	}
+
+	if ((pNode = cJSON_GetObjectItem(MotionSettings, "IsTiltEstimationEnabled")))
+	{
+		Settings->IsTiltEstimationEnabled = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(MotionSettings->string, "IsTiltEstimationEnabled",
+			Settings->IsTiltEstimationEnabled);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(MotionSettings, "TiltFilterWeight")))
+	{
+		Settings->TiltFilterWeight = (UCHAR)cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingUInt(MotionSettings->string, "TiltFilterWeight",
+			Settings->TiltFilterWeight);
+	}
+}
+#pragma warning(pop)
+
 #pragma region Parsers
 
 //
@@ -405,6 +738,44 @@ ConfigParseHidDeviceModeSpecificSettings(
 {
 	cJSON* pNode = NULL;
 
+	//
+	// Pressure noise gate, applies to every mode exposing pressure values
+	// 
+	const cJSON* pNoiseGate = cJSON_GetObjectItem(NodeSettings, "PressureNoiseGate");
+
+	if (pNoiseGate)
+	{
+		if ((pNode = cJSON_GetObjectItem(pNoiseGate, "IsEnabled")))
+		{
+			Config->PressureNoiseGate.IsEnabled = (BOOLEAN)cJSON_IsTrue(pNode);
+			EventWriteOverrideSettingUInt(pNoiseGate->string, "PressureNoiseGate.IsEnabled", Config->PressureNoiseGate.IsEnabled);
+		}
+
+		//
+		// Common threshold for all channels
+		// 
+		if ((pNode = cJSON_GetObjectItem(pNoiseGate, "Threshold")))
+		{
+			for (ULONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+			{
+				Config->PressureNoiseGate.Thresholds[channel] = (UCHAR)cJSON_GetNumberValue(pNode);
+			}
+			EventWriteOverrideSettingUInt(pNoiseGate->string, "PressureNoiseGate.Threshold", Config->PressureNoiseGate.Thresholds[0]);
+		}
+
+		//
+		// Individual channel overrides
+		// 
+		for (ULONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+		{
+			if ((pNode = cJSON_GetObjectItem(pNoiseGate, G_DS_PRESSURE_CHANNEL_NAMES[channel])))
+			{
+				Config->PressureNoiseGate.Thresholds[channel] = (UCHAR)cJSON_GetNumberValue(pNode);
+				EventWriteOverrideSettingUInt(pNoiseGate->string, G_DS_PRESSURE_CHANNEL_NAMES[channel], Config->PressureNoiseGate.Thresholds[channel]);
+			}
+		}
+	}
+
 	//
 	// SDF/GPJ-specific settings
 	// 
@@ -446,6 +817,99 @@ ConfigParseHidDeviceModeSpecificSettings(
 }
 #pragma warning(pop)
 
+//
+// Parse user-defined button combos
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseCustomButtonCombos(
+	_In_ const cJSON* CombosArray,
+	_Inout_ PDS_DRIVER_CONFIGURATION Config
+)
+{
+	cJSON* pNode = NULL;
+	const cJSON* pEntry = NULL;
+
+	Config->CustomButtonCombos.Count = 0;
+
+	cJSON_ArrayForEach(pEntry, CombosArray)
+	{
+		if (Config->CustomButtonCombos.Count >= DS_CUSTOM_BUTTON_COMBO_MAX_ENTRIES)
+		{
+			TraceError(
+				TRACE_CONFIG,
+				"More than %d button combos defined, ignoring the rest",
+				DS_CUSTOM_BUTTON_COMBO_MAX_ENTRIES
+			);
+			break;
+		}
+
+		const PDS_CUSTOM_BUTTON_COMBO pCustom = &Config->CustomButtonCombos.Entries[Config->CustomButtonCombos.Count];
+
+		//
+		// Omitted buttons stay out of range and are not part of the combination
+		// 
+		pCustom->Combo.IsEnabled = TRUE;
+		pCustom->Combo.HoldTime = 1000;
+		for (ULONGLONG buttonIndex = 0; buttonIndex < _countof(pCustom->Combo.Buttons); buttonIndex++)
+		{
+			pCustom->Combo.Buttons[buttonIndex] = DS_BUTTON_COMBO_MAX_OFFSET + 1;
+		}
+		pCustom->Action = DsButtonComboActionNone;
+
+		if ((pNode = cJSON_GetObjectItem(pEntry, "Action")))
+		{
+			pCustom->Action = DS_BUTTON_COMBO_ACTION_FROM_NAME(cJSON_GetStringValue(pNode));
+			EventWriteOverrideSettingUInt(CombosArray->string, "Action", pCustom->Action);
+		}
+
+		ConfigParseButtonComboSettings(pEntry, &pCustom->Combo);
+
+		Config->CustomButtonCombos.Count++;
+	}
+}
+#pragma warning(pop)
+
+//
+// Parse a single axis or pressure channel response curve
+// 
+#pragma warning(push)
+#pragma warning( disable : 4706 )
+static void
+ConfigParseResponseCurve(
+	_In_ const cJSON* CurveSettings,
+	_Inout_ PDS_RESPONSE_CURVE Curve
+)
+{
+	cJSON* pNode = NULL;
+
+	if ((pNode = cJSON_GetObjectItem(CurveSettings, "Type")))
+	{
+		Curve->Type = DS_RESPONSE_CURVE_TYPE_FROM_NAME(cJSON_GetStringValue(pNode));
+		EventWriteOverrideSettingUInt(CurveSettings->string, "Type", Curve->Type);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(CurveSettings, "Exponent")))
+	{
+		Curve->Exponent = cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingDouble(CurveSettings->string, "Exponent", Curve->Exponent);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(CurveSettings, "OuterDeadZone")))
+	{
+		Curve->OuterDeadZone = cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingDouble(CurveSettings->string, "OuterDeadZone", Curve->OuterDeadZone);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(CurveSettings, "AntiDeadZone")))
+	{
+		Curve->AntiDeadZone = cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingDouble(CurveSettings->string, "AntiDeadZone", Curve->AntiDeadZone);
+	}
+}
+#pragma warning(pop)
+
 //
 // Reads/refreshes configuration from disk (JSON) to provided context
 // 
@@ -462,12 +926,13 @@ static void ConfigNodeParse(
 	const PDS_DRIVER_CONFIGURATION pCfg = &Context->Configuration;
 	cJSON* pNode = NULL;
 
-	if (IsHotReload)
+	if (IsHotReload && Context->ConnectionType == DsDeviceConnectionTypeBth)
 	{
 		//
-		// Reset device's idle disconnect timer
+		// Reset device's idle disconnect timer, next idle report re-arms it
 		//
-		Context->Connection.Bth.IdleDisconnectTimestamp.QuadPart = 0;
+		Context->Connection.Bth.IsIdle = FALSE;
+		WdfTimerStop(Context->Connection.Bth.Timers.IdleDisconnect, FALSE);
 	}
 
 	//
@@ -485,6 +950,16 @@ static void ConfigNodeParse(
 			pCfg->HidDeviceMode = HID_DEVICE_MODE_FROM_NAME(cJSON_GetStringValue(pNode));
 			EventWriteOverrideSettingUInt(ParentNode->string, "HidDeviceMode", pCfg->HidDeviceMode);
 		}
+
+		if ((pNode = cJSON_GetObjectItem(ParentNode, "BluetoothInputPipeline")))
+		{
+			ConfigParseBthInputPipelineSettings(pNode, &pCfg->BthInputPipeline);
+		}
+
+		if ((pNode = cJSON_GetObjectItem(ParentNode, "UsbInputPipeline")))
+		{
+			ConfigParseUsbInputPipelineSettings(pNode, &pCfg->UsbInputPipeline);
+		}
 	}
 
 	if ((pNode = cJSON_GetObjectItem(ParentNode, "DevicePairingMode")))
@@ -532,6 +1007,36 @@ static void ConfigNodeParse(
 		EventWriteOverrideSettingUInt(ParentNode->string, "OutputRateControlPeriodMs", pCfg->OutputRateControlPeriodMs);
 	}
 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "IsOutputRateControlAdaptive")))
+	{
+		pCfg->IsOutputRateControlAdaptive = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(ParentNode->string, "IsOutputRateControlAdaptive", pCfg->IsOutputRateControlAdaptive);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "OutputRateControlMinPeriodMs")))
+	{
+		pCfg->OutputRateControlMinPeriodMs = (USHORT)cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingUInt(ParentNode->string, "OutputRateControlMinPeriodMs", pCfg->OutputRateControlMinPeriodMs);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "OutputRateControlMaxPeriodMs")))
+	{
+		pCfg->OutputRateControlMaxPeriodMs = (USHORT)cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingUInt(ParentNode->string, "OutputRateControlMaxPeriodMs", pCfg->OutputRateControlMaxPeriodMs);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "IsOutputDeduplicatorEnabled")))
+	{
+		pCfg->IsOutputDeduplicatorEnabled = (BOOLEAN)cJSON_IsTrue(pNode);
+		EventWriteOverrideSettingUInt(ParentNode->string, "IsOutputDeduplicatorEnabled", pCfg->IsOutputDeduplicatorEnabled);
+	}
+
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "OutputDeduplicatorRefreshPeriodMs")))
+	{
+		pCfg->OutputDeduplicatorRefreshPeriodMs = (ULONG)cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingUInt(ParentNode->string, "OutputDeduplicatorRefreshPeriodMs", pCfg->OutputDeduplicatorRefreshPeriodMs);
+	}
+
 	if ((pNode = cJSON_GetObjectItem(ParentNode, "WirelessIdleTimeoutPeriodMs")))
 	{
 		pCfg->WirelessIdleTimeoutPeriodMs = (ULONG)cJSON_GetNumberValue(pNode);
@@ -544,6 +1049,12 @@ static void ConfigNodeParse(
 		EventWriteOverrideSettingUInt(ParentNode->string, "DisableWirelessIdleTimeout", pCfg->DisableWirelessIdleTimeout);
 	}
 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "PropertyWriteIntervalMs")))
+	{
+		pCfg->PropertyWriteIntervalMs = (ULONG)cJSON_GetNumberValue(pNode);
+		EventWriteOverrideSettingUInt(ParentNode->string, "PropertyWriteIntervalMs", pCfg->PropertyWriteIntervalMs);
+	}
+
 	//
 	// Wireless quick disconnect combo
 	// 
@@ -552,6 +1063,46 @@ static void ConfigNodeParse(
 		ConfigParseButtonComboSettings(pNode, &pCfg->WirelessDisconnectButtonCombo);
 	}
 
+	//
+	// User-defined button combos
+	// 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "ButtonCombos")) && cJSON_IsArray(pNode))
+	{
+		ConfigParseCustomButtonCombos(pNode, pCfg);
+	}
+
+	//
+	// Input report change detection
+	// 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "InputChangeDetection")))
+	{
+		ConfigParseInputChangeDetectionSettings(pNode, &pCfg->InputChangeDetection);
+	}
+
+	//
+	// Input report backlog
+	// 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "InputReportBacklog")))
+	{
+		ConfigParseInputReportBacklogSettings(pNode, &pCfg->InputReportBacklog);
+	}
+
+	//
+	// Input report rate limit
+	// 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "InputRateLimit")))
+	{
+		ConfigParseInputRateLimitSettings(pNode, &pCfg->InputRateLimit);
+	}
+
+	//
+	// Motion sensor pipeline
+	// 
+	if ((pNode = cJSON_GetObjectItem(ParentNode, "Motion")))
+	{
+		ConfigParseMotionSettings(pNode, &pCfg->Motion);
+	}
+
 	//
 	// Every mode can have the same properties configured independently
 	// 
@@ -657,6 +1208,50 @@ static void ConfigNodeParse(
 					pCfg->FlipAxis.RightY = (BOOLEAN)cJSON_IsTrue(pNode);
 				}
 			}
+
+			//
+			// Axis response curves
+			// 
+			const cJSON* pAxisCurves = cJSON_GetObjectItem(pModeSpecific, "AxisResponseCurves");
+
+			if (pAxisCurves)
+			{
+				if ((pNode = cJSON_GetObjectItem(pAxisCurves, "LeftX")))
+				{
+					ConfigParseResponseCurve(pNode, &pCfg->AxisResponseCurves.LeftX);
+				}
+
+				if ((pNode = cJSON_GetObjectItem(pAxisCurves, "LeftY")))
+				{
+					ConfigParseResponseCurve(pNode, &pCfg->AxisResponseCurves.LeftY);
+				}
+
+				if ((pNode = cJSON_GetObjectItem(pAxisCurves, "RightX")))
+				{
+					ConfigParseResponseCurve(pNode, &pCfg->AxisResponseCurves.RightX);
+				}
+
+				if ((pNode = cJSON_GetObjectItem(pAxisCurves, "RightY")))
+				{
+					ConfigParseResponseCurve(pNode, &pCfg->AxisResponseCurves.RightY);
+				}
+			}
+
+			//
+			// Pressure response curves
+			// 
+			const cJSON* pPressureCurves = cJSON_GetObjectItem(pModeSpecific, "PressureResponseCurves");
+
+			if (pPressureCurves)
+			{
+				for (ULONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+				{
+					if ((pNode = cJSON_GetObjectItem(pPressureCurves, G_DS_PRESSURE_CHANNEL_NAMES[channel])))
+					{
+						ConfigParseResponseCurve(pNode, &pCfg->PressureResponseCurves.Channels[channel]);
+					}
+				}
+			}
 		}
 	}
 
@@ -955,6 +1550,87 @@ ConfigLoadForDevice(
 		Context->RumbleControlState.HeavyRescale.IsAllowed = FALSE;
 	}
 
+	//
+	// Compile the axis response curves, they get folded into the thumb stick tables below
+	//
+	const PDS_AXIS_RESPONSE_CURVES pAxisCurves = &Context->Configuration.AxisResponseCurves;
+	DS_RESPONSE_CURVE_LUT axisCurveTables[4];
+
+	DS3_RESPONSE_CURVE_LUT_BUILD(&axisCurveTables[0], &pAxisCurves->LeftX, TRUE);
+	DS3_RESPONSE_CURVE_LUT_BUILD(&axisCurveTables[1], &pAxisCurves->LeftY, TRUE);
+	DS3_RESPONSE_CURVE_LUT_BUILD(&axisCurveTables[2], &pAxisCurves->RightX, TRUE);
+	DS3_RESPONSE_CURVE_LUT_BUILD(&axisCurveTables[3], &pAxisCurves->RightY, TRUE);
+
+	//
+	// Pre-compute thumb stick flip, dead-zone and response curve transformations
+	// so the input report path is reduced to a single lookup per stick
+	//
+	DS3_THUMB_AXIS_LUT_BUILD(
+		&Context->ThumbLookupTables.Left,
+		&Context->Configuration.ThumbSettings.DeadZoneLeft,
+		Context->Configuration.FlipAxis.LeftX,
+		Context->Configuration.FlipAxis.LeftY,
+		&axisCurveTables[0],
+		&axisCurveTables[1]
+	);
+	DS3_THUMB_AXIS_LUT_BUILD(
+		&Context->ThumbLookupTables.Right,
+		&Context->Configuration.ThumbSettings.DeadZoneRight,
+		Context->Configuration.FlipAxis.RightX,
+		Context->Configuration.FlipAxis.RightY,
+		&axisCurveTables[2],
+		&axisCurveTables[3]
+	);
+
+	//
+	// Compile the pressure response curves, skipped entirely at runtime if all are linear
+	//
+	Context->PressureLookupTables.IsActive = FALSE;
+
+	for (ULONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+	{
+		const PDS_RESPONSE_CURVE_LUT pTable = &Context->PressureLookupTables.Channels[channel];
+
+		DS3_RESPONSE_CURVE_LUT_BUILD(
+			pTable,
+			&Context->Configuration.PressureResponseCurves.Channels[channel],
+			FALSE
+		);
+
+		for (ULONG value = 0; value < ARRAYSIZE(pTable->Entries); value++)
+		{
+			if (pTable->Entries[value] != value)
+			{
+				Context->PressureLookupTables.IsActive = TRUE;
+				break;
+			}
+		}
+	}
+
+	//
+	// Select the input report converters specialized for the current mode settings
+	//
+	DS3_SELECT_HID_INPUT_REPORT_CONVERTERS(
+		&Context->Configuration,
+		(Context->ConnectionType == DsDeviceConnectionTypeUsb) ? TRUE : FALSE,
+		&Context->InputReportConverters.Primary,
+		&Context->InputReportConverters.Secondary
+	);
+	Context->InputReportConverters.ReportLength = DS3_GET_HID_INPUT_REPORT_SIZE(Context->Configuration.HidDeviceMode);
+	Context->InputReportConverters.HasVolatileBits = DS3_GET_HID_INPUT_REPORT_COMPARE_MASK(
+		Context->Configuration.HidDeviceMode,
+		Context->InputReportConverters.CompareMask
+	);
+
+	//
+	// Pre-compile button combinations into masks
+	//
+	DS3_BUTTON_COMBO_ENGINE_BUILD(
+		&Context->ButtonCombos,
+		&Context->Configuration,
+		(Context->ConnectionType == DsDeviceConnectionTypeBth) ? TRUE : FALSE
+	);
+
 	if (config_json)
 	{
 		cJSON_Delete(config_json);
@@ -999,8 +1675,35 @@ ConfigSetDefaults(
 	}
 	Config->IsOutputRateControlEnabled = TRUE;
 	Config->OutputRateControlPeriodMs = 150;
+	Config->IsOutputRateControlAdaptive = FALSE;
+	Config->OutputRateControlMinPeriodMs = 10;
+	Config->OutputRateControlMaxPeriodMs = 250;
+	Config->IsOutputDeduplicatorEnabled = FALSE;
+	Config->OutputDeduplicatorRefreshPeriodMs = 1000;
 	Config->WirelessIdleTimeoutPeriodMs = 300000;
 	Config->DisableWirelessIdleTimeout = FALSE;
+	Config->PropertyWriteIntervalMs = 5000;
+
+	Config->InputChangeDetection.IsEnabled = FALSE;
+	Config->InputChangeDetection.HeartbeatPeriodMs = 100;
+
+	Config->InputReportBacklog.Depth = 4;
+	Config->InputReportBacklog.IsLatestOnly = FALSE;
+
+	Config->InputRateLimit.Policy = DsInputRateLimitPolicyDisabled;
+	Config->InputRateLimit.MinimumIntervalMs = 8;
+
+	Config->BthInputPipeline.RequestCount = 1;
+	Config->BthInputPipeline.BufferCount = 1;
+
+	Config->UsbInputPipeline.RequestCount = 2;
+	Config->UsbInputPipeline.TransferLength = INTERRUPT_IN_BUFFER_LENGTH;
+	Config->UsbInputPipeline.IsValidationEnabled = FALSE;
+
+	Config->Motion.IsCalibrationEnabled = TRUE;
+	Config->Motion.CalibrationWindow = 256;
+	Config->Motion.IsTiltEstimationEnabled = FALSE;
+	Config->Motion.TiltFilterWeight = 230;
 
 	Config->WirelessDisconnectButtonCombo.IsEnabled = TRUE;
 	Config->WirelessDisconnectButtonCombo.HoldTime = 1000;
@@ -1008,11 +1711,40 @@ ConfigSetDefaults(
 	Config->WirelessDisconnectButtonCombo.Buttons[1] = DS3_BUTTON_COMBO_OFFSET_R1;
 	Config->WirelessDisconnectButtonCombo.Buttons[2] = DS3_BUTTON_COMBO_OFFSET_PS;
 
+	Config->CustomButtonCombos.Count = 0;
+
 	Config->ThumbSettings.DeadZoneLeft.Apply = TRUE;
 	Config->ThumbSettings.DeadZoneLeft.PolarValue = 3.0;
 	Config->ThumbSettings.DeadZoneRight.Apply = TRUE;
 	Config->ThumbSettings.DeadZoneRight.PolarValue = 3.0;
 
+	const PDS_RESPONSE_CURVE pAxisCurves[] =
+	{
+		&Config->AxisResponseCurves.LeftX,
+		&Config->AxisResponseCurves.LeftY,
+		&Config->AxisResponseCurves.RightX,
+		&Config->AxisResponseCurves.RightY,
+	};
+
+	for (ULONGLONG axisIndex = 0; axisIndex < _countof(pAxisCurves); axisIndex++)
+	{
+		pAxisCurves[axisIndex]->Type = DsResponseCurveTypeLinear;
+		pAxisCurves[axisIndex]->Exponent = 1.0;
+		pAxisCurves[axisIndex]->OuterDeadZone = 0.0;
+		pAxisCurves[axisIndex]->AntiDeadZone = 0.0;
+	}
+
+	Config->PressureNoiseGate.IsEnabled = FALSE;
+
+	for (ULONGLONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+	{
+		Config->PressureNoiseGate.Thresholds[channel] = 2;
+		Config->PressureResponseCurves.Channels[channel].Type = DsResponseCurveTypeLinear;
+		Config->PressureResponseCurves.Channels[channel].Exponent = 1.0;
+		Config->PressureResponseCurves.Channels[channel].OuterDeadZone = 0.0;
+		Config->PressureResponseCurves.Channels[channel].AntiDeadZone = 0.0;
+	}
+
 	Config->RumbleSettings.DisableLeft = FALSE;
 	Config->RumbleSettings.DisableRight = FALSE;
 	Config->RumbleSettings.HeavyRescaling.IsEnabled = TRUE;
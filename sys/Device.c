@@ -119,6 +119,12 @@ dshidminiEvtDeviceAdd(
 			break;
 		}
 
+		//
+		// Input pipeline dimensions are needed before the modules get opened (which reloads the settings)
+		//   On USB the address isn't known yet, PrepareHardware reloads them for the reader
+		// 
+		(void)ConfigLoadForDevice(pDevCtx, FALSE);
+
 		if (pDevCtx->ConnectionType == DsDeviceConnectionTypeUsb)
 		{
 			//
@@ -237,7 +243,129 @@ void DsHidMini_DeviceCleanup(
 		const PUCHAR pHIDBuffer = (driverContext->IPC.SharedRegions.HID.Buffer + offset);
 
 		// zero out the slot so potential readers get notified we're gone
-		RtlZeroMemory(pHIDBuffer, sizeof(IPC_HID_INPUT_REPORT_MESSAGE));
+		if (driverContext->IPC.SharedRegions.HID.IsMotionAvailable)
+		{
+			const PIPC_HID_MOTION_MESSAGE pMotionBuffer = (PIPC_HID_MOTION_MESSAGE)(driverContext->IPC.SharedRegions.HID.Buffer +
+				DSHM_IPC_HID_MOTION_REGION_OFFSET + (sizeof(IPC_HID_MOTION_MESSAGE) * (deviceContext->SlotIndex - 1)));
+
+			InterlockedIncrement(&pMotionBuffer->Sequence);
+			RtlZeroMemory(pHIDBuffer, sizeof(IPC_HID_INPUT_REPORT_MESSAGE));
+			pMotionBuffer->SlotIndex = 0;
+			RtlZeroMemory(&pMotionBuffer->Motion, sizeof(DS3_MOTION_SAMPLE));
+			InterlockedIncrement(&pMotionBuffer->Sequence);
+		}
+		else
+		{
+			RtlZeroMemory(pHIDBuffer, sizeof(IPC_HID_INPUT_REPORT_MESSAGE));
+		}
+	}
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Input report backlog statistics: dropped %I64u, overwritten %I64u",
+		deviceContext->InputReportBacklog.DroppedCount,
+		deviceContext->InputReportBacklog.OverwrittenCount
+	);
+	EventWriteInputReportBacklogStatistics(
+		deviceContext->DeviceAddressString,
+		deviceContext->InputReportBacklog.DroppedCount,
+		deviceContext->InputReportBacklog.OverwrittenCount
+	);
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Input rate limit statistics: decimated %I64u",
+		deviceContext->InputRateLimit.DecimatedCount
+	);
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Output deduplicator statistics: dropped %I64u, refreshed %I64u",
+		deviceContext->OutputReport.Deduplicator.DroppedCount,
+		deviceContext->OutputReport.Deduplicator.RefreshCount
+	);
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Output shadow statistics: skipped clean merges %I64u",
+		deviceContext->OutputReport.Shadow.SkippedCount
+	);
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Output mailbox statistics: posted %I64u, coalesced %I64u, sent %I64u",
+		deviceContext->OutputReport.Mailbox.PostCount,
+		deviceContext->OutputReport.Mailbox.CoalescedCount,
+		deviceContext->OutputReport.Mailbox.TakeCount
+	);
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Output rate control statistics: period %u us, peak %u us, average completion %u us, sent %I64u, failed %I64u, backoffs %I64u",
+		deviceContext->OutputReport.RateControl.Period,
+		deviceContext->OutputReport.RateControl.PeakPeriod,
+		deviceContext->OutputReport.RateControl.SmoothedCompletion / DS_OUTPUT_RATE_CONTROL_SMOOTHING,
+		deviceContext->OutputReport.RateControl.SendCount,
+		deviceContext->OutputReport.RateControl.FailureCount,
+		deviceContext->OutputReport.RateControl.BackoffCount
+	);
+	EventWriteOutputRateControlStatistics(
+		deviceContext->DeviceAddressString,
+		deviceContext->OutputReport.RateControl.Period,
+		deviceContext->OutputReport.RateControl.PeakPeriod,
+		deviceContext->OutputReport.RateControl.SmoothedCompletion / DS_OUTPUT_RATE_CONTROL_SMOOTHING,
+		deviceContext->OutputReport.RateControl.SendCount,
+		deviceContext->OutputReport.RateControl.FailureCount,
+		deviceContext->OutputReport.RateControl.BackoffCount
+	);
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Output send statistics: completed %I64u, timed out %I64u, last latency %u us, max latency %u us, mean latency %I64u us",
+		deviceContext->OutputReport.InFlight.SendCount,
+		deviceContext->OutputReport.InFlight.TimeoutCount,
+		deviceContext->OutputReport.InFlight.LastLatencyUs,
+		deviceContext->OutputReport.InFlight.MaxLatencyUs,
+		(deviceContext->OutputReport.InFlight.SendCount > 0)
+			? deviceContext->OutputReport.InFlight.TotalLatencyUs / deviceContext->OutputReport.InFlight.SendCount
+			: 0
+	);
+
+	DsDevice_WriteInputIntervalStatistics(deviceContext);
+
+	if (deviceContext->ConnectionType == DsDeviceConnectionTypeBth)
+	{
+		TraceInformation(
+			TRACE_DEVICE,
+			"Bluetooth input pipeline statistics: completed %I64d",
+			deviceContext->Connection.Bth.HidInterrupt.CompletionCount
+		);
+	}
+	else
+	{
+		TraceInformation(
+			TRACE_DEVICE,
+			"USB input pipeline statistics: short transfers %I64u, oversized transfers %I64u",
+			deviceContext->Connection.Usb.InterruptIn.Stats.ShortTransferCount,
+			deviceContext->Connection.Usb.InterruptIn.Stats.OversizedTransferCount
+		);
+
+		//
+		// Report what the reader actually ran with, the configuration may have been reloaded since
+		// 
+		if (deviceContext->Connection.Usb.InterruptIn.IsValidationEnabled)
+		{
+			EventWriteUsbInputPipelineStatistics(
+				deviceContext->DeviceAddressString,
+				deviceContext->Connection.Usb.InterruptIn.RequestCount,
+				deviceContext->Connection.Usb.InterruptIn.TransferLength,
+				deviceContext->InputInterval.Stats.Count,
+				deviceContext->InputInterval.Stats.GapCount,
+				deviceContext->InputInterval.Stats.MissedReports,
+				deviceContext->Connection.Usb.InterruptIn.Stats.ShortTransferCount,
+				deviceContext->Connection.Usb.InterruptIn.Stats.OversizedTransferCount
+			);
+		}
 	}
 
 	EventWriteUnloadEvent(Object);
@@ -432,11 +560,12 @@ DsDevice_InitContext(
 	const PDSHM_DRIVER_CONTEXT pDrvCtx = DriverGetContext(WdfGetDriver());
 	NTSTATUS status = STATUS_INSUFFICIENT_RESOURCES;
 	WDF_OBJECT_ATTRIBUTES attributes;
-	PUCHAR outReportBuffer = NULL;
 	WDF_TIMER_CONFIG timerCfg;
 
 	FuncEntry(TRACE_DEVICE);
 
+	QueryPerformanceFrequency(&pDevCtx->PerformanceFrequency);
+
 	WdfWaitLockAcquire(pDrvCtx->SlotsLock, NULL);
 	{
 		//
@@ -481,79 +610,61 @@ DsDevice_InitContext(
 	case DsDeviceConnectionTypeUsb:
 
 		//
-		// Create managed memory object
+		// Start from the default report
+		// 
+		DS3_INIT_OUTPUT_SHADOW(pDevCtx, G_Ds3UsbHidOutputReport, 1);
+
+		//
+		// Report ID precedes the common layout
 		// 
+		DS_OUTPUT_MAILBOX_INIT(&pDevCtx->OutputReport.Mailbox, 1);
+
+#pragma region ChargingCycle
+
 		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
 		attributes.ParentObject = Device;
 
-		if (!NT_SUCCESS(status = WdfMemoryCreate(
+		WDF_TIMER_CONFIG_INIT_PERIODIC(
+			&timerCfg,
+			DsUsb_EvtChargingCycleTimerFunc,
+			1000
+		);
+
+		if (!NT_SUCCESS(status = WdfTimerCreate(
+			&timerCfg,
 			&attributes,
-			NonPagedPoolNx,
-			DS3_POOL_TAG,
-			DS3_USB_HID_OUTPUT_REPORT_SIZE,
-			&pDevCtx->OutputReportMemory,
-			(PVOID*)&outReportBuffer
+			&pDevCtx->Connection.Usb.ChargingCycleTimer
 		)))
 		{
 			TraceError(
-				TRACE_DEVICE,
-				"WdfMemoryCreate failed with %!STATUS!",
+				TRACE_DSUSB,
+				"WdfTimerCreate (ChargingCycle) failed with status %!STATUS!",
 				status
 			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfMemoryCreate", status);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfTimerCreate (ChargingCycle)", status);
 			break;
 		}
 
-		//
-		// Fill with default report
-		// 
-		RtlCopyMemory(
-			outReportBuffer,
-			G_Ds3UsbHidOutputReport,
-			DS3_USB_HID_OUTPUT_REPORT_SIZE
-		);
+#pragma endregion
 
 		break;
 
 	case DsDeviceConnectionTypeBth:
 
 		//
-		// Create managed memory object
+		// Start from the default report
 		// 
-		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
-		attributes.ParentObject = Device;
-
-		if (!NT_SUCCESS(status = WdfMemoryCreate(
-			&attributes,
-			NonPagedPoolNx,
-			DS3_POOL_TAG,
-			DS3_USB_HID_OUTPUT_REPORT_SIZE,
-			&pDevCtx->OutputReportMemory,
-			(PVOID*)&outReportBuffer
-		)))
-		{
-			TraceError(
-				TRACE_DEVICE,
-				"WdfMemoryCreate failed with %!STATUS!",
-				status
-			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfMemoryCreate", status);
-			break;
-		}
+		DS3_INIT_OUTPUT_SHADOW(pDevCtx, G_Ds3BthHidOutputReport, 2);
 
 		//
-		// Fill with default report
+		// Turn flashing LEDs off
 		// 
-		RtlCopyMemory(
-			outReportBuffer,
-			G_Ds3BthHidOutputReport,
-			DS3_BTH_HID_OUTPUT_REPORT_SIZE
-		);
+		DS3_SET_LED_FLAGS(pDevCtx, DS3_LED_OFF);
 
 		//
-		// Turn flashing LEDs off
+		// Transaction type and report ID precede the common layout
 		// 
-		DS3_BTH_SET_LED(outReportBuffer, DS3_LED_OFF);
+		DS_OUTPUT_MAILBOX_INIT(&pDevCtx->OutputReport.Mailbox, 2);
 
 #pragma region StartupDelay
 
@@ -607,6 +718,54 @@ DsDevice_InitContext(
 			break;
 		}
 
+#pragma endregion
+
+#pragma region IdleDisconnect
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		WDF_TIMER_CONFIG_INIT(
+			&timerCfg,
+			DsBth_EvtIdleDisconnectTimerFunc
+		);
+
+		if (!NT_SUCCESS(status = WdfTimerCreate(
+			&timerCfg,
+			&attributes,
+			&pDevCtx->Connection.Bth.Timers.IdleDisconnect
+		)))
+		{
+			TraceError(
+				TRACE_DSBTH,
+				"WdfTimerCreate (IdleDisconnect) failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfTimerCreate (IdleDisconnect)", status);
+			break;
+		}
+
+#pragma endregion
+
+#pragma region ReadLock
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		if (!NT_SUCCESS(status = WdfWaitLockCreate(
+			&attributes,
+			&pDevCtx->Connection.Bth.HidInterrupt.ReadLock
+		)))
+		{
+			TraceError(
+				TRACE_DSBTH,
+				"WdfWaitLockCreate (ReadLock) failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfWaitLockCreate (ReadLock)", status);
+			break;
+		}
+
 #pragma endregion
 
 		break;
@@ -682,6 +841,44 @@ DsDevice_InitContext(
 			break;
 		}
 
+		//
+		// Create lock
+		// 
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		if (!NT_SUCCESS(status = WdfWaitLockCreate(
+			&attributes,
+			&pDevCtx->InputReportBacklog.Lock
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfWaitLockCreate failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfWaitLockCreate", status);
+			break;
+		}
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		if (!NT_SUCCESS(status = WdfWaitLockCreate(
+			&attributes,
+			&pDevCtx->SixaxisFeature.Lock
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfWaitLockCreate failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfWaitLockCreate", status);
+			break;
+		}
+
 		//
 		// Create timer
 		// 
@@ -709,6 +906,157 @@ DsDevice_InitContext(
 			break;
 		}
 
+		//
+		// Create button combo hold timer and lock
+		// 
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		WDF_TIMER_CONFIG_INIT(
+			&timerCfg,
+			DSHM_EvtButtonComboTimerFunc
+		);
+
+		if (!NT_SUCCESS(status = WdfTimerCreate(
+			&timerCfg,
+			&attributes,
+			&pDevCtx->ButtonCombos.HoldTimer
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfTimerCreate (ButtonCombos) failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfTimerCreate (ButtonCombos)", status);
+			break;
+		}
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		if (!NT_SUCCESS(status = WdfWaitLockCreate(
+			&attributes,
+			&pDevCtx->ButtonCombos.Lock
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfWaitLockCreate failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfWaitLockCreate", status);
+			break;
+		}
+
+		DS3_MOTION_INIT(&pDevCtx->Motion);
+
+		DS_INPUT_INTERVAL_INIT(&pDevCtx->InputInterval.Stats);
+
+#pragma region InputInterval
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		WDF_TIMER_CONFIG_INIT_PERIODIC(
+			&timerCfg,
+			DsDevice_EvtInputIntervalTimerFunc,
+			DSHM_INPUT_INTERVAL_EVENT_PERIOD_MS
+		);
+
+		if (!NT_SUCCESS(status = WdfTimerCreate(
+			&timerCfg,
+			&attributes,
+			&pDevCtx->InputInterval.EventTimer
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfTimerCreate (InputInterval) failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfTimerCreate (InputInterval)", status);
+			break;
+		}
+
+#pragma endregion
+
+#pragma region PropertyWriter
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		WDF_TIMER_CONFIG_INIT(
+			&timerCfg,
+			DsDevice_EvtPropertyWriterTimerFunc
+		);
+
+		if (!NT_SUCCESS(status = WdfTimerCreate(
+			&timerCfg,
+			&attributes,
+			&pDevCtx->PropertyWriter.FlushTimer
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfTimerCreate (PropertyWriter) failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfTimerCreate (PropertyWriter)", status);
+			break;
+		}
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		if (!NT_SUCCESS(status = WdfWaitLockCreate(
+			&attributes,
+			&pDevCtx->PropertyWriter.Lock
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfWaitLockCreate failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfWaitLockCreate", status);
+			break;
+		}
+
+#pragma endregion
+
+#pragma region InputRateLimit
+
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = Device;
+
+		//
+		// UMDF offers no high resolution timers, short intervals get rounded up to the
+		// system timer resolution, which is why due reports bypass the timer entirely
+		// 
+		WDF_TIMER_CONFIG_INIT(
+			&timerCfg,
+			DSHM_EvtInputRateLimitTimerFunc
+		);
+
+		if (!NT_SUCCESS(status = WdfTimerCreate(
+			&timerCfg,
+			&attributes,
+			&pDevCtx->InputRateLimit.ReleaseTimer
+		)))
+		{
+			TraceError(
+				TRACE_DEVICE,
+				"WdfTimerCreate (InputRateLimit) failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfTimerCreate (InputRateLimit)", status);
+			break;
+		}
+
+#pragma endregion
+
 #pragma region IPC
 
 		SECURITY_DESCRIPTOR sd = { 0 };
@@ -1164,6 +1512,315 @@ void DsDevice_InvokeLocalBthDisconnect(PDEVICE_CONTEXT Context)
 	}
 }
 
+#pragma region Property Writer
+
+//
+// Marks a property as dirty and schedules a flush honoring the minimum write interval
+//   Must be called with PropertyWriter.Lock held
+// 
+static VOID
+DsDevice_SchedulePropertyFlush(
+	PDEVICE_CONTEXT Context,
+	DS_DEVICE_PROPERTY_FLAGS Property
+)
+{
+	//
+	// A previously requested value gets superseded before it was written
+	// 
+	if (Context->PropertyWriter.DirtyMask & Property)
+	{
+		InterlockedIncrement64(&Context->PropertyWriter.WritesSuppressed);
+	}
+
+	Context->PropertyWriter.RequestedMask |= Property;
+	Context->PropertyWriter.DirtyMask |= Property;
+
+	if (Context->PropertyWriter.IsFlushPending)
+	{
+		return;
+	}
+
+	const ULONGLONG elapsed = GetTickCount64() - Context->PropertyWriter.LastFlushTime;
+	const ULONG interval = Context->Configuration.PropertyWriteIntervalMs;
+
+	Context->PropertyWriter.IsFlushPending = TRUE;
+
+	WdfTimerStart(
+		Context->PropertyWriter.FlushTimer,
+		WDF_REL_TIMEOUT_IN_MS((elapsed >= interval) ? 1 : (interval - elapsed))
+	);
+}
+
+//
+// Persists a single status property
+// 
+static VOID
+DsDevice_AssignStatusProperty(
+	PDEVICE_CONTEXT Context,
+	const DEVPROPKEY* PropertyKey,
+	DEVPROPTYPE Type,
+	ULONG Size,
+	PVOID Data
+)
+{
+	NTSTATUS status;
+	WDF_DEVICE_PROPERTY_DATA propertyData;
+
+	WDF_DEVICE_PROPERTY_DATA_INIT(&propertyData, PropertyKey);
+	propertyData.Flags |= PLUGPLAY_PROPERTY_PERSISTENT;
+	propertyData.Lcid = LOCALE_NEUTRAL;
+
+	if (!NT_SUCCESS(status = WdfDeviceAssignProperty(
+		WdfObjectContextGetObject(Context),
+		&propertyData,
+		Type,
+		Size,
+		Data
+	)))
+	{
+		TraceError(
+			TRACE_DEVICE,
+			"WdfDeviceAssignProperty failed with status %!STATUS!",
+			status
+		);
+		EventWriteFailedWithNTStatus(__FUNCTION__, L"WdfDeviceAssignProperty", status);
+	}
+
+	InterlockedIncrement64(&Context->PropertyWriter.WritesIssued);
+}
+
+//
+// Requests the battery status property to be updated
+// 
+VOID
+DsDevice_SetDeviceBatteryStatus(
+	PDEVICE_CONTEXT Context,
+	DS_BATTERY_STATUS BatteryStatus
+)
+{
+	//
+	// Called for every input report, don't bother locking if nothing changed. This isn't
+	// a suppressed write either, as no update has been requested
+	// 
+	if ((Context->PropertyWriter.RequestedMask & DsDevicePropertyBatteryStatus)
+		&& Context->PropertyWriter.Requested.BatteryStatus == BatteryStatus)
+	{
+		return;
+	}
+
+	WdfWaitLockAcquire(Context->PropertyWriter.Lock, NULL);
+	{
+		Context->PropertyWriter.Requested.BatteryStatus = BatteryStatus;
+		DsDevice_SchedulePropertyFlush(Context, DsDevicePropertyBatteryStatus);
+	}
+	WdfWaitLockRelease(Context->PropertyWriter.Lock);
+}
+
+//
+// Requests the host radio address property to be updated
+// 
+VOID
+DsDevice_SetHostAddress(
+	PDEVICE_CONTEXT Context,
+	UINT64 HostAddress
+)
+{
+	WdfWaitLockAcquire(Context->PropertyWriter.Lock, NULL);
+	{
+		Context->PropertyWriter.Requested.HostAddress = HostAddress;
+		DsDevice_SchedulePropertyFlush(Context, DsDevicePropertyHostAddress);
+	}
+	WdfWaitLockRelease(Context->PropertyWriter.Lock);
+}
+
+//
+// Requests the last connected time property to be updated to now
+// 
+VOID
+DsDevice_SetLastConnectedTime(
+	PDEVICE_CONTEXT Context
+)
+{
+	WdfWaitLockAcquire(Context->PropertyWriter.Lock, NULL);
+	{
+		GetSystemTimeAsFileTime(&Context->PropertyWriter.Requested.LastConnectedTime);
+		DsDevice_SchedulePropertyFlush(Context, DsDevicePropertyLastConnectedTime);
+	}
+	WdfWaitLockRelease(Context->PropertyWriter.Lock);
+}
+
+//
+// Writes all dirty properties whose value differs from what's already stored
+// 
+VOID
+DsDevice_FlushProperties(
+	PDEVICE_CONTEXT Context
+)
+{
+	FuncEntry(TRACE_DEVICE);
+
+	WdfWaitLockAcquire(Context->PropertyWriter.Lock, NULL);
+	{
+		const PDS_DEVICE_PROPERTY_VALUES pRequested = &Context->PropertyWriter.Requested;
+		const PDS_DEVICE_PROPERTY_VALUES pCommitted = &Context->PropertyWriter.Committed;
+		const ULONG dirty = Context->PropertyWriter.DirtyMask;
+		const ULONG committed = Context->PropertyWriter.CommittedMask;
+
+		if (dirty & DsDevicePropertyBatteryStatus)
+		{
+			if ((committed & DsDevicePropertyBatteryStatus)
+				&& pCommitted->BatteryStatus == pRequested->BatteryStatus)
+			{
+				InterlockedIncrement64(&Context->PropertyWriter.WritesSuppressed);
+			}
+			else
+			{
+				pCommitted->BatteryStatus = pRequested->BatteryStatus;
+
+				DsDevice_AssignStatusProperty(
+					Context,
+					&DEVPKEY_DsHidMini_RO_BatteryStatus,
+					DEVPROP_TYPE_BYTE,
+					sizeof(BYTE),
+					&pCommitted->BatteryStatus
+				);
+			}
+		}
+
+		if (dirty & DsDevicePropertyHostAddress)
+		{
+			if ((committed & DsDevicePropertyHostAddress)
+				&& pCommitted->HostAddress == pRequested->HostAddress)
+			{
+				InterlockedIncrement64(&Context->PropertyWriter.WritesSuppressed);
+			}
+			else
+			{
+				pCommitted->HostAddress = pRequested->HostAddress;
+
+				DsDevice_AssignStatusProperty(
+					Context,
+					&DEVPKEY_BluetoothRadio_Address,
+					DEVPROP_TYPE_UINT64,
+					sizeof(UINT64),
+					&pCommitted->HostAddress
+				);
+			}
+		}
+
+		if (dirty & DsDevicePropertyLastConnectedTime)
+		{
+			if ((committed & DsDevicePropertyLastConnectedTime)
+				&& CompareFileTime(&pCommitted->LastConnectedTime, &pRequested->LastConnectedTime) == 0)
+			{
+				InterlockedIncrement64(&Context->PropertyWriter.WritesSuppressed);
+			}
+			else
+			{
+				pCommitted->LastConnectedTime = pRequested->LastConnectedTime;
+
+				DsDevice_AssignStatusProperty(
+					Context,
+					&DEVPKEY_DsHidMini_RO_LastConnectedTime,
+					DEVPROP_TYPE_FILETIME,
+					sizeof(FILETIME),
+					&pCommitted->LastConnectedTime
+				);
+			}
+		}
+
+		Context->PropertyWriter.CommittedMask |= dirty;
+		Context->PropertyWriter.DirtyMask = 0;
+		Context->PropertyWriter.IsFlushPending = FALSE;
+		Context->PropertyWriter.LastFlushTime = GetTickCount64();
+	}
+	WdfWaitLockRelease(Context->PropertyWriter.Lock);
+
+	TraceVerbose(
+		TRACE_DEVICE,
+		"Property writes issued: %lld, suppressed: %lld",
+		Context->PropertyWriter.WritesIssued,
+		Context->PropertyWriter.WritesSuppressed
+	);
+
+	FuncExitNoReturn(TRACE_DEVICE);
+}
+
+//
+// Flushes coalesced property updates once the write interval has elapsed
+// 
+_Use_decl_annotations_
+VOID
+DsDevice_EvtPropertyWriterTimerFunc(
+	WDFTIMER Timer
+)
+{
+	DsDevice_FlushProperties(DeviceGetContext(WdfTimerGetParentObject(Timer)));
+}
+
+#pragma endregion
+
+//
+// Traces and logs the input report inter-arrival statistics
+// 
+VOID
+DsDevice_WriteInputIntervalStatistics(
+	PDEVICE_CONTEXT Context
+)
+{
+	const PDS_INPUT_INTERVAL_STATS pStats = &Context->InputInterval.Stats;
+	ULONG mean;
+	ULONGLONG variance;
+
+	DS_INPUT_INTERVAL_SUMMARY(pStats, &mean, &variance);
+
+	const ULONG minInterval = (pStats->Count > 0) ? pStats->MinInterval : 0;
+
+	TraceInformation(
+		TRACE_DEVICE,
+		"Input interval statistics: count %I64u, min %u us, max %u us, mean %u us, variance %I64u us^2, gaps %I64u, missed %I64u",
+		pStats->Count,
+		minInterval,
+		pStats->MaxInterval,
+		mean,
+		variance,
+		pStats->GapCount,
+		pStats->MissedReports
+	);
+	EventWriteInputIntervalStatistics(
+		Context->DeviceAddressString,
+		pStats->Count,
+		minInterval,
+		pStats->MaxInterval,
+		mean,
+		variance,
+		pStats->GapCount,
+		pStats->MissedReports
+	);
+}
+
+//
+// Only logs periodically if the link misbehaved since the last event, healthy links stay quiet
+// 
+_Use_decl_annotations_
+VOID
+DsDevice_EvtInputIntervalTimerFunc(
+	WDFTIMER Timer
+)
+{
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(WdfTimerGetParentObject(Timer));
+	const ULONGLONG gapCount = pDevCtx->InputInterval.Stats.GapCount;
+
+	if (gapCount == pDevCtx->InputInterval.LastEventGapCount)
+	{
+		return;
+	}
+
+	pDevCtx->InputInterval.LastEventGapCount = gapCount;
+
+	DsDevice_WriteInputIntervalStatistics(pDevCtx);
+}
+
 //
 // Bootstrap required DMF modules
 // 
@@ -1176,7 +1833,7 @@ DmfDeviceModulesAdd(
 )
 {
 	DMF_MODULE_ATTRIBUTES moduleAttributes;
-	DMF_CONFIG_ThreadedBufferQueue dmfBufferCfg;
+	DMF_CONFIG_Thread dmfThreadCfg;
 	DMF_CONFIG_DefaultTarget bthReaderCfg;
 	DMF_CONFIG_DefaultTarget bthWriterCfg;
 
@@ -1187,27 +1844,17 @@ DmfDeviceModulesAdd(
 	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(Device);
 
 	//
-	// Threaded buffer queue used to serialize output report packets
+	// Worker thread sending the latest mailbox content, replaces instead of queueing
 	// 
 
-	DMF_CONFIG_ThreadedBufferQueue_AND_ATTRIBUTES_INIT(
-		&dmfBufferCfg,
+	DMF_CONFIG_Thread_AND_ATTRIBUTES_INIT(
+		&dmfThreadCfg,
 		&moduleAttributes
 	);
 	moduleAttributes.PassiveLevel = TRUE;
 
-	dmfBufferCfg.EvtThreadedBufferQueueWork = DSHM_EvtExecuteOutputPacketReceived;
-	// Fixed amount of buffers, no auto-grow
-	dmfBufferCfg.BufferQueueConfig.SourceSettings.EnableLookAside = FALSE;
-	/*
-	 * TODO: tune to find good value
-	 * - too low: packets might get dropped unintentionally
-	 * - too high: user-noticeable delay may build up
-	 */
-	dmfBufferCfg.BufferQueueConfig.SourceSettings.BufferCount = 10;
-	dmfBufferCfg.BufferQueueConfig.SourceSettings.BufferSize = DS3_BTH_HID_OUTPUT_REPORT_SIZE;
-	dmfBufferCfg.BufferQueueConfig.SourceSettings.BufferContextSize = sizeof(DS_OUTPUT_REPORT_CONTEXT);
-	dmfBufferCfg.BufferQueueConfig.SourceSettings.PoolType = NonPagedPoolNx;
+	dmfThreadCfg.ThreadControlType = ThreadControlType_DmfControl;
+	dmfThreadCfg.ThreadControl.DmfControl.EvtThreadWork = DSHM_EvtOutputReportWork;
 
 	DMF_DmfModuleAdd(
 		DmfModuleInit,
@@ -1221,6 +1868,17 @@ DmfDeviceModulesAdd(
 	// 
 	if (pDevCtx->ConnectionType == DsDeviceConnectionTypeBth)
 	{
+		const PDS_BTH_INPUT_PIPELINE_SETTINGS pPipeline = &pDevCtx->Configuration.BthInputPipeline;
+
+		pDevCtx->Connection.Bth.HidInterrupt.RequestCount = pPipeline->RequestCount;
+
+		TraceVerbose(
+			TRACE_DEVICE,
+			"Bluetooth input pipeline: %d request(s), %d buffer(s)",
+			pPipeline->RequestCount,
+			max(pPipeline->BufferCount, pPipeline->RequestCount)
+		);
+
 		//
 		// Default I/O target request streamer for input reports
 		// 
@@ -1231,9 +1889,9 @@ DmfDeviceModulesAdd(
 		);
 		moduleAttributes.PassiveLevel = TRUE;
 
-		bthReaderCfg.ContinuousRequestTargetModuleConfig.BufferCountOutput = 1;
+		bthReaderCfg.ContinuousRequestTargetModuleConfig.BufferCountOutput = max(pPipeline->BufferCount, pPipeline->RequestCount);
 		bthReaderCfg.ContinuousRequestTargetModuleConfig.BufferOutputSize = BTHPS3_SIXAXIS_HID_INPUT_REPORT_SIZE;
-		bthReaderCfg.ContinuousRequestTargetModuleConfig.ContinuousRequestCount = 1;
+		bthReaderCfg.ContinuousRequestTargetModuleConfig.ContinuousRequestCount = pPipeline->RequestCount;
 		bthReaderCfg.ContinuousRequestTargetModuleConfig.PoolTypeOutput = NonPagedPoolNx;
 		bthReaderCfg.ContinuousRequestTargetModuleConfig.PurgeAndStartTargetInD0Callbacks = FALSE;
 		bthReaderCfg.ContinuousRequestTargetModuleConfig.ContinuousRequestTargetIoctl = IOCTL_BTHPS3_HID_INTERRUPT_READ;
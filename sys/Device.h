@@ -9,6 +9,11 @@ EXTERN_C_START
 #define DSHM_HID_EVENT_NAME_RND_LEN		16
 #define DSHM_HID_EVENT_NAME_LEN			(sizeof(DSHM_HID_EVENT_NAME_PREFIX) + DSHM_HID_EVENT_NAME_RND_LEN)
 
+//
+// Period of the input interval statistics events while new gaps keep occurring
+// 
+#define DSHM_INPUT_INTERVAL_EVENT_PERIOD_MS	(60 * 1000)
+
 struct USB_DEVICE_CONTEXT
 {
 	//
@@ -42,9 +47,39 @@ struct USB_DEVICE_CONTEXT
 	WDFUSBPIPE InterruptOutPipe;
 	
 	//
-	// Timestamp to calculate charging cycle state change
+	// Periodic timer cycling the LEDs while charging
+	// 
+	WDFTIMER ChargingCycleTimer;
+
+	//
+	// TRUE while the charging cycle timer is running
 	// 
-	LARGE_INTEGER ChargingCycleTimestamp;
+	BOOLEAN IsChargingCycleActive;
+
+	struct
+	{
+		//
+		// Short and oversized transfer counters
+		// 
+		DS_USB_INPUT_PIPELINE_STATS Stats;
+
+		//
+		// Reader dimensions the continuous reader got configured with
+		// 
+		UCHAR RequestCount;
+		USHORT TransferLength;
+
+		//
+		// Validation mode the continuous reader got configured with
+		// 
+		BOOLEAN IsValidationEnabled;
+
+		//
+		// Gap count already reported by the validation mode
+		// 
+		ULONGLONG ValidatedGapCount;
+
+	} InterruptIn;
 };
 
 struct BTH_DEVICE_CONTEXT
@@ -62,6 +97,21 @@ struct BTH_DEVICE_CONTEXT
 		DMFMODULE InputStreamerModule;
 
 		WDFIOTARGET InputStreamerIoTarget;
+
+		//
+		// Amount of reads kept pending, fixed once the streamer module got created
+		// 
+		UCHAR RequestCount;
+
+		//
+		// Serializes completions if more than one read is pending
+		// 
+		WDFWAITLOCK ReadLock;
+
+		//
+		// Successful read completions
+		// 
+		volatile LONG64 CompletionCount;
 		
 	} HidInterrupt;
 
@@ -77,13 +127,13 @@ struct BTH_DEVICE_CONTEXT
 		// 
 		WDFTIMER PostStartupTasks;
 
+		//
+		// Idle disconnect timer, armed while the device reports no activity
+		// 
+		WDFTIMER IdleDisconnect;
+
 	} Timers;
 	
-	//
-	// Timestamp to calculate quick disconnect combo detection
-	// 
-	LARGE_INTEGER QuickDisconnectTimestamp;
-
 	//
 	// Event to listen for to disconnect
 	//
@@ -95,9 +145,9 @@ struct BTH_DEVICE_CONTEXT
 	HANDLE DisconnectWaitHandle;
 
 	//
-	// Timestamp to calculate idle disconnect
+	// TRUE while the last received input report reported no activity
 	// 
-	LARGE_INTEGER IdleDisconnectTimestamp;
+	BOOLEAN IsIdle;
 };
 
 #ifdef DSHM_FEATURE_FFB
@@ -115,74 +165,124 @@ typedef struct _FFB_ATTRIBUTES
 #endif
 
 /**
- * Output report context.
+ * Cached output report values to help with rate-control.
  *
  * @author	Benjamin "Nefarius" Hglinger-Stelzer
- * @date	01.04.2021
+ * @date	12.03.2021
  */
-typedef struct _DS_OUTPUT_REPORT_CONTEXT
+typedef struct _DS_OUTPUT_REPORT_CACHE
 {
 	//
-	// Time of packet arrival
+	// Timestamp of last successful send
+	// 
+	LARGE_INTEGER LastSentTimestamp;
+
+	//
+	// Send delay timer
 	// 
-	LARGE_INTEGER ReceivedTimestamp;
+	WDFTIMER SendDelayTimer;
 
 	//
-	// Actual size of buffer
+	// Lock protecting cache field access
 	// 
-	size_t BufferSize;
+	WDFWAITLOCK Lock;
 
 	//
-	// The initiator of this report
+	// TRUE if the timer is currently scheduled to get executed
+	// 
+	BOOLEAN IsScheduled;
+	
+	//
+	// TODO: replace with WDFMEMORY object
 	// 
-	DS_OUTPUT_REPORT_SOURCE ReportSource;
+	UCHAR LastReport[0x32]; // Introduce const
 	
-} DS_OUTPUT_REPORT_CONTEXT, *PDS_OUTPUT_REPORT_CONTEXT;
+} DS_OUTPUT_REPORT_CACHE, *PDS_OUTPUT_REPORT_CACHE;
+
+//
+// Output report length excluding the transport-specific header (same on USB and Bluetooth)
+// 
+#define DS3_OUTPUT_REPORT_BODY_SIZE		0x30
+
+//
+// Independently tracked fields of the output shadow state
+// 
+typedef enum
+{
+	DsOutputShadowFieldRumble = 1 << 0,
+	DsOutputShadowFieldLedFlags = 1 << 1,
+	DsOutputShadowFieldLed1 = 1 << 2,
+	DsOutputShadowFieldLed2 = 1 << 3,
+	DsOutputShadowFieldLed3 = 1 << 4,
+	DsOutputShadowFieldLed4 = 1 << 5,
+	DsOutputShadowFieldControl = 1 << 6
+} DS_OUTPUT_SHADOW_FIELDS;
+
+#define DS_OUTPUT_SHADOW_FIELD_LED(_index_)	(DsOutputShadowFieldLed1 << (_index_))
+#define DS_OUTPUT_SHADOW_FIELDS_LED			(DsOutputShadowFieldLedFlags | DsOutputShadowFieldLed1 | \
+											DsOutputShadowFieldLed2 | DsOutputShadowFieldLed3 | DsOutputShadowFieldLed4)
 
 /**
- * Cached output report values to help with rate-control.
- *
- * @author	Benjamin "Nefarius" Hglinger-Stelzer
- * @date	12.03.2021
+ * Typed output report state, the wire report gets built from it on send.
  */
-typedef struct _DS_OUTPUT_REPORT_CACHE
+typedef struct _DS_OUTPUT_SHADOW
 {
 	//
-	// Timestamp of last successful send
+	// Rumble values as they go on the wire (rescaling already applied)
 	// 
-	LARGE_INTEGER LastSentTimestamp;
+	UCHAR SmallRumbleDuration;
+	UCHAR SmallRumbleStrength;
+	UCHAR LargeRumbleDuration;
+	UCHAR LargeRumbleStrength;
 
 	//
-	// Send delay timer
+	// Player LED enable flags
 	// 
-	WDFTIMER SendDelayTimer;
+	UCHAR LedFlags;
 
 	//
-	// Pending packet buffer to send
+	// Blink pattern per player LED (index 0 is player 1)
 	// 
-	PVOID PendingClientBuffer;
+	DS_LED Leds[4];
 
 	//
-	// Pending packet buffer context
+	// Report body in common layout, only bytes not covered by a typed field are used
 	// 
-	PDS_OUTPUT_REPORT_CONTEXT PendingClientBufferContext;
+	UCHAR Control[DS3_OUTPUT_REPORT_BODY_SIZE];
 
 	//
-	// Lock protecting cache field access
+	// Fields changed since the last build, DS_OUTPUT_SHADOW_FIELDS
+	//   Setters run without the output report lock so this is only ever
+	//   modified with interlocked operations
 	// 
-	WDFWAITLOCK Lock;
+	volatile LONG DirtyFields;
 
 	//
-	// TRUE if the timer is currently scheduled to get executed
+	// Fields the back buffer is missing since it last was the front buffer
 	// 
-	BOOLEAN IsScheduled;
-	
+	ULONG BackDirtyFields;
+
 	//
-	// TODO: replace with WDFMEMORY object
+	// Front and back wire report, the front one is what got built last
 	// 
-	UCHAR LastReport[0x32]; // Introduce const
-	
-} DS_OUTPUT_REPORT_CACHE, *PDS_OUTPUT_REPORT_CACHE;
+	UCHAR Reports[2][DS_OUTPUT_MAILBOX_REPORT_SIZE];
+
+	//
+	// Index of the front buffer in Reports
+	// 
+	ULONG FrontIndex;
+
+	//
+	// Transport-specific bytes preceding the body (1 on USB, 2 on Bluetooth)
+	// 
+	ULONG HeaderLength;
+
+	//
+	// Mailbox merges skipped for nothing having changed since the last one
+	// 
+	ULONG64 SkippedCount;
+
+} DS_OUTPUT_SHADOW, * PDS_OUTPUT_SHADOW;
 
 //
 // Stores the constants used for rumble rescaling and if it is allowed
@@ -197,6 +297,29 @@ typedef struct _DS_RESCALE_STATE
 
 } DS_RESCALE_STATE, * PDS_RESCALE_STATE;
 
+//
+// Device properties handled by the deferred property writer
+// 
+typedef enum
+{
+	DsDevicePropertyBatteryStatus = 1 << 0,
+	DsDevicePropertyHostAddress = 1 << 1,
+	DsDevicePropertyLastConnectedTime = 1 << 2
+} DS_DEVICE_PROPERTY_FLAGS;
+
+//
+// Values of the properties handled by the deferred property writer
+// 
+typedef struct _DS_DEVICE_PROPERTY_VALUES
+{
+	DS_BATTERY_STATUS BatteryStatus;
+
+	UINT64 HostAddress;
+
+	FILETIME LastConnectedTime;
+
+} DS_DEVICE_PROPERTY_VALUES, * PDS_DEVICE_PROPERTY_VALUES;
+
 typedef struct _DEVICE_CONTEXT
 {
 	//
@@ -207,15 +330,27 @@ typedef struct _DEVICE_CONTEXT
 	struct
 	{
 		//
-		// Threaded buffer queue worker
+		// Thread sending whatever the mailbox holds
 		// 
 		DMFMODULE Worker;
 
 		//
-		// Lock protecting output report buffer access
+		// Lock protecting output report buffer and mailbox access
 		// 
 		WDFWAITLOCK Lock;
 
+		//
+		// Typed output state the wire report gets built from
+		//   Setters update fields and the dirty mask without Lock, building the
+		//   wire report and buffer swapping happen with Lock held
+		// 
+		DS_OUTPUT_SHADOW Shadow;
+
+		//
+		// Latest-wins report state handed to the worker, protected by Lock
+		// 
+		DS_OUTPUT_MAILBOX Mailbox;
+
 		//
 		// Output report mode of operation
 		// 
@@ -225,6 +360,81 @@ typedef struct _DEVICE_CONTEXT
 		// Cached output report meta-data
 		// 
 		DS_OUTPUT_REPORT_CACHE Cache;
+
+		//
+		// Adaptive send period, only accessed by the worker and the send completion
+		// 
+		DS_OUTPUT_RATE_CONTROL RateControl;
+
+		//
+		// The one report currently handed to the device
+		// 
+		struct
+		{
+			//
+			// TRUE while a send is outstanding, protected by Lock
+			// 
+			BOOLEAN IsPending;
+
+			//
+			// Report being sent
+			// 
+			UCHAR Buffer[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+
+			//
+			// Valid bytes in Buffer
+			// 
+			ULONG Length;
+
+			//
+			// Time the send got started
+			// 
+			LARGE_INTEGER SendTimestamp;
+
+			//
+			// Number of completed sends
+			// 
+			ULONG64 SendCount;
+
+			//
+			// Sends that didn't complete within DSHM_OUTPUT_REPORT_SEND_TIMEOUT_MS
+			// 
+			ULONG64 TimeoutCount;
+
+			//
+			// Send to completion latency of the last and the slowest send in microseconds
+			// 
+			ULONG LastLatencyUs;
+			ULONG MaxLatencyUs;
+
+			//
+			// Sum of all send latencies in microseconds
+			// 
+			ULONG64 TotalLatencyUs;
+
+		} InFlight;
+
+		//
+		// Output report deduplicator state, protected by Lock
+		// 
+		struct
+		{
+			//
+			// Time the last report got posted to the mailbox
+			// 
+			LARGE_INTEGER LastPostedTimestamp;
+
+			//
+			// Reports dropped for being identical to the mailbox content
+			// 
+			ULONG64 DroppedCount;
+
+			//
+			// Identical reports let through to refresh the device state
+			// 
+			ULONG64 RefreshCount;
+
+		} Deduplicator;
 		
 	} OutputReport;
 	
@@ -287,11 +497,6 @@ typedef struct _DEVICE_CONTEXT
 	// 
 	USHORT VersionNumber;
 
-	//
-	// Output report buffer
-	// 
-	WDFMEMORY OutputReportMemory;
-
 	//
 	// Registry-stored driver configuration
 	// 
@@ -341,16 +546,6 @@ typedef struct _DEVICE_CONTEXT
 			//
 			DS_RESCALE_STATE LightRescale;
 
-			//
-			// Allows toggling to occur if the button combo conditions are satisfied
-			//
-			BOOLEAN IsToggleAllowed;
-
-			//
-			// Timestamp to calculate alt mode toggle combo detection
-			//
-			LARGE_INTEGER QuickToggleTimestamp;
-
 		} AltMode;
 
 		//
@@ -360,6 +555,248 @@ typedef struct _DEVICE_CONTEXT
 
 	} RumbleControlState;
 
+	//
+	// Thumb stick transformations, rebuilt on every configuration (re-)load
+	//
+	DS_THUMB_LOOKUP_TABLES ThumbLookupTables;
+
+	//
+	// Pressure sensitive button response curves, rebuilt on every configuration (re-)load
+	//
+	DS_PRESSURE_LOOKUP_TABLES PressureLookupTables;
+
+	//
+	// Button combinations, rebuilt on every configuration (re-)load
+	//
+	DS_BUTTON_COMBO_ENGINE ButtonCombos;
+
+	//
+	// Last pressure values let through the noise gate
+	//
+	UCHAR PressureNoiseGateValues[DS_PRESSURE_CHANNEL_COUNT];
+
+	//
+	// Motion sensor calibration and tilt estimation state
+	//
+	DS3_MOTION_STATE Motion;
+
+	//
+	// Input report converters matching the current configuration
+	// 
+	struct
+	{
+		//
+		// Converts the main input report
+		// 
+		PFN_DS3_RAW_TO_HID_INPUT_REPORT Primary;
+
+		//
+		// Converts an optional additional input report, NULL if not required
+		// 
+		PFN_DS3_RAW_TO_HID_INPUT_REPORT Secondary;
+
+		//
+		// Size of the reports produced in the current mode
+		// 
+		ULONG ReportLength;
+
+		//
+		// Bits taking part in the change check, cleared for counters and timestamps
+		// 
+		UCHAR CompareMask[DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE];
+
+		//
+		// TRUE if CompareMask excludes anything, otherwise a plain compare is sufficient
+		// 
+		BOOLEAN HasVolatileBits;
+	} InputReportConverters;
+
+	//
+	// Transformed input reports waiting for a pending HID read
+	// 
+	struct
+	{
+		//
+		// Ring buffer of reports, oldest at Head
+		// 
+		UCHAR Reports[DS_INPUT_REPORT_BACKLOG_MAX_DEPTH][DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE];
+
+		//
+		// Index of the oldest buffered report
+		// 
+		ULONG Head;
+
+		//
+		// Amount of buffered reports
+		// 
+		ULONG Count;
+
+		//
+		// Protects the ring buffer
+		// 
+		WDFWAITLOCK Lock;
+
+		//
+		// Reports lost because no read was pending and buffering is disabled
+		// 
+		ULONG64 DroppedCount;
+
+		//
+		// Buffered reports discarded in favour of newer ones
+		// 
+		ULONG64 OverwrittenCount;
+	} InputReportBacklog;
+
+	//
+	// Input reports held back by the rate limit, protected by the backlog lock
+	// 
+	struct
+	{
+		//
+		// Newest held back primary and secondary report
+		// 
+		UCHAR Reports[2][DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE];
+
+		//
+		// TRUE if the corresponding report awaits release
+		// 
+		BOOLEAN IsPending[2];
+
+		//
+		// TRUE while the release timer is armed
+		// 
+		BOOLEAN IsReleaseScheduled;
+
+		//
+		// Releases held back reports in "latest wins" mode
+		// 
+		WDFTIMER ReleaseTimer;
+
+		//
+		// QPC timestamp of the last timer release
+		// 
+		LARGE_INTEGER LastReleaseTime;
+
+		//
+		// Reports not delivered because a newer one superseded them within the interval
+		// 
+		ULONG64 DecimatedCount;
+	} InputRateLimit;
+
+	//
+	// SIXAXIS.SYS GET_FEATURE report, only materialized when requested
+	// 
+	struct
+	{
+		//
+		// Latest raw input report as received from the device
+		// 
+		DS3_RAW_INPUT_REPORT LatestReport;
+
+		//
+		// Incremented before and after LatestReport gets updated (odd while in progress)
+		// 
+		volatile LONG Sequence;
+
+		//
+		// LatestReport converted to the GET_FEATURE layout
+		// 
+		DS3_RAW_INPUT_REPORT FeatureReport;
+
+		//
+		// Sequence FeatureReport got built from
+		// 
+		LONG FeatureSequence;
+
+		//
+		// Serializes GET_FEATURE requests
+		// 
+		WDFWAITLOCK Lock;
+	} SixaxisFeature;
+
+	//
+	// Coalesces status property updates into at most one store write per interval
+	// 
+	struct
+	{
+		//
+		// Fires once the minimum interval since the last flush has elapsed
+		// 
+		WDFTIMER FlushTimer;
+
+		//
+		// Protects the fields below and serializes flushes
+		// 
+		WDFWAITLOCK Lock;
+
+		//
+		// DS_DEVICE_PROPERTY_FLAGS ever requested, awaiting a flush and already written
+		// 
+		ULONG RequestedMask;
+		ULONG DirtyMask;
+		ULONG CommittedMask;
+
+		//
+		// TRUE while FlushTimer is scheduled
+		// 
+		BOOLEAN IsFlushPending;
+
+		//
+		// Tick count of the last flush
+		// 
+		ULONGLONG LastFlushTime;
+
+		//
+		// Most recently requested values
+		// 
+		DS_DEVICE_PROPERTY_VALUES Requested;
+
+		//
+		// Values currently in the property store
+		// 
+		DS_DEVICE_PROPERTY_VALUES Committed;
+
+		//
+		// Property store writes issued
+		// 
+		volatile LONG64 WritesIssued;
+
+		//
+		// Updates that didn't cause a write (unchanged or superseded before the flush)
+		// 
+		volatile LONG64 WritesSuppressed;
+	} PropertyWriter;
+
+	//
+	// Input report inter-arrival statistics, logged periodically and on device cleanup
+	// 
+	struct
+	{
+		DS_INPUT_INTERVAL_STATS Stats;
+
+		//
+		// Periodically logs the statistics if new gaps occurred since the last event
+		// 
+		WDFTIMER EventTimer;
+
+		//
+		// Gap count at the time of the last periodic event
+		// 
+		ULONGLONG LastEventGapCount;
+	} InputInterval;
+
+#ifdef DSHM_FEATURE_INPUT_LATENCY
+	//
+	// Time spent between interrupt IN completion and the individual processing stages
+	// 
+	DS_INPUT_LATENCY_STATS InputLatency;
+#endif
+
+	//
+	// QPC frequency, fixed at system boot so it's only queried once
+	// 
+	LARGE_INTEGER PerformanceFrequency;
+
 	UINT32 SlotIndex;
 
 	struct
@@ -389,6 +826,38 @@ typedef struct _IPC_HID_INPUT_REPORT_MESSAGE
 } IPC_HID_INPUT_REPORT_MESSAGE, *PIPC_HID_INPUT_REPORT_MESSAGE;
 #include <poppack.h>
 
+//
+// Offset of the motion messages within the HID region
+//   Located behind all input report slots so the slot layout existing clients
+//   rely on stays untouched. Whether the messages fit the HID region depends on
+//   the allocation granularity and is checked on IPC initialization
+// 
+#define DSHM_IPC_HID_MOTION_REGION_OFFSET	0x8000
+
+C_ASSERT(sizeof(IPC_HID_INPUT_REPORT_MESSAGE) * DSHM_MAX_DEVICES <= DSHM_IPC_HID_MOTION_REGION_OFFSET);
+
+//
+// Describes the calibrated motion values shared via IPC
+// 
+typedef struct _IPC_HID_MOTION_MESSAGE
+{
+	//
+	// One-based device index
+	// 
+	UINT32 SlotIndex;
+
+	//
+	// Odd while the input report and motion slots of this device get updated,
+	// readers retry if it changed while copying
+	// 
+	volatile LONG Sequence;
+
+	//
+	// Calibrated motion values of the input report
+	// 
+	DS3_MOTION_SAMPLE Motion;
+} IPC_HID_MOTION_MESSAGE, *PIPC_HID_MOTION_MESSAGE;
+
 //
 // This macro will generate an inline function called DeviceGetContext
 // which will be used to get a pointer to the device context memory
@@ -398,6 +867,27 @@ WDF_DECLARE_CONTEXT_TYPE_WITH_NAME(DEVICE_CONTEXT, DeviceGetContext)
 
 DECLARE_DMF_MODULE_NO_CONFIG(DsHidMini)
 
+//
+// Last input report delivered to the HID class (per report type)
+// 
+typedef struct _DS_SUBMITTED_INPUT_REPORT
+{
+	//
+	// Copy of the delivered report
+	// 
+	UCHAR Report[DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE];
+
+	//
+	// When the report got delivered
+	// 
+	LARGE_INTEGER Timestamp;
+
+	//
+	// TRUE if Report holds a delivered report
+	// 
+	BOOLEAN IsValid;
+} DS_SUBMITTED_INPUT_REPORT, * PDS_SUBMITTED_INPUT_REPORT;
+
 typedef struct
 {
 	// 
@@ -411,9 +901,19 @@ typedef struct
 	UCHAR InputReport[DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE];
 
 	//
-	// Raw input report for SIXAXIS.SYS GET_FEATURE report
+	// Last delivered primary and secondary input reports (change detection)
+	// 
+	DS_SUBMITTED_INPUT_REPORT LastSubmittedReports[2];
+
+	//
+	// Sequence number of the last delivered raw passthrough report
 	// 
-	DS3_RAW_INPUT_REPORT GetFeatureReport;
+	ULONG RawReportSequence;
+
+	//
+	// DS4 frame counter of the last delivered report (6 bits, wraps at 64)
+	// 
+	UCHAR Ds4FrameCounter;
 
 #ifdef DSHM_FEATURE_FFB
 	//
@@ -440,10 +940,22 @@ DMF_DsHidMini_ChildModulesAdd(
 
 DMF_Open DMF_DsHidMini_Open;
 
-EVT_DMF_ThreadedBufferQueue_Callback DSHM_EvtExecuteOutputPacketReceived;
+EVT_DMF_Thread_Function DSHM_EvtOutputReportWork;
+
+EVT_WDF_REQUEST_COMPLETION_ROUTINE DSHM_EvtOutputReportUsbWriteCompleted;
+
+EVT_DMF_ContinuousRequestTarget_SendCompletion DSHM_EvtOutputReportBthWriteCompleted;
 
 EVT_WDF_TIMER DSHM_OutputReportDelayTimerElapsed;
 
+EVT_WDF_TIMER DSHM_EvtButtonComboTimerFunc;
+
+EVT_WDF_TIMER DsDevice_EvtPropertyWriterTimerFunc;
+
+EVT_WDF_TIMER DSHM_EvtInputRateLimitTimerFunc;
+
+EVT_WDF_TIMER DsDevice_EvtInputIntervalTimerFunc;
+
 EVT_WDF_IO_QUEUE_IO_DEVICE_CONTROL DSHM_EvtWdfIoQueueIoDeviceControl;
 
 EVT_DSHM_IPC_DispatchDeviceMessage DSHM_EvtDispatchDeviceMessage;
@@ -485,4 +997,31 @@ DsDevice_InvokeLocalBthDisconnect(
 	PDEVICE_CONTEXT Context
 );
 
+VOID
+DsDevice_SetDeviceBatteryStatus(
+	PDEVICE_CONTEXT Context,
+	DS_BATTERY_STATUS BatteryStatus
+);
+
+VOID
+DsDevice_SetHostAddress(
+	PDEVICE_CONTEXT Context,
+	UINT64 HostAddress
+);
+
+VOID
+DsDevice_SetLastConnectedTime(
+	PDEVICE_CONTEXT Context
+);
+
+VOID
+DsDevice_FlushProperties(
+	PDEVICE_CONTEXT Context
+);
+
+VOID
+DsDevice_WriteInputIntervalStatistics(
+	PDEVICE_CONTEXT Context
+);
+
 EXTERN_C_END
@@ -5,6 +5,9 @@
 /* Enable Force Feedback features */
 #define DSHM_FEATURE_FFB
 
+/* Enable per-stage input latency histograms */
+#define DSHM_FEATURE_INPUT_LATENCY
+
 #include <Windows.h>
 #include <devpkey.h>
 #include <wdf.h>
@@ -17,7 +20,14 @@
 
 #include <DmfModules.Library.h>
 #include <DsHidMini/Ds3Types.h>
+#include <DsHidMini/Ds3Shared.h>
 #include <DsHidMini/ScpTypes.h>
+#include "Ds3.Motion.h"
+#include "InputLatency.h"
+#include "InputInterval.h"
+#include "OutputMailbox.h"
+#include "OutputRateControl.h"
+#include "UsbInputPipeline.h"
 #include "DsCommon.h"
 #include "DsHid.h"
 #ifdef DSHM_FEATURE_FFB
@@ -123,6 +133,11 @@ typedef struct _DSHM_DRIVER_CONTEXT
 				// Total size of shared memory region
 				// 
 				size_t BufferSize;
+
+				//
+				// TRUE if the motion messages behind the input report slots fit into the region
+				// 
+				BOOLEAN IsMotionAvailable;
 			} HID;
 		} SharedRegions;
 
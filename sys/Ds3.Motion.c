@@ -0,0 +1,220 @@
+#include "DsPortable.h"
+#include <DsHidMini/Ds3Types.h>
+#include "Ds3.Motion.h"
+
+
+//
+// Reads a big-endian 10-bit motion field
+//
+#define DS3_MOTION_RAW(_field_)	((LONG)(_byteswap_ushort(_field_) & 0x3FF))
+
+static FORCEINLINE LONG DS3_MOTION_CLAMP_SHORT(LONG Value)
+{
+	return (Value > 0x7FFF) ? 0x7FFF : (Value < -0x8000) ? -0x8000 : Value;
+}
+
+static FORCEINLINE LONG DS3_MOTION_ABS(LONG Value)
+{
+	return (Value < 0) ? -Value : Value;
+}
+
+//
+// Integer atan2 in 1/100 degrees (-18000 to 18000), max. error ~0.3 degrees
+//   atan(z) ~= 45z + 15.64z(1 - z) for z in [0, 1], z in Q15
+//
+static LONG DS3_MOTION_ATAN2(LONG Y, LONG X)
+{
+	const LONG ax = DS3_MOTION_ABS(X);
+	const LONG ay = DS3_MOTION_ABS(Y);
+
+	if (ax == 0 && ay == 0)
+	{
+		return 0;
+	}
+
+	const LONG z = (ax >= ay) ? ((ay << 15) / ax) : ((ax << 15) / ay);
+	LONG angle = ((4500 * z) + (((1564 * z) >> 15) * (32768 - z))) >> 15;
+
+	if (ay > ax)
+	{
+		angle = 9000 - angle;
+	}
+
+	if (X < 0)
+	{
+		angle = 18000 - angle;
+	}
+
+	return (Y < 0) ? -angle : angle;
+}
+
+//
+// Moves Current towards Target (both in 1/100 degrees) taking the shorter way around
+//
+static LONG DS3_MOTION_SMOOTH_ANGLE(LONG Current, LONG Target, UCHAR Weight)
+{
+	LONG delta = Target - Current;
+
+	if (delta > 18000)
+	{
+		delta -= 36000;
+	}
+	else if (delta < -18000)
+	{
+		delta += 36000;
+	}
+
+	LONG result = Current + ((delta * (256 - Weight)) / 256);
+
+	if (result > 18000)
+	{
+		result -= 36000;
+	}
+	else if (result < -18000)
+	{
+		result += 36000;
+	}
+
+	return result;
+}
+
+static VOID DS3_MOTION_RESET_WINDOW(PDS3_MOTION_STATE State)
+{
+	State->WindowSum = 0;
+	State->WindowCount = 0;
+	State->WindowMin = MAXUSHORT;
+	State->WindowMax = 0;
+}
+
+//
+// Resets the pipeline to uncalibrated nominal values
+//
+VOID
+DS3_MOTION_INIT(
+	PDS3_MOTION_STATE State
+)
+{
+	RtlZeroMemory(State, sizeof(DS3_MOTION_STATE));
+
+	State->GyroscopeBias = DS3_MOTION_GYROSCOPE_CENTER << 8;
+
+	DS3_MOTION_RESET_WINDOW(State);
+}
+
+//
+// Feeds a new input report through the pipeline
+//   IsStationary should only be TRUE while the controller is not being handled
+//
+VOID
+DS3_MOTION_UPDATE(
+	PDS3_MOTION_STATE State,
+	const PDS_MOTION_SETTINGS Settings,
+	const PDS3_RAW_INPUT_REPORT Report,
+	BOOLEAN IsStationary
+)
+{
+	const LONG accelX = DS3_MOTION_RAW(Report->AccelerometerX) - DS3_MOTION_ACCELEROMETER_CENTER;
+	const LONG accelY = DS3_MOTION_RAW(Report->AccelerometerY) - DS3_MOTION_ACCELEROMETER_CENTER;
+	const LONG accelZ = DS3_MOTION_RAW(Report->AccelerometerZ) - DS3_MOTION_ACCELEROMETER_CENTER;
+	const LONG gyro = DS3_MOTION_RAW(Report->Gyroscope);
+
+	//
+	// Gyroscope bias estimation, a window only counts if it stayed still throughout
+	//
+	if (Settings->IsCalibrationEnabled && IsStationary && Settings->CalibrationWindow > 0)
+	{
+		State->WindowSum += gyro;
+		State->WindowCount++;
+		State->WindowMin = (USHORT)min(State->WindowMin, gyro);
+		State->WindowMax = (USHORT)max(State->WindowMax, gyro);
+
+		if ((State->WindowMax - State->WindowMin) > DS3_MOTION_STILLNESS_THRESHOLD)
+		{
+			DS3_MOTION_RESET_WINDOW(State);
+		}
+		else if (State->WindowCount >= Settings->CalibrationWindow)
+		{
+			const LONG windowMean = (State->WindowSum << 8) / State->WindowCount;
+
+			//
+			// First estimate replaces the nominal center, later ones form a running mean
+			//
+			if (State->Sample.Flags & DS3_MOTION_FLAG_CALIBRATED)
+			{
+				State->GyroscopeBias += (windowMean - State->GyroscopeBias) / 4;
+			}
+			else
+			{
+				State->GyroscopeBias = windowMean;
+				State->Sample.Flags |= DS3_MOTION_FLAG_CALIBRATED;
+			}
+
+			DS3_MOTION_RESET_WINDOW(State);
+		}
+	}
+	else if (State->WindowCount > 0)
+	{
+		DS3_MOTION_RESET_WINDOW(State);
+	}
+
+	State->Sample.AccelerometerX = (SHORT)DS3_MOTION_CLAMP_SHORT((accelX * DS3_MOTION_ACCELEROMETER_SCALE_Q8) >> 8);
+	State->Sample.AccelerometerY = (SHORT)DS3_MOTION_CLAMP_SHORT((accelY * DS3_MOTION_ACCELEROMETER_SCALE_Q8) >> 8);
+	State->Sample.AccelerometerZ = (SHORT)DS3_MOTION_CLAMP_SHORT((accelZ * DS3_MOTION_ACCELEROMETER_SCALE_Q8) >> 8);
+	State->Sample.Gyroscope = (SHORT)DS3_MOTION_CLAMP_SHORT(
+		(((gyro << 8) - State->GyroscopeBias) * DS3_MOTION_GYROSCOPE_SCALE_Q8) >> 16
+	);
+
+	//
+	// The single gyroscope axis is yaw only, so pitch and roll come from the
+	// accelerometer alone, low-pass filtered to suppress hand jitter
+	//
+	if (Settings->IsTiltEstimationEnabled)
+	{
+		const LONG pitch = DS3_MOTION_ATAN2(accelY, accelZ);
+		const LONG roll = DS3_MOTION_ATAN2(accelX, accelZ);
+
+		if (State->Sample.Flags & DS3_MOTION_FLAG_TILT_VALID)
+		{
+			State->Pitch = DS3_MOTION_SMOOTH_ANGLE(State->Pitch, pitch, Settings->TiltFilterWeight);
+			State->Roll = DS3_MOTION_SMOOTH_ANGLE(State->Roll, roll, Settings->TiltFilterWeight);
+		}
+		else
+		{
+			State->Pitch = pitch;
+			State->Roll = roll;
+			State->Sample.Flags |= DS3_MOTION_FLAG_TILT_VALID;
+		}
+
+		State->Sample.Pitch = (SHORT)State->Pitch;
+		State->Sample.Roll = (SHORT)State->Roll;
+	}
+	else
+	{
+		State->Sample.Flags &= ~DS3_MOTION_FLAG_TILT_VALID;
+		State->Sample.Pitch = 0;
+		State->Sample.Roll = 0;
+	}
+}
+
+//
+// Re-centers the report's gyroscope on the nominal center using the estimated bias
+//   so converters consuming raw fields get calibrated values transparently
+//
+VOID
+DS3_MOTION_APPLY(
+	const PDS3_MOTION_STATE State,
+	PDS3_RAW_INPUT_REPORT Report
+)
+{
+	if (!(State->Sample.Flags & DS3_MOTION_FLAG_CALIBRATED))
+	{
+		return;
+	}
+
+	LONG gyro = (DS3_MOTION_RAW(Report->Gyroscope) << 8) - State->GyroscopeBias + (DS3_MOTION_GYROSCOPE_CENTER << 8);
+
+	gyro = (gyro + 0x80) >> 8;
+	gyro = (gyro < 0) ? 0 : (gyro > 0x3FF) ? 0x3FF : gyro;
+
+	Report->Gyroscope = _byteswap_ushort((USHORT)gyro);
+}
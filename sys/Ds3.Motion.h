@@ -0,0 +1,144 @@
+#pragma once
+
+//
+// Motion sensor pipeline (bias calibration and tilt estimation)
+//   Pure integer code without WDF or Win32 API dependencies, only requires
+//   the basic types, DS3_RAW_INPUT_REPORT and a few CRT intrinsics
+//
+
+//
+// Nominal sensor centers as reported by uncalibrated devices
+//
+#define DS3_MOTION_ACCELEROMETER_CENTER		512
+#define DS3_MOTION_GYROSCOPE_CENTER			498
+
+//
+// Output units, matching the DS4 motion report resolution
+//
+#define DS3_MOTION_ACCELEROMETER_UNITS_PER_G	8192
+#define DS3_MOTION_GYROSCOPE_UNITS_PER_DPS		16
+
+//
+// Q8 factors from DS3 counts (~113 per g, ~1.37 per deg/s) to output units
+//
+#define DS3_MOTION_ACCELEROMETER_SCALE_Q8	18559
+#define DS3_MOTION_GYROSCOPE_SCALE_Q8		2996
+
+//
+// Maximum gyroscope spread (in counts) within a window to be considered stationary
+//
+#define DS3_MOTION_STILLNESS_THRESHOLD		6
+
+#define DS3_MOTION_FLAG_CALIBRATED			0x01
+#define DS3_MOTION_FLAG_TILT_VALID			0x02
+
+//
+// Motion pipeline settings
+//
+typedef struct _DS_MOTION_SETTINGS
+{
+	//
+	// Estimate the gyroscope bias while the controller is resting
+	//
+	BOOLEAN IsCalibrationEnabled;
+
+	//
+	// Number of stationary samples averaged per bias estimate
+	//
+	USHORT CalibrationWindow;
+
+	//
+	// Estimate pitch and roll from the accelerometer
+	//
+	BOOLEAN IsTiltEstimationEnabled;
+
+	//
+	// Weight of the previous tilt estimate in 1/256 (higher is smoother)
+	//
+	UCHAR TiltFilterWeight;
+
+} DS_MOTION_SETTINGS, * PDS_MOTION_SETTINGS;
+
+#include <pshpack1.h>
+
+//
+// Calibrated motion sample, also shared via IPC
+//
+typedef struct _DS3_MOTION_SAMPLE
+{
+	//
+	// Accelerometer in 1/8192 g, device coordinates
+	//
+	SHORT AccelerometerX;
+	SHORT AccelerometerY;
+	SHORT AccelerometerZ;
+
+	//
+	// Yaw rate in 1/16 deg/s, bias removed
+	//
+	SHORT Gyroscope;
+
+	//
+	// Orientation estimate in 1/100 degrees
+	//
+	SHORT Pitch;
+	SHORT Roll;
+
+	//
+	// DS3_MOTION_FLAG_*
+	//
+	UCHAR Flags;
+
+} DS3_MOTION_SAMPLE, * PDS3_MOTION_SAMPLE;
+
+#include <poppack.h>
+
+//
+// Per-device motion pipeline state
+//
+typedef struct _DS3_MOTION_STATE
+{
+	//
+	// Gyroscope bias in Q8 counts
+	//
+	LONG GyroscopeBias;
+
+	//
+	// Current calibration window
+	//
+	LONG WindowSum;
+	USHORT WindowCount;
+	USHORT WindowMin;
+	USHORT WindowMax;
+
+	//
+	// Filtered orientation in 1/100 degrees
+	//
+	LONG Pitch;
+	LONG Roll;
+
+	//
+	// Latest pipeline output
+	//
+	DS3_MOTION_SAMPLE Sample;
+
+} DS3_MOTION_STATE, * PDS3_MOTION_STATE;
+
+VOID
+DS3_MOTION_INIT(
+	_Out_ PDS3_MOTION_STATE State
+);
+
+VOID
+DS3_MOTION_UPDATE(
+	_Inout_ PDS3_MOTION_STATE State,
+	_In_ const PDS_MOTION_SETTINGS Settings,
+	_In_ const PDS3_RAW_INPUT_REPORT Report,
+	_In_ BOOLEAN IsStationary
+);
+
+VOID
+DS3_MOTION_APPLY(
+	_In_ const PDS3_MOTION_STATE State,
+	_Inout_ PDS3_RAW_INPUT_REPORT Report
+);
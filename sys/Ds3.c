@@ -119,34 +119,17 @@ NTSTATUS DsUsb_Ds3RequestHostAddress(WDFDEVICE Device)
 	}
 
 	//
-	// Set host radio address property
+	// Set host radio address property, only written if it changed
 	// 
 
-	WDF_DEVICE_PROPERTY_DATA_INIT(&propertyData, &DEVPKEY_BluetoothRadio_Address);
-	propertyData.Flags |= PLUGPLAY_PROPERTY_PERSISTENT;
-	propertyData.Lcid = LOCALE_NEUTRAL;
-
 	hostAddress = (UINT64)(pDevCtx->HostAddress.Address[5]) |
 		(UINT64)(pDevCtx->HostAddress.Address[4]) << 8 |
 		(UINT64)(pDevCtx->HostAddress.Address[3]) << 16 |
 		(UINT64)(pDevCtx->HostAddress.Address[2]) << 24 |
 		(UINT64)(pDevCtx->HostAddress.Address[1]) << 32 |
 		(UINT64)(pDevCtx->HostAddress.Address[0]) << 40;
-	
-	if (!NT_SUCCESS(status = WdfDeviceAssignProperty(
-		Device,
-		&propertyData,
-		DEVPROP_TYPE_UINT64,
-		sizeof(UINT64),
-		&hostAddress
-	)))
-	{
-		TraceError(
-			TRACE_DS3,
-			"Setting DEVPKEY_BluetoothRadio_Address failed with status %!STATUS!",
-			status
-		);
-	}
+
+	DsDevice_SetHostAddress(pDevCtx, hostAddress);
 
 	FuncExit(TRACE_DS3, "status=%!STATUS!", status);
 
@@ -546,6 +529,23 @@ NTSTATUS DsBth_Ds3SixaxisInit(PDEVICE_CONTEXT Context)
 	return status;
 }
 
+//
+// Updates a shadow byte, marking its field dirty only on actual change
+// 
+static VOID DS3_SHADOW_SET_BYTE(
+	PDEVICE_CONTEXT Context,
+	PUCHAR Field,
+	UCHAR Value,
+	ULONG FieldFlag
+)
+{
+	if (*Field != Value)
+	{
+		*Field = Value;
+		InterlockedOr(&Context->OutputReport.Shadow.DirtyFields, (LONG)FieldFlag);
+	}
+}
+
 //
 // Sets all properties for a specific Player LED
 // 
@@ -561,22 +561,20 @@ VOID DS3_SET_LED_DURATION(
 	if (LedIndex > 3)
 		return;
 
-	// Inverse
-	LedIndex = 3 - LedIndex;
+	const PDS_LED led = &Context->OutputReport.Shadow.Leds[LedIndex];
 
-	PUCHAR buffer;
-
-	DS3_GET_UNIFIED_OUTPUT_REPORT_BUFFER(
-		Context,
-		&buffer,
-		NULL
-	);
+	if (led->TotalDuration != TotalDuration
+		|| led->BasePortionDuration != BasePortionDuration
+		|| led->OffPortionMultiplier != OffPortionMultiplier
+		|| led->OnPortionMultiplier != OnPortionMultiplier)
+	{
+		led->TotalDuration = TotalDuration;
+		led->BasePortionDuration = BasePortionDuration;
+		led->OffPortionMultiplier = OffPortionMultiplier;
+		led->OnPortionMultiplier = OnPortionMultiplier;
 
-	buffer[10 + (LedIndex * 5)] = TotalDuration;
-	buffer[11 + (LedIndex * 5)] = BasePortionDuration >> 8;
-	buffer[12 + (LedIndex * 5)] = BasePortionDuration & 0xFF;
-	buffer[13 + (LedIndex * 5)] = OffPortionMultiplier;
-	buffer[14 + (LedIndex * 5)] = OnPortionMultiplier;
+		InterlockedOr(&Context->OutputReport.Shadow.DirtyFields, DS_OUTPUT_SHADOW_FIELD_LED(LedIndex));
+	}
 }
 
 //
@@ -595,95 +593,171 @@ VOID DS3_SET_LED_DURATION_DEFAULT(PDEVICE_CONTEXT Context, UCHAR LedIndex)
 }
 
 //
-// Gets output report protocol-agnostic
+// Offset of a Player LED block in the common report body (stored in reverse order)
+// 
+#define DS3_OUTPUT_BODY_LED_OFFSET(_index_)	(10 + ((3 - (_index_)) * 5))
+
+//
+// Takes over a report body in common layout (e.g. received from a pass-through consumer)
 // 
-VOID DS3_GET_UNIFIED_OUTPUT_REPORT_BUFFER(
+VOID DS3_SET_OUTPUT_REPORT_BODY(
 	PDEVICE_CONTEXT Context,
-	UCHAR** Buffer,
-	PSIZE_T BufferLength
+	const UCHAR* Body,
+	BOOLEAN PreserveLeds
 )
 {
-	switch (Context->ConnectionType)
-	{
-	case DsDeviceConnectionTypeUsb:
-
-		//
-		// Skip Report ID
-		// 
-
-		*Buffer = &((PUCHAR)WdfMemoryGetBuffer(
-			Context->OutputReportMemory,
-			BufferLength
-		))[1];
-
-		if (BufferLength)
-			*BufferLength -= 1;
-
-		break;
+	const PDS_OUTPUT_SHADOW pShadow = &Context->OutputReport.Shadow;
 
-	case DsDeviceConnectionTypeBth:
+	DS3_SHADOW_SET_BYTE(Context, &pShadow->SmallRumbleDuration, Body[1], DsOutputShadowFieldRumble);
+	DS3_SHADOW_SET_BYTE(Context, &pShadow->SmallRumbleStrength, Body[2], DsOutputShadowFieldRumble);
+	DS3_SHADOW_SET_BYTE(Context, &pShadow->LargeRumbleDuration, Body[3], DsOutputShadowFieldRumble);
+	DS3_SHADOW_SET_BYTE(Context, &pShadow->LargeRumbleStrength, Body[4], DsOutputShadowFieldRumble);
 
-		//
-		// Skip first 2 bytes special to Bluetooth
-		// 
-
-		*Buffer = &((PUCHAR)WdfMemoryGetBuffer(
-			Context->OutputReportMemory,
-			BufferLength
-		))[2];
+	if (!PreserveLeds)
+	{
+		DS3_SET_LED_FLAGS(Context, Body[9]);
 
-		if (BufferLength)
-			*BufferLength -= 2;
+		for (UCHAR ledIndex = 0; ledIndex < 4; ledIndex++)
+		{
+			const UCHAR* led = &Body[DS3_OUTPUT_BODY_LED_OFFSET(ledIndex)];
+
+			DS3_SET_LED_DURATION(
+				Context,
+				ledIndex,
+				led[0],
+				(USHORT)((led[1] << 8) | led[2]),
+				led[3],
+				led[4]
+			);
+		}
+	}
 
-		break;
+	//
+	// Everything else is opaque to the driver
+	// 
+	if (RtlCompareMemory(pShadow->Control, Body, DS3_OUTPUT_REPORT_BODY_SIZE) != DS3_OUTPUT_REPORT_BODY_SIZE)
+	{
+		RtlCopyMemory(pShadow->Control, Body, DS3_OUTPUT_REPORT_BODY_SIZE);
+		InterlockedOr(&pShadow->DirtyFields, DsOutputShadowFieldControl);
 	}
 }
 
 //
-// Gets output report without offset
+// Resets the shadow state to the given default wire report
 // 
-VOID DS3_GET_RAW_OUTPUT_REPORT_BUFFER(
+VOID DS3_INIT_OUTPUT_SHADOW(
 	PDEVICE_CONTEXT Context,
-	UCHAR** Buffer,
-	PSIZE_T BufferLength
+	const UCHAR* Report,
+	ULONG HeaderLength
 )
 {
-	*Buffer = (PUCHAR)WdfMemoryGetBuffer(
-		Context->OutputReportMemory,
-		BufferLength
-	);
+	const PDS_OUTPUT_SHADOW pShadow = &Context->OutputReport.Shadow;
+
+	RtlZeroMemory(pShadow, sizeof(DS_OUTPUT_SHADOW));
+
+	pShadow->HeaderLength = HeaderLength;
+
+	RtlCopyMemory(pShadow->Reports[0], Report, HeaderLength + DS3_OUTPUT_REPORT_BODY_SIZE);
+	RtlCopyMemory(pShadow->Reports[1], Report, HeaderLength + DS3_OUTPUT_REPORT_BODY_SIZE);
+
+	DS3_SET_OUTPUT_REPORT_BODY(Context, &Report[HeaderLength], FALSE);
+
+	//
+	// Both buffers already hold exactly this state
+	// 
+	pShadow->DirtyFields = 0;
 }
 
 //
-// Sets the LED flags byte
+// Builds the changed fields into the back buffer and makes it the front buffer
+//   Returns FALSE and leaves the front buffer untouched if nothing changed
 // 
-VOID DS3_SET_LED_FLAGS(
+BOOLEAN DS3_COMMIT_OUTPUT_SHADOW(
 	PDEVICE_CONTEXT Context,
-	UCHAR Value
+	PUCHAR* Report,
+	PULONG ReportLength
 )
 {
-	switch (Context->ConnectionType)
+	const PDS_OUTPUT_SHADOW pShadow = &Context->OutputReport.Shadow;
+
+	//
+	// Setters don't hold the lock, take the mask before reading any field so a
+	// value changing while building keeps its bit for the next build
+	// 
+	const ULONG dirty = (ULONG)InterlockedExchange(&pShadow->DirtyFields, 0);
+
+	*ReportLength = pShadow->HeaderLength + DS3_OUTPUT_REPORT_BODY_SIZE;
+
+	if (dirty == 0)
 	{
-	case DsDeviceConnectionTypeUsb:
+		*Report = pShadow->Reports[pShadow->FrontIndex];
+		return FALSE;
+	}
 
-		DS3_USB_SET_LED(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), Value);
+	//
+	// The back buffer also lacks what changed for the current front buffer
+	// 
+	const ULONG fields = dirty | pShadow->BackDirtyFields;
+	const ULONG backIndex = pShadow->FrontIndex ^ 1;
+	const PUCHAR body = &pShadow->Reports[backIndex][pShadow->HeaderLength];
 
-		break;
+	if (fields & DsOutputShadowFieldControl)
+	{
+		body[0] = pShadow->Control[0];
+		RtlCopyMemory(&body[5], &pShadow->Control[5], 4);
+		RtlCopyMemory(&body[30], &pShadow->Control[30], DS3_OUTPUT_REPORT_BODY_SIZE - 30);
+	}
 
-	case DsDeviceConnectionTypeBth:
+	if (fields & DsOutputShadowFieldRumble)
+	{
+		body[1] = pShadow->SmallRumbleDuration;
+		body[2] = pShadow->SmallRumbleStrength;
+		body[3] = pShadow->LargeRumbleDuration;
+		body[4] = pShadow->LargeRumbleStrength;
+	}
 
-		DS3_BTH_SET_LED(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), Value);
+	if (fields & DsOutputShadowFieldLedFlags)
+	{
+		body[9] = pShadow->LedFlags;
+	}
 
-		break;
+	for (UCHAR ledIndex = 0; ledIndex < 4; ledIndex++)
+	{
+		if (fields & DS_OUTPUT_SHADOW_FIELD_LED(ledIndex))
+		{
+			const PDS_LED led = &pShadow->Leds[ledIndex];
+			const PUCHAR block = &body[DS3_OUTPUT_BODY_LED_OFFSET(ledIndex)];
+
+			block[0] = led->TotalDuration;
+			block[1] = led->BasePortionDuration >> 8;
+			block[2] = led->BasePortionDuration & 0xFF;
+			block[3] = led->OffPortionMultiplier;
+			block[4] = led->OnPortionMultiplier;
+		}
 	}
+
+	pShadow->FrontIndex = backIndex;
+	pShadow->BackDirtyFields = dirty;
+
+	*Report = pShadow->Reports[backIndex];
+
+	return TRUE;
+}
+
+//
+// Sets the LED flags byte
+// 
+VOID DS3_SET_LED_FLAGS(
+	PDEVICE_CONTEXT Context,
+	UCHAR Value
+)
+{
+	DS3_SHADOW_SET_BYTE(
+		Context,
+		&Context->OutputReport.Shadow.LedFlags,
+		Value,
+		DsOutputShadowFieldLedFlags
+	);
 }
 
 //
@@ -693,26 +767,7 @@ UCHAR DS3_GET_LED_FLAGS(
 	PDEVICE_CONTEXT Context
 )
 {
-	switch (Context->ConnectionType)
-	{
-	case DsDeviceConnectionTypeUsb:
-
-		return DS3_USB_GET_LED(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			));
-
-	case DsDeviceConnectionTypeBth:
-
-		return DS3_BTH_GET_LED(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			));
-	}
-
-	return 0x00;
+	return Context->OutputReport.Shadow.LedFlags;
 }
 
 VOID DS3_SET_SMALL_RUMBLE_DURATION(
@@ -720,26 +775,12 @@ VOID DS3_SET_SMALL_RUMBLE_DURATION(
 	UCHAR Value
 )
 {
-	switch (Context->ConnectionType)
-	{
-	case DsDeviceConnectionTypeUsb:
-
-		DS3_USB_SET_SMALL_RUMBLE_DURATION(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), Value);
-		break;
-
-	case DsDeviceConnectionTypeBth:
-
-		DS3_BTH_SET_SMALL_RUMBLE_DURATION(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), Value);
-		break;
-	}
+	DS3_SHADOW_SET_BYTE(
+		Context,
+		&Context->OutputReport.Shadow.SmallRumbleDuration,
+		Value,
+		DsOutputShadowFieldRumble
+	);
 }
 
 VOID DS3_SET_SMALL_RUMBLE_STRENGTH(
@@ -756,26 +797,12 @@ VOID DS3_SET_LARGE_RUMBLE_DURATION(
 	UCHAR Value
 )
 {
-	switch (Context->ConnectionType)
-	{
-	case DsDeviceConnectionTypeUsb:
-
-		DS3_USB_SET_LARGE_RUMBLE_DURATION(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), Value);
-		break;
-
-	case DsDeviceConnectionTypeBth:
-
-		DS3_BTH_SET_LARGE_RUMBLE_DURATION(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), Value);
-		break;
-	}
+	DS3_SHADOW_SET_BYTE(
+		Context,
+		&Context->OutputReport.Shadow.LargeRumbleDuration,
+		Value,
+		DsOutputShadowFieldRumble
+	);
 }
 
 VOID DS3_SET_LARGE_RUMBLE_STRENGTH(
@@ -862,35 +889,268 @@ VOID DS3_PROCESS_RUMBLE_STRENGTH(
 		heavyRumble = heavyResc->ConstA * heavyRumble + heavyResc->ConstB;
 	}
 
-	switch (Context->ConnectionType)
+	DS3_SHADOW_SET_BYTE(
+		Context,
+		&Context->OutputReport.Shadow.LargeRumbleStrength,
+		(UCHAR)heavyRumble,
+		DsOutputShadowFieldRumble
+	);
+	DS3_SHADOW_SET_BYTE(
+		Context,
+		&Context->OutputReport.Shadow.SmallRumbleStrength,
+		((UCHAR)lightRumble > 0) ? 0x01 : 0x00,
+		DsOutputShadowFieldRumble
+	);
+}
+
+//
+// Compiles a button combination into a mask over Buttons.lButtons
+// 
+static ULONG DS3_BUTTON_COMBO_MASK(
+	const DS_BUTTON_COMBO* Combo
+)
+{
+	ULONG mask = 0;
+
+	for (ULONGLONG buttonIndex = 0; buttonIndex < _countof(Combo->Buttons); buttonIndex++)
 	{
-	case DsDeviceConnectionTypeUsb:
-
-		DS3_USB_SET_LARGE_RUMBLE_STRENGTH(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), (UCHAR)heavyRumble);
-		DS3_USB_SET_SMALL_RUMBLE_STRENGTH(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), (UCHAR)lightRumble);
-		break;
+		if (Combo->Buttons[buttonIndex] <= DS_BUTTON_COMBO_MAX_OFFSET)
+		{
+			mask |= 1UL << Combo->Buttons[buttonIndex];
+		}
+	}
+
+	return mask;
+}
+
+//
+// Appends an enabled button combination to the engine
+// 
+static VOID DS3_BUTTON_COMBO_ENGINE_ADD(
+	PDS_BUTTON_COMBO_ENGINE Engine,
+	const DS_BUTTON_COMBO* Combo,
+	DS_BUTTON_COMBO_ACTION Action,
+	ULONG RearmDelay
+)
+{
+	const ULONG mask = DS3_BUTTON_COMBO_MASK(Combo);
+
+	if (!Combo->IsEnabled || mask == 0 || Action == DsButtonComboActionNone
+		|| Engine->Count >= _countof(Engine->Entries))
+	{
+		return;
+	}
+
+	const PDS_COMPILED_BUTTON_COMBO pEntry = &Engine->Entries[Engine->Count++];
+
+	pEntry->Mask = mask;
+	pEntry->HoldTime = Combo->HoldTime;
+	pEntry->RearmDelay = RearmDelay;
+	pEntry->Action = Action;
+	pEntry->EngagedSince = 0;
+	pEntry->TriggeredAt = 0;
+}
+
+//
+// Pre-compiles all configured button combinations
+// 
+VOID DS3_BUTTON_COMBO_ENGINE_BUILD(
+	PDS_BUTTON_COMBO_ENGINE Engine,
+	PDS_DRIVER_CONFIGURATION Configuration,
+	BOOLEAN IsWireless
+)
+{
+	WdfWaitLockAcquire(Engine->Lock, NULL);
+
+	WdfTimerStop(Engine->HoldTimer, FALSE);
+
+	Engine->Count = 0;
+	Engine->EngagedEntries = 0;
+
+	if (IsWireless)
+	{
+		DS3_BUTTON_COMBO_ENGINE_ADD(
+			Engine,
+			&Configuration->WirelessDisconnectButtonCombo,
+			DsButtonComboActionWirelessDisconnect,
+			0
+		);
+	}
+
+	//
+	// Wait 1 second before re-enabling toggle combo after triggering it
+	// 
+	DS3_BUTTON_COMBO_ENGINE_ADD(
+		Engine,
+		&Configuration->RumbleSettings.AlternativeMode.ToggleButtonCombo,
+		DsButtonComboActionToggleAlternativeRumble,
+		1000
+	);
+
+	for (ULONG index = 0; index < Configuration->CustomButtonCombos.Count; index++)
+	{
+		const PDS_CUSTOM_BUTTON_COMBO pCustom = &Configuration->CustomButtonCombos.Entries[index];
+
+		if (pCustom->Action == DsButtonComboActionWirelessDisconnect && !IsWireless)
+		{
+			continue;
+		}
+
+		DS3_BUTTON_COMBO_ENGINE_ADD(
+			Engine,
+			&pCustom->Combo,
+			pCustom->Action,
+			1000
+		);
+	}
+
+	WdfWaitLockRelease(Engine->Lock);
+
+	TraceVerbose(
+		TRACE_DS3,
+		"Compiled %d button combinations",
+		Engine->Count
+	);
+}
+
+//
+// (Re-)arms the hold timer for the engaged combination closest to its hold time
+//   Caller must hold the engine lock
+// 
+static VOID DS3_BUTTON_COMBO_ENGINE_ARM(
+	PDS_BUTTON_COMBO_ENGINE Engine,
+	ULONGLONG Now
+)
+{
+	ULONGLONG nextDueIn = MAXULONG64;
+
+	for (ULONG index = 0; index < Engine->Count; index++)
+	{
+		const PDS_COMPILED_BUTTON_COMBO pEntry = &Engine->Entries[index];
+
+		if (pEntry->EngagedSince == 0)
+		{
+			continue;
+		}
+
+		const ULONGLONG elapsed = Now - pEntry->EngagedSince;
+		const ULONGLONG dueIn = (elapsed < pEntry->HoldTime) ? (pEntry->HoldTime - elapsed) : 1;
 
-	case DsDeviceConnectionTypeBth:
-
-		DS3_BTH_SET_LARGE_RUMBLE_STRENGTH(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), (UCHAR)heavyRumble);
-		DS3_BTH_SET_SMALL_RUMBLE_STRENGTH(
-			(PUCHAR)WdfMemoryGetBuffer(
-				Context->OutputReportMemory,
-				NULL
-			), (UCHAR)lightRumble);
+		if (dueIn < nextDueIn)
+		{
+			nextDueIn = dueIn;
+		}
+	}
+
+	if (nextDueIn == MAXULONG64)
+	{
+		WdfTimerStop(Engine->HoldTimer, FALSE);
+	}
+	else
+	{
+		WdfTimerStart(Engine->HoldTimer, WDF_REL_TIMEOUT_IN_MS(nextDueIn));
+	}
+}
+
+//
+// Matches the current button state against all combinations
+//   Only press/release transitions read the clock and touch the hold timer
+// 
+VOID DS3_BUTTON_COMBO_ENGINE_UPDATE(
+	PDS_BUTTON_COMBO_ENGINE Engine,
+	ULONG Buttons
+)
+{
+	ULONG engaged = 0;
+
+	for (ULONG index = 0; index < Engine->Count; index++)
+	{
+		if ((Buttons & Engine->Entries[index].Mask) == Engine->Entries[index].Mask)
+		{
+			engaged |= 1UL << index;
+		}
+	}
+
+	if (engaged == Engine->EngagedEntries)
+	{
+		return;
+	}
+
+	WdfWaitLockAcquire(Engine->Lock, NULL);
+
+	const ULONGLONG now = GetTickCount64();
+	const ULONG changed = engaged ^ Engine->EngagedEntries;
+
+	for (ULONG index = 0; index < Engine->Count; index++)
+	{
+		const PDS_COMPILED_BUTTON_COMBO pEntry = &Engine->Entries[index];
+
+		if (!(changed & (1UL << index)))
+		{
+			continue;
+		}
+
+		if (!(engaged & (1UL << index)))
+		{
+			pEntry->EngagedSince = 0;
+			continue;
+		}
+
+		//
+		// Must be re-armed before triggering again
+		// 
+		if (pEntry->TriggeredAt != 0 && (now - pEntry->TriggeredAt) <= pEntry->RearmDelay)
+		{
+			TraceVerbose(
+				TRACE_DS3,
+				"Button combination %d pressed before re-arm, ignoring",
+				index
+			);
+			continue;
+		}
+
+		pEntry->TriggeredAt = 0;
+		pEntry->EngagedSince = now;
+	}
+
+	Engine->EngagedEntries = engaged;
+
+	DS3_BUTTON_COMBO_ENGINE_ARM(Engine, now);
+
+	WdfWaitLockRelease(Engine->Lock);
+}
+
+//
+// Called from the hold timer, returns the action of a combination held long enough
+// 
+DS_BUTTON_COMBO_ACTION DS3_BUTTON_COMBO_ENGINE_EXPIRE(
+	PDS_BUTTON_COMBO_ENGINE Engine
+)
+{
+	DS_BUTTON_COMBO_ACTION action = DsButtonComboActionNone;
+
+	WdfWaitLockAcquire(Engine->Lock, NULL);
+
+	const ULONGLONG now = GetTickCount64();
+
+	for (ULONG index = 0; index < Engine->Count; index++)
+	{
+		const PDS_COMPILED_BUTTON_COMBO pEntry = &Engine->Entries[index];
+
+		if (pEntry->EngagedSince == 0 || (now - pEntry->EngagedSince) < pEntry->HoldTime)
+		{
+			continue;
+		}
+
+		pEntry->EngagedSince = 0;
+		pEntry->TriggeredAt = now;
+		action = pEntry->Action;
 		break;
 	}
 
+	DS3_BUTTON_COMBO_ENGINE_ARM(Engine, now);
+
+	WdfWaitLockRelease(Engine->Lock);
+
+	return action;
 }
@@ -61,6 +61,21 @@ typedef enum
 	DS3_BUTTON_COMBO_OFFSET_PS = 16,
 } DS3_BUTTON_COMBO_OFFSET;
 
+VOID DS3_BUTTON_COMBO_ENGINE_BUILD(
+	PDS_BUTTON_COMBO_ENGINE Engine,
+	PDS_DRIVER_CONFIGURATION Configuration,
+	BOOLEAN IsWireless
+);
+
+VOID DS3_BUTTON_COMBO_ENGINE_UPDATE(
+	PDS_BUTTON_COMBO_ENGINE Engine,
+	ULONG Buttons
+);
+
+DS_BUTTON_COMBO_ACTION DS3_BUTTON_COMBO_ENGINE_EXPIRE(
+	PDS_BUTTON_COMBO_ENGINE Engine
+);
+
 
 VOID DS3_SET_LED_DURATION(
 	PDEVICE_CONTEXT Context,
@@ -76,16 +91,22 @@ VOID DS3_SET_LED_DURATION_DEFAULT(
 	UCHAR LedIndex
 );
 
-VOID DS3_GET_UNIFIED_OUTPUT_REPORT_BUFFER(
+VOID DS3_SET_OUTPUT_REPORT_BODY(
+	PDEVICE_CONTEXT Context,
+	const UCHAR* Body,
+	BOOLEAN PreserveLeds
+);
+
+VOID DS3_INIT_OUTPUT_SHADOW(
 	PDEVICE_CONTEXT Context,
-	UCHAR** Buffer,
-	PSIZE_T BufferLength
+	const UCHAR* Report,
+	ULONG HeaderLength
 );
 
-VOID DS3_GET_RAW_OUTPUT_REPORT_BUFFER(
+BOOLEAN DS3_COMMIT_OUTPUT_SHADOW(
 	PDEVICE_CONTEXT Context,
-	UCHAR** Buffer,
-	PSIZE_T BufferLength
+	PUCHAR* Report,
+	PULONG ReportLength
 );
 
 VOID DS3_SET_LED_FLAGS(
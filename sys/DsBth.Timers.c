@@ -130,3 +130,42 @@ DsBth_EvtPostStartupTimerFunc(
 
 	FuncExitNoReturn(TRACE_DSBTH);
 }
+
+//
+// Invoked once the controller has been idle for the configured period
+// 
+_Use_decl_annotations_
+VOID
+DsBth_EvtIdleDisconnectTimerFunc(
+	WDFTIMER  Timer
+)
+{
+	NTSTATUS status;
+
+	FuncEntry(TRACE_DSBTH);
+
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(WdfTimerGetParentObject(Timer));
+
+	//
+	// Input may have resumed while the timer was already queued
+	// 
+	if (pDevCtx->Connection.Bth.IsIdle)
+	{
+		TraceEvents(TRACE_LEVEL_INFORMATION,
+			TRACE_DSBTH,
+			"!! Idle timeout detected, sending disconnect request"
+		);
+
+		if (!NT_SUCCESS(status = DsBth_SendDisconnectRequest(pDevCtx)))
+		{
+			TraceError(
+				TRACE_DSBTH,
+				"Sending disconnect request failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"DsBth_SendDisconnectRequest", status);
+		}
+	}
+
+	FuncExitNoReturn(TRACE_DSBTH);
+}
@@ -143,6 +143,7 @@ NTSTATUS DsBth_SelfManagedIoSuspend(WDFDEVICE Device)
 	FuncEntry(TRACE_DSBTH);
 
 	WdfTimerStop(pDevCtx->Connection.Bth.Timers.StartupDelay, FALSE);
+	WdfTimerStop(pDevCtx->Connection.Bth.Timers.IdleDisconnect, FALSE);
 
 	DMF_DefaultTarget_StreamStop(pDevCtx->Connection.Bth.HidInterrupt.InputStreamerModule);
 	DMF_DefaultTarget_StreamStop(pDevCtx->Connection.Bth.HidControl.OutputWriterModule);
@@ -43,6 +43,7 @@ NTSTATUS DsBth_SendDisconnectRequest(PDEVICE_CONTEXT Context);
 EVT_WDF_TIMER DsBth_EvtControlReadTimerFunc;
 EVT_WDF_TIMER DsBth_EvtStartupDelayTimerFunc;
 EVT_WDF_TIMER DsBth_EvtPostStartupTimerFunc;
+EVT_WDF_TIMER DsBth_EvtIdleDisconnectTimerFunc;
 
 VOID CALLBACK
 DsBth_DisconnectEventCallback(
@@ -97,7 +97,11 @@ typedef enum
 	//
 	// Microsoft XINPUTHID.SYS compatible
 	// 
-	DsHidMiniDeviceModeXInputHIDCompatible
+	DsHidMiniDeviceModeXInputHIDCompatible,
+	//
+	// Vendor defined device carrying the unmodified raw report
+	// 
+	DsHidMiniDeviceModeRaw
 } DS_HID_DEVICE_MODE, * PDS_HID_DEVICE_MODE;
 
 //
@@ -110,7 +114,8 @@ static CONST PSTR G_HID_DEVICE_MODE_NAMES[] =
 	"GPJ",
 	"SXS",
 	"DS4Windows",
-	"XInput"
+	"XInput",
+	"Raw"
 };
 
 //
@@ -350,6 +355,123 @@ static CONST PSTR G_DS_BUTTON_COMBO_NAMES[] =
 // 
 #define DS_BUTTON_COMBO_MAX_OFFSET 16
 
+//
+// Actions a button combination can trigger
+// 
+typedef enum
+{
+	//
+	// Do nothing
+	// 
+	DsButtonComboActionNone = 0,
+	//
+	// Disconnect the device (wireless only)
+	// 
+	DsButtonComboActionWirelessDisconnect,
+	//
+	// Toggle alternative rumble mode
+	// 
+	DsButtonComboActionToggleAlternativeRumble
+} DS_BUTTON_COMBO_ACTION;
+
+//
+// Friendly names for reading from JSON
+// 
+static CONST PSTR G_DS_BUTTON_COMBO_ACTION_NAMES[] =
+{
+	"None",
+	"WirelessDisconnect",
+	"ToggleAlternativeRumble"
+};
+
+//
+// Maximum amount of user-defined button combinations
+// 
+#define DS_CUSTOM_BUTTON_COMBO_MAX_ENTRIES	8
+
+//
+// User-defined button combination
+// 
+typedef struct _DS_CUSTOM_BUTTON_COMBO
+{
+	//
+	// Buttons and hold time, unused buttons are left out
+	// 
+	DS_BUTTON_COMBO Combo;
+
+	//
+	// Triggered action
+	// 
+	DS_BUTTON_COMBO_ACTION Action;
+} DS_CUSTOM_BUTTON_COMBO, * PDS_CUSTOM_BUTTON_COMBO;
+
+//
+// Button combination pre-compiled into a mask over Buttons.lButtons
+// 
+typedef struct _DS_COMPILED_BUTTON_COMBO
+{
+	//
+	// All bits must be set for the combination to be engaged
+	// 
+	ULONG Mask;
+
+	//
+	// How long (ms) the combination must be held
+	// 
+	ULONG HoldTime;
+
+	//
+	// How long (ms) after triggering the combination may trigger again
+	// 
+	ULONG RearmDelay;
+
+	//
+	// Triggered action
+	// 
+	DS_BUTTON_COMBO_ACTION Action;
+
+	//
+	// Tick count the combination got engaged at, 0 if released or already triggered
+	// 
+	ULONGLONG EngagedSince;
+
+	//
+	// Tick count the combination triggered at, 0 if armed
+	// 
+	ULONGLONG TriggeredAt;
+} DS_COMPILED_BUTTON_COMBO, * PDS_COMPILED_BUTTON_COMBO;
+
+//
+// All button combinations active for a device
+// 
+typedef struct _DS_BUTTON_COMBO_ENGINE
+{
+	//
+	// Amount of valid entries
+	// 
+	ULONG Count;
+
+	//
+	// Built-in combinations first, user-defined ones after
+	// 
+	DS_COMPILED_BUTTON_COMBO Entries[DS_CUSTOM_BUTTON_COMBO_MAX_ENTRIES + 2];
+
+	//
+	// Bit per entry currently held down, as of the last input report
+	// 
+	ULONG EngagedEntries;
+
+	//
+	// Fires when the next engaged combination reached its hold time
+	// 
+	WDFTIMER HoldTimer;
+
+	//
+	// Protects the entries between input path and timer
+	// 
+	WDFWAITLOCK Lock;
+} DS_BUTTON_COMBO_ENGINE, * PDS_BUTTON_COMBO_ENGINE;
+
 //
 // Axis dead-zone settings
 // 
@@ -534,6 +656,298 @@ typedef struct _DS_FLIP_AXIS_SETTINGS
 	UCHAR RightY;
 } DS_FLIP_AXIS_SETTINGS, * PDS_FLIP_AXIS_SETTINGS;
 
+//
+// Shapes a response curve can take
+//
+typedef enum
+{
+	//
+	// Output follows input 1:1
+	//
+	DsResponseCurveTypeLinear,
+	//
+	// Output is input to the power of the exponent (> 1 = softer, < 1 = sharper start)
+	//
+	DsResponseCurveTypeExponential,
+	//
+	// Soft around rest and full engagement, steep in between, exponent controls steepness
+	//
+	DsResponseCurveTypeSCurve
+} DS_RESPONSE_CURVE_TYPE, * PDS_RESPONSE_CURVE_TYPE;
+
+//
+// Friendly names for reading from JSON
+//
+static CONST PSTR G_RESPONSE_CURVE_TYPE_NAMES[] =
+{
+	"Linear",
+	"Exponential",
+	"SCurve"
+};
+
+//
+// Response curve of a single axis or pressure channel
+//
+typedef struct _DS_RESPONSE_CURVE
+{
+	//
+	// Shape of the curve
+	//
+	DS_RESPONSE_CURVE_TYPE Type;
+
+	//
+	// Exponent (Exponential) or steepness (SCurve), ignored for Linear
+	//
+	DOUBLE Exponent;
+
+	//
+	// Percentage of travel at the end of the range already reported as fully engaged
+	//
+	DOUBLE OuterDeadZone;
+
+	//
+	// Percentage of the output range skipped as soon as the input leaves rest position
+	//
+	DOUBLE AntiDeadZone;
+} DS_RESPONSE_CURVE, * PDS_RESPONSE_CURVE;
+
+//
+// Response curves of the thumb stick axes
+//
+typedef struct _DS_AXIS_RESPONSE_CURVES
+{
+	DS_RESPONSE_CURVE LeftX;
+
+	DS_RESPONSE_CURVE LeftY;
+
+	DS_RESPONSE_CURVE RightX;
+
+	DS_RESPONSE_CURVE RightY;
+} DS_AXIS_RESPONSE_CURVES, * PDS_AXIS_RESPONSE_CURVES;
+
+//
+// Amount of pressure sensitive channels in a raw input report
+//
+#define DS_PRESSURE_CHANNEL_COUNT	12
+
+//
+// Friendly names for reading from JSON, in Pressure.bValues order
+//
+static CONST PSTR G_DS_PRESSURE_CHANNEL_NAMES[DS_PRESSURE_CHANNEL_COUNT] =
+{
+	"Up",
+	"Right",
+	"Down",
+	"Left",
+	"L2",
+	"R2",
+	"L1",
+	"R1",
+	"Triangle",
+	"Circle",
+	"Cross",
+	"Square"
+};
+
+//
+// Response curves of the pressure sensitive buttons
+//
+typedef struct _DS_PRESSURE_RESPONSE_CURVES
+{
+	DS_RESPONSE_CURVE Channels[DS_PRESSURE_CHANNEL_COUNT];
+} DS_PRESSURE_RESPONSE_CURVES, * PDS_PRESSURE_RESPONSE_CURVES;
+
+//
+// Pre-computed response curve, indexed by the raw value
+//
+typedef struct _DS_RESPONSE_CURVE_LUT
+{
+	UCHAR Entries[0x100];
+} DS_RESPONSE_CURVE_LUT, * PDS_RESPONSE_CURVE_LUT;
+
+//
+// Pre-computed response curves of all pressure sensitive buttons
+//
+typedef struct _DS_PRESSURE_LOOKUP_TABLES
+{
+	//
+	// FALSE if all tables are identity mappings and can be skipped
+	//
+	BOOLEAN IsActive;
+
+	DS_RESPONSE_CURVE_LUT Channels[DS_PRESSURE_CHANNEL_COUNT];
+} DS_PRESSURE_LOOKUP_TABLES, * PDS_PRESSURE_LOOKUP_TABLES;
+
+//
+// Pressure sensitive buttons noise gate settings
+// 
+typedef struct _DS_PRESSURE_NOISE_GATE_SETTINGS
+{
+	//
+	// If set, pressure changes within the channel threshold are suppressed
+	// 
+	BOOLEAN IsEnabled;
+
+	//
+	// Amount of counts a channel must move away from the last reported value, in Pressure.bValues order
+	// 
+	UCHAR Thresholds[DS_PRESSURE_CHANNEL_COUNT];
+} DS_PRESSURE_NOISE_GATE_SETTINGS, * PDS_PRESSURE_NOISE_GATE_SETTINGS;
+
+//
+// Pre-computed transformation (flip + dead-zone + response curve) of one thumb stick
+//   Indexed by (Y << 8 | X) of the raw input, each entry holds the
+//   transformed X in the low and the transformed Y in the high byte
+//
+typedef struct _DS_THUMB_AXIS_LUT
+{
+	USHORT Entries[0x100 * 0x100];
+} DS_THUMB_AXIS_LUT, * PDS_THUMB_AXIS_LUT;
+
+//
+// Pre-computed thumb stick transformations of both sticks
+//
+typedef struct _DS_THUMB_LOOKUP_TABLES
+{
+	DS_THUMB_AXIS_LUT Left;
+
+	DS_THUMB_AXIS_LUT Right;
+} DS_THUMB_LOOKUP_TABLES, * PDS_THUMB_LOOKUP_TABLES;
+
+//
+// Input report change detection settings
+// 
+typedef struct _DS_INPUT_CHANGE_DETECTION_SETTINGS
+{
+	//
+	// If set, input reports identical to the last delivered one are not submitted (opt-in)
+	// 
+	BOOLEAN IsEnabled;
+
+	//
+	// Period in milliseconds after which an unchanged report is submitted anyway (0 = never)
+	// 
+	ULONG HeartbeatPeriodMs;
+} DS_INPUT_CHANGE_DETECTION_SETTINGS, * PDS_INPUT_CHANGE_DETECTION_SETTINGS;
+
+//
+// Maximum amount of input reports held back while no HID read is pending
+// 
+#define DS_INPUT_REPORT_BACKLOG_MAX_DEPTH	16
+
+//
+// Input report backlog settings
+// 
+typedef struct _DS_INPUT_REPORT_BACKLOG_SETTINGS
+{
+	//
+	// Amount of reports held back while no HID read is pending (0 = disabled)
+	// 
+	UCHAR Depth;
+
+	//
+	// If set, only the most recent undelivered report is kept
+	// 
+	BOOLEAN IsLatestOnly;
+} DS_INPUT_REPORT_BACKLOG_SETTINGS, * PDS_INPUT_REPORT_BACKLOG_SETTINGS;
+
+//
+// How input reports get paced towards HID consumers
+// 
+typedef enum
+{
+	//
+	// Every report is delivered as it arrives
+	// 
+	DsInputRateLimitPolicyDisabled,
+	//
+	// Only the newest report is kept and released on the next interval tick
+	// 
+	DsInputRateLimitPolicyLatestWins,
+	//
+	// Changes are released immediately unless the last delivery happened less than the interval ago
+	// 
+	DsInputRateLimitPolicyImmediateOnChange
+} DS_INPUT_RATE_LIMIT_POLICY, * PDS_INPUT_RATE_LIMIT_POLICY;
+
+//
+// Friendly names for reading from JSON
+//
+static CONST PSTR G_INPUT_RATE_LIMIT_POLICY_NAMES[] =
+{
+	"Disabled",
+	"LatestWins",
+	"ImmediateOnChange"
+};
+
+//
+// Input report rate limit settings
+// 
+typedef struct _DS_INPUT_RATE_LIMIT_SETTINGS
+{
+	DS_INPUT_RATE_LIMIT_POLICY Policy;
+
+	//
+	// Minimum period in milliseconds between two delivered reports of the same type
+	//   In "latest wins" mode reports held back are released by a timer bound to the
+	//   system timer resolution, so the effective period may be longer than configured
+	// 
+	ULONG MinimumIntervalMs;
+} DS_INPUT_RATE_LIMIT_SETTINGS, * PDS_INPUT_RATE_LIMIT_SETTINGS;
+
+//
+// Maximum amount of concurrently pending Bluetooth interrupt IN reads
+// 
+#define DS_BTH_INPUT_PIPELINE_MAX_DEPTH	8
+
+//
+// Bluetooth interrupt IN read pipeline settings
+// 
+typedef struct _DS_BTH_INPUT_PIPELINE_SETTINGS
+{
+	//
+	// Amount of read requests kept pending on the interrupt channel
+	// 
+	UCHAR RequestCount;
+
+	//
+	// Amount of pre-allocated read buffers, never less than RequestCount
+	// 
+	UCHAR BufferCount;
+} DS_BTH_INPUT_PIPELINE_SETTINGS, * PDS_BTH_INPUT_PIPELINE_SETTINGS;
+
+//
+// Maximum amount of pending reads the USB continuous reader supports
+// 
+#define DS_USB_INPUT_PIPELINE_MAX_DEPTH				10
+
+//
+// Bounds of the USB interrupt IN transfer length
+// 
+#define DS_USB_INPUT_PIPELINE_MIN_TRANSFER_LENGTH	64
+#define DS_USB_INPUT_PIPELINE_MAX_TRANSFER_LENGTH	1024
+
+//
+// USB interrupt IN continuous reader settings
+// 
+typedef struct _DS_USB_INPUT_PIPELINE_SETTINGS
+{
+	//
+	// Amount of read requests kept pending on the interrupt IN pipe
+	// 
+	UCHAR RequestCount;
+
+	//
+	// Size of each read request in bytes
+	// 
+	USHORT TransferLength;
+
+	//
+	// If set, every detected completion gap is traced along with the reader settings
+	// 
+	BOOLEAN IsValidationEnabled;
+} DS_USB_INPUT_PIPELINE_SETTINGS, * PDS_USB_INPUT_PIPELINE_SETTINGS;
+
 //
 // Per device dynamic configuration properties
 // 
@@ -570,6 +984,27 @@ typedef struct _DS_DRIVER_CONFIGURATION
 	// 
 	UCHAR OutputRateControlPeriodMs;
 
+	//
+	// True if the output rate control period adapts to the link instead of being fixed
+	// 
+	BOOLEAN IsOutputRateControlAdaptive;
+
+	//
+	// Bounds of the adaptive output rate control period in milliseconds
+	// 
+	USHORT OutputRateControlMinPeriodMs;
+	USHORT OutputRateControlMaxPeriodMs;
+
+	//
+	// True if output reports identical to the last queued one get dropped
+	// 
+	BOOLEAN IsOutputDeduplicatorEnabled;
+
+	//
+	// Period in milliseconds after which an identical output report is sent anyway, 0 to never
+	// 
+	ULONG OutputDeduplicatorRefreshPeriodMs;
+
 	//
 	// Idle disconnect period in milliseconds
 	// 
@@ -580,11 +1015,53 @@ typedef struct _DS_DRIVER_CONFIGURATION
 	// 
 	BOOLEAN DisableWirelessIdleTimeout;
 
+	//
+	// Minimum period in milliseconds between status device property writes
+	// 
+	ULONG PropertyWriteIntervalMs;
+
+	//
+	// Suppression of unchanged input reports
+	// 
+	DS_INPUT_CHANGE_DETECTION_SETTINGS InputChangeDetection;
+
+	//
+	// Buffering of input reports while no HID read is pending
+	// 
+	DS_INPUT_REPORT_BACKLOG_SETTINGS InputReportBacklog;
+
+	//
+	// Pacing of input reports towards HID consumers
+	// 
+	DS_INPUT_RATE_LIMIT_SETTINGS InputRateLimit;
+
+	//
+	// Bluetooth input read pipeline
+	// Can't be altered at runtime
+	// 
+	DS_BTH_INPUT_PIPELINE_SETTINGS BthInputPipeline;
+
+	//
+	// USB input continuous reader
+	// Can't be altered at runtime
+	// 
+	DS_USB_INPUT_PIPELINE_SETTINGS UsbInputPipeline;
+
 	//
 	// Wireless disconnect button combo customizing
 	//
 	DS_BUTTON_COMBO WirelessDisconnectButtonCombo;
 
+	//
+	// User-defined button combos
+	//
+	struct
+	{
+		ULONG Count;
+
+		DS_CUSTOM_BUTTON_COMBO Entries[DS_CUSTOM_BUTTON_COMBO_MAX_ENTRIES];
+	} CustomButtonCombos;
+
 	//
 	// Thumb stick specific settings
 	// 
@@ -605,6 +1082,26 @@ typedef struct _DS_DRIVER_CONFIGURATION
 	// 
 	DS_FLIP_AXIS_SETTINGS FlipAxis;
 
+	//
+	// Thumb stick axes response curves
+	//
+	DS_AXIS_RESPONSE_CURVES AxisResponseCurves;
+
+	//
+	// Pressure sensitive buttons response curves
+	//
+	DS_PRESSURE_RESPONSE_CURVES PressureResponseCurves;
+
+	//
+	// Pressure sensitive buttons jitter suppression
+	// 
+	DS_PRESSURE_NOISE_GATE_SETTINGS PressureNoiseGate;
+
+	//
+	// Motion sensor calibration and tilt estimation
+	// 
+	DS_MOTION_SETTINGS Motion;
+
 	//
 	// SDF-mode specific
 	// 
@@ -159,6 +159,28 @@ sizeof(G_XInputHIDCompatible_HidReportDescriptor) }  // total length of report d
 
 #pragma endregion
 
+#pragma region DS3 HID Report Descriptor (Raw passthrough)
+
+CONST HID_REPORT_DESCRIPTOR G_RawPassthrough_HidReportDescriptor[] =
+{
+	/************************************************************************/
+	/* Vendor defined raw DS3 input report passthrough                      */
+	/************************************************************************/
+#include "HID/06_RAW_Col1_VendorDefined.h"
+};
+
+CONST HID_DESCRIPTOR G_RawPassthrough_HidDescriptor = {
+	0x09,   // length of HID descriptor
+	0x21,   // descriptor type == HID  0x21
+	0x0100, // hid spec release
+	0x00,   // country code == Not Specified
+	0x01,   // number of HID class descriptors
+{ 0x22,   // descriptor type 
+sizeof(G_RawPassthrough_HidReportDescriptor) }  // total length of report descriptor
+};
+
+#pragma endregion
+
 
 //
 // Applies transformations on a thumb axis pair
@@ -220,13 +242,129 @@ void DS3_RAW_AXIS_TRANSFORM(
 	}
 }
 
-VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
+//
+// Pre-computes the transformations of a thumb axis pair for every possible raw value
+// 
+void DS3_THUMB_AXIS_LUT_BUILD(
+	_Out_ PDS_THUMB_AXIS_LUT Table,
+	_In_ const PDS_AXIS_DEADZONE DeadZone,
+	_In_ const BOOLEAN FlipX,
+	_In_ const BOOLEAN FlipY,
+	_In_ const DS_RESPONSE_CURVE_LUT* CurveX,
+	_In_ const DS_RESPONSE_CURVE_LUT* CurveY
+)
+{
+	for (ULONG index = 0; index < ARRAYSIZE(Table->Entries); index++)
+	{
+		UCHAR outputX = 0x80;
+		UCHAR outputY = 0x80;
+
+		DS3_RAW_AXIS_TRANSFORM(
+			(UCHAR)(index & 0xFF),
+			(UCHAR)(index >> 8),
+			&outputX,
+			&outputY,
+			DeadZone->Apply,
+			DeadZone->PolarValue,
+			FlipX,
+			FlipY
+		);
+
+		outputX = CurveX->Entries[outputX];
+		outputY = CurveY->Entries[outputY];
+
+		Table->Entries[index] = (USHORT)(outputX | (outputY << 8));
+	}
+}
+
+//
+// Evaluates a response curve for a normalized magnitude (0.0 = rest, 1.0 = fully engaged)
+// 
+static DOUBLE DS3_RESPONSE_CURVE_EVALUATE(
+	_In_ const DS_RESPONSE_CURVE* Curve,
+	_In_ DOUBLE Magnitude
+)
+{
+	if (Magnitude <= 0.0)
+	{
+		return 0.0;
+	}
+
+	const DOUBLE outer = (Curve->OuterDeadZone > 0.0)
+		? ((Curve->OuterDeadZone < 99.0) ? Curve->OuterDeadZone : 99.0) / 100.0
+		: 0.0;
+	const DOUBLE anti = (Curve->AntiDeadZone > 0.0)
+		? ((Curve->AntiDeadZone < 99.0) ? Curve->AntiDeadZone : 99.0) / 100.0
+		: 0.0;
+	const DOUBLE exponent = (Curve->Exponent > 0.0) ? Curve->Exponent : 1.0;
+
+	//
+	// Stretch the remaining travel so the outer dead-zone reports full engagement
+	// 
+	DOUBLE value = Magnitude / (1.0 - outer);
+
+	if (value > 1.0)
+	{
+		value = 1.0;
+	}
+
+	switch (Curve->Type)
+	{
+	case DsResponseCurveTypeExponential:
+		value = pow(value, exponent);
+		break;
+	case DsResponseCurveTypeSCurve:
+		{
+			const DOUBLE rising = pow(value, exponent);
+			const DOUBLE falling = pow(1.0 - value, exponent);
+
+			value = rising / (rising + falling);
+		}
+		break;
+	default:
+		break;
+	}
+
+	//
+	// Skip the start of the output range
+	// 
+	return anti + (1.0 - anti) * value;
+}
+
+//
+// Pre-computes a response curve for every possible raw value
+//   Centered values (thumb axes) are shaped symmetrically around 0x80,
+//   others (pressure) from 0x00 upwards
+// 
+void DS3_RESPONSE_CURVE_LUT_BUILD(
+	_Out_ PDS_RESPONSE_CURVE_LUT Table,
+	_In_ const DS_RESPONSE_CURVE* Curve,
+	_In_ const BOOLEAN IsCentered
+)
+{
+	for (LONG value = 0; value < (LONG)ARRAYSIZE(Table->Entries); value++)
+	{
+		if (IsCentered)
+		{
+			const LONG delta = value - 0x80;
+			const DOUBLE range = (delta < 0) ? 128.0 : 127.0;
+			const LONG shaped = (LONG)(DS3_RESPONSE_CURVE_EVALUATE(Curve, abs(delta) / range) * range + 0.5);
+
+			Table->Entries[value] = (UCHAR)((delta < 0) ? (0x80 - shaped) : (0x80 + shaped));
+		}
+		else
+		{
+			Table->Entries[value] = (UCHAR)(DS3_RESPONSE_CURVE_EVALUATE(Curve, value / 255.0) * 255.0 + 0.5);
+		}
+	}
+}
+
+static FORCEINLINE VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
 	_In_ const PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PUCHAR Output,
 	_In_ const DS_PRESSURE_EXPOSURE_MODE PressureMode,
 	_In_ const DS_DPAD_EXPOSURE_MODE DPadExposureMode,
-	_In_ const PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ const PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables
 )
 {
 	// Report ID
@@ -249,36 +387,7 @@ VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
 		// Translate D-Pad to HAT format
 		if ((DPadExposureMode & DsDPadExposureModeHAT) != 0)
 		{
-			switch (Input->Buttons.bButtons[0] & ~0xF)
-			{
-			case 0x10: // N
-				Output[5] |= 0 & 0xF;
-				break;
-			case 0x30: // NE
-				Output[5] |= 1 & 0xF;
-				break;
-			case 0x20: // E
-				Output[5] |= 2 & 0xF;
-				break;
-			case 0x60: // SE
-				Output[5] |= 3 & 0xF;
-				break;
-			case 0x40: // S
-				Output[5] |= 4 & 0xF;
-				break;
-			case 0xC0: // SW
-				Output[5] |= 5 & 0xF;
-				break;
-			case 0x80: // W
-				Output[5] |= 6 & 0xF;
-				break;
-			case 0x90: // NW
-				Output[5] |= 7 & 0xF;
-				break;
-			default: // Released
-				Output[5] |= 8 & 0xF;
-				break;
-			}
+			Output[5] |= G_DS3_DPAD_TO_HAT[DS3_RAW_DPAD_NIBBLE(Input)] & 0xF;
 		}
 		else {
 			// Clear HAT position
@@ -308,25 +417,19 @@ VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
 	Output[7] |= Input->Buttons.Individual.PS; // OUTPUT: PS BUTTON [0]
 
 	// Thumb axes
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Left,
 		Input->LeftThumbX,
 		Input->LeftThumbY,
 		&Output[1],
-		&Output[2],
-		ThumbSettings->DeadZoneLeft.Apply,
-		ThumbSettings->DeadZoneLeft.PolarValue,
-		FlipAxis->LeftX,
-		FlipAxis->LeftY
+		&Output[2]
 	);
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Right,
 		Input->RightThumbX,
 		Input->RightThumbY,
 		&Output[3],
-		&Output[4],
-		ThumbSettings->DeadZoneRight.Apply,
-		ThumbSettings->DeadZoneRight.PolarValue,
-		FlipAxis->RightX,
-		FlipAxis->RightY
+		&Output[4]
 	);
 
 	// Trigger axes
@@ -339,7 +442,7 @@ VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
 
 }
 
-VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_02(
+static FORCEINLINE VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_02(
 	_In_ const PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PUCHAR Output
 )
@@ -360,13 +463,12 @@ VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_02(
 	Output[8] = Input->Pressure.Values.Square;
 }
 
-VOID DS3_RAW_TO_SDF_HID_INPUT_REPORT(
+static FORCEINLINE VOID DS3_RAW_TO_SDF_HID_INPUT_REPORT(
 	_In_ const PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PUCHAR Output,
 	_In_ const DS_PRESSURE_EXPOSURE_MODE PressureMode,
 	_In_ const DS_DPAD_EXPOSURE_MODE DPadExposureMode,
-	_In_ const PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ const PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables
 )
 {
 	// Report ID
@@ -389,36 +491,7 @@ VOID DS3_RAW_TO_SDF_HID_INPUT_REPORT(
 		// Translate D-Pad to HAT format
 		if ((DPadExposureMode & DsDPadExposureModeHAT) != 0)
 		{
-			switch (Input->Buttons.bButtons[0] & ~0xF)
-			{
-			case 0x10: // N
-				Output[5] |= 0 & 0xF;
-				break;
-			case 0x30: // NE
-				Output[5] |= 1 & 0xF;
-				break;
-			case 0x20: // E
-				Output[5] |= 2 & 0xF;
-				break;
-			case 0x60: // SE
-				Output[5] |= 3 & 0xF;
-				break;
-			case 0x40: // S
-				Output[5] |= 4 & 0xF;
-				break;
-			case 0xC0: // SW
-				Output[5] |= 5 & 0xF;
-				break;
-			case 0x80: // W
-				Output[5] |= 6 & 0xF;
-				break;
-			case 0x90: // NW
-				Output[5] |= 7 & 0xF;
-				break;
-			default: // Released
-				Output[5] |= 8 & 0xF;
-				break;
-			}
+			Output[5] |= G_DS3_DPAD_TO_HAT[DS3_RAW_DPAD_NIBBLE(Input)] & 0xF;
 		}
 		else {
 			// Clear HAT position
@@ -444,25 +517,19 @@ VOID DS3_RAW_TO_SDF_HID_INPUT_REPORT(
 	}
 	
 	// Thumb axes
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Left,
 		Input->LeftThumbX,
 		Input->LeftThumbY,
 		&Output[1],
-		&Output[2],
-		ThumbSettings->DeadZoneLeft.Apply,
-		ThumbSettings->DeadZoneLeft.PolarValue,
-		FlipAxis->LeftX,
-		FlipAxis->LeftY
+		&Output[2]
 	);
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Right,
 		Input->RightThumbX,
 		Input->RightThumbY,
 		&Output[3],
-		&Output[4],
-		ThumbSettings->DeadZoneRight.Apply,
-		ThumbSettings->DeadZoneRight.PolarValue,
-		FlipAxis->RightX,
-		FlipAxis->RightY
+		&Output[4]
 	);
 
 	// Trigger axes
@@ -492,68 +559,32 @@ VOID DS3_RAW_TO_SDF_HID_INPUT_REPORT(
 	}
 }
 
-VOID DS3_RAW_TO_SIXAXIS_HID_INPUT_REPORT(
+static FORCEINLINE VOID DS3_RAW_TO_SIXAXIS_HID_INPUT_REPORT(
 	_In_ const PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PUCHAR Output,
-	_In_ const PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ const PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables
 )
 {
 	// Prepare D-Pad
 	Output[3] &= ~0xF; // Clear lower 4 bits
 
 	// Translate D-Pad to HAT format
-	switch (Input->Buttons.bButtons[0] & ~0xF)
-	{
-	case 0x10: // N
-		Output[3] |= 0 & 0xF;
-		break;
-	case 0x30: // NE
-		Output[3] |= 1 & 0xF;
-		break;
-	case 0x20: // E
-		Output[3] |= 2 & 0xF;
-		break;
-	case 0x60: // SE
-		Output[3] |= 3 & 0xF;
-		break;
-	case 0x40: // S
-		Output[3] |= 4 & 0xF;
-		break;
-	case 0xC0: // SW
-		Output[3] |= 5 & 0xF;
-		break;
-	case 0x80: // W
-		Output[3] |= 6 & 0xF;
-		break;
-	case 0x90: // NW
-		Output[3] |= 7 & 0xF;
-		break;
-	default: // Released
-		Output[3] |= 8 & 0xF;
-		break;
-	}
+	Output[3] |= G_DS3_DPAD_TO_HAT[DS3_RAW_DPAD_NIBBLE(Input)] & 0xF;
 
 	// Thumb axes
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Left,
 		Input->LeftThumbX,
 		Input->LeftThumbY,
 		&Output[4],
-		&Output[5],
-		ThumbSettings->DeadZoneLeft.Apply,
-		ThumbSettings->DeadZoneLeft.PolarValue,
-		FlipAxis->LeftX,
-		FlipAxis->LeftY
+		&Output[5]
 	);
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Right,
 		Input->RightThumbX,
 		Input->RightThumbY,
 		&Output[6],
-		&Output[7],
-		ThumbSettings->DeadZoneRight.Apply,
-		ThumbSettings->DeadZoneRight.PolarValue,
-		FlipAxis->RightX,
-		FlipAxis->RightY
+		&Output[7]
 	);
 
 	// Buttons
@@ -593,12 +624,91 @@ UCHAR REVERSE_BITS(_In_ UCHAR x)
 	return x;
 }
 
-VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
+//
+// Maps one DS3 motion sensor onto a DS4 motion axis
+//   Source indexes the (byte-swapped) AccelerometerX/Y/Z and Gyroscope fields,
+//   Scale is a signed Q8 factor from DS3 counts to DS4 counts, 0 leaves the axis centered
+// 
+typedef struct _DS3_TO_DS4_MOTION_AXIS
+{
+	UCHAR Source;
+
+	SHORT Bias;
+
+	LONG Scale;
+
+} DS3_TO_DS4_MOTION_AXIS;
+
+//
+// DS3 to DS4 motion coordinate space, in DS4 report order (gyro pitch, yaw, roll, accel X, Y, Z)
+//   The DS3 reports gravity on its Z axis while resting flat, the DS4 on its Y axis
+//   The gyroscope bias has already been removed by the motion pipeline once calibrated
+// 
+static CONST DS3_TO_DS4_MOTION_AXIS G_DS3_TO_DS4_MOTION_AXES[6] =
+{
+	{ 0, 0, 0 },	// Gyro pitch (not available)
+	{ 3, DS3_MOTION_GYROSCOPE_CENTER, -DS3_MOTION_GYROSCOPE_SCALE_Q8 },	// Gyro yaw
+	{ 0, 0, 0 },	// Gyro roll (not available)
+	{ 0, DS3_MOTION_ACCELEROMETER_CENTER, -DS3_MOTION_ACCELEROMETER_SCALE_Q8 },	// Accelerometer X
+	{ 2, DS3_MOTION_ACCELEROMETER_CENTER, DS3_MOTION_ACCELEROMETER_SCALE_Q8 },	// Accelerometer Y
+	{ 1, DS3_MOTION_ACCELEROMETER_CENTER, -DS3_MOTION_ACCELEROMETER_SCALE_Q8 },	// Accelerometer Z
+};
+
+//
+// Fills the DS4 gyroscope and accelerometer fields (little-endian INT16 at offset 13 to 24)
+// 
+static FORCEINLINE VOID DS3_RAW_TO_DS4_MOTION(
+	_In_ const PDS3_RAW_INPUT_REPORT Input,
+	_Out_ PUCHAR Output
+)
+{
+	const LONG sensors[4] =
+	{
+		_byteswap_ushort(Input->AccelerometerX) & 0x3FF,
+		_byteswap_ushort(Input->AccelerometerY) & 0x3FF,
+		_byteswap_ushort(Input->AccelerometerZ) & 0x3FF,
+		_byteswap_ushort(Input->Gyroscope) & 0x3FF
+	};
+
+	for (ULONG axis = 0; axis < ARRAYSIZE(G_DS3_TO_DS4_MOTION_AXES); axis++)
+	{
+		const DS3_TO_DS4_MOTION_AXIS* pAxis = &G_DS3_TO_DS4_MOTION_AXES[axis];
+		LONG value = ((sensors[pAxis->Source] - pAxis->Bias) * pAxis->Scale) >> 8;
+
+		value = (value > 0x7FFF) ? 0x7FFF : (value < -0x8000) ? -0x8000 : value;
+
+		Output[13 + (axis * 2)] = (UCHAR)(value & 0xFF);
+		Output[14 + (axis * 2)] = (UCHAR)((value >> 8) & 0xFF);
+	}
+}
+
+//
+// Current time in DS4 sensor timestamp units (16/3 microseconds), wraps like the original
+// 
+static FORCEINLINE USHORT DS4_SENSOR_TIMESTAMP_NOW(
+	_In_ const PLARGE_INTEGER PerformanceFrequency
+)
+{
+	LARGE_INTEGER now;
+
+	QueryPerformanceCounter(&now);
+
+	//
+	// 187500 units per second, split to not overflow on long uptimes
+	// 
+	const ULONGLONG freq = (ULONGLONG)PerformanceFrequency->QuadPart;
+	const ULONGLONG seconds = (ULONGLONG)now.QuadPart / freq;
+	const ULONGLONG remainder = (ULONGLONG)now.QuadPart % freq;
+
+	return (USHORT)((seconds * 187500) + ((remainder * 187500) / freq));
+}
+
+static FORCEINLINE VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
 	_In_ const PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PUCHAR Output,
 	_In_ const BOOLEAN IsWired,
-	_In_ const PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ const PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ const PLARGE_INTEGER PerformanceFrequency
 )
 {
 	// Report ID
@@ -613,8 +723,8 @@ VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
 	// Remaining buttons
 	Output[6] &= ~0xFF; // Clear all 8 bits
 
-	// PS button
-	Output[7] &= ~0x01; // Clear button bit
+	// Frame counter (upper 6 bits) gets stamped on delivery, clear PS and touchpad click bits
+	Output[7] &= 0xFC;
 
 	// Battery + cable info
 	Output[30] &= ~0xF; // Clear lower 4 bits
@@ -628,36 +738,7 @@ VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
 	Output[48] |= 0x80; // Set top bit to disable finger contact
 
 	// Translate D-Pad to HAT format
-	switch (Input->Buttons.bButtons[0] & ~0xF)
-	{
-	case 0x10: // N
-		Output[5] |= 0 & 0xF;
-		break;
-	case 0x30: // NE
-		Output[5] |= 1 & 0xF;
-		break;
-	case 0x20: // E
-		Output[5] |= 2 & 0xF;
-		break;
-	case 0x60: // SE
-		Output[5] |= 3 & 0xF;
-		break;
-	case 0x40: // S
-		Output[5] |= 4 & 0xF;
-		break;
-	case 0xC0: // SW
-		Output[5] |= 5 & 0xF;
-		break;
-	case 0x80: // W
-		Output[5] |= 6 & 0xF;
-		break;
-	case 0x90: // NW
-		Output[5] |= 7 & 0xF;
-		break;
-	default: // Released
-		Output[5] |= 8 & 0xF;
-		break;
-	}
+	Output[5] |= G_DS3_DPAD_TO_HAT[DS3_RAW_DPAD_NIBBLE(Input)] & 0xF;
 
 	// Face buttons
 	Output[5] |= ((REVERSE_BITS(Input->Buttons.bButtons[1]) << 4) & 0xF0);
@@ -679,25 +760,19 @@ VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
 	Output[6] |= (((Input->Buttons.bButtons[0] >> 2) & 0x01) << 7);
 
 	// Thumb axes
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Left,
 		Input->LeftThumbX,
 		Input->LeftThumbY,
 		&Output[1],
-		&Output[2],
-		ThumbSettings->DeadZoneLeft.Apply,
-		ThumbSettings->DeadZoneLeft.PolarValue,
-		FlipAxis->LeftX,
-		FlipAxis->LeftY
+		&Output[2]
 	);
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Right,
 		Input->RightThumbX,
 		Input->RightThumbY,
 		&Output[3],
-		&Output[4],
-		ThumbSettings->DeadZoneRight.Apply,
-		ThumbSettings->DeadZoneRight.PolarValue,
-		FlipAxis->RightX,
-		FlipAxis->RightY
+		&Output[4]
 	);
 
 	// Trigger axes
@@ -707,6 +782,14 @@ VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
 	// PS button
 	Output[7] |= Input->Buttons.Individual.PS;
 
+	// Sensor timestamp
+	const USHORT timestamp = DS4_SENSOR_TIMESTAMP_NOW(PerformanceFrequency);
+	Output[10] = (UCHAR)(timestamp & 0xFF);
+	Output[11] = (UCHAR)(timestamp >> 8);
+
+	// Gyroscope and accelerometer
+	DS3_RAW_TO_DS4_MOTION(Input, Output);
+
 	// Battery translation when IsWired = 0: ( Value * 100 ) / 8
 	// Battery translation when IsWired = 1: ( Value * 100 ) / 11
 	if (IsWired)
@@ -752,11 +835,10 @@ VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
 	}
 }
 
-VOID DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(
+static FORCEINLINE VOID DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(
 	_In_ const PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PXINPUT_HID_INPUT_REPORT Output,
-	_In_ const PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ const PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables
 )
 {
 	UCHAR leftThumbX = Input->LeftThumbX;
@@ -767,25 +849,19 @@ VOID DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(
 	//
 	// Thumb axes
 	// 
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Left,
 		Input->LeftThumbX,
 		Input->LeftThumbY,
 		&leftThumbX,
-		&leftThumbY,
-		ThumbSettings->DeadZoneLeft.Apply,
-		ThumbSettings->DeadZoneLeft.PolarValue,
-		FlipAxis->LeftX,
-		FlipAxis->LeftY
+		&leftThumbY
 	);
-	DS3_RAW_AXIS_TRANSFORM(
+	DS3_THUMB_AXIS_LUT_APPLY(
+		&ThumbTables->Right,
 		Input->RightThumbX,
 		Input->RightThumbY,
 		&rightThumbX,
-		&rightThumbY,
-		ThumbSettings->DeadZoneRight.Apply,
-		ThumbSettings->DeadZoneRight.PolarValue,
-		FlipAxis->RightX,
-		FlipAxis->RightY
+		&rightThumbY
 	);
 	Output->GD_GamePadX = leftThumbX * 257;
 	Output->GD_GamePadY = leftThumbY * 257;
@@ -827,36 +903,244 @@ VOID DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(
 	// 
 	// D-Pad (POV/HAT format)
 	// 
-	switch (Input->Buttons.bButtons[0] & ~0xF)
+	Output->GD_GamePadHatSwitch = G_DS3_DPAD_TO_HAT_ONE_BASED[DS3_RAW_DPAD_NIBBLE(Input)];
+
+	Output->GD_GamePadSystemControlSystemMainMenu = Input->Buttons.Individual.PS;
+}
+
+#pragma region Specialized input report converters
+
+//
+// Generates a converter variant with pressure and D-Pad exposure modes
+// fixed at compile time, so the conditional packing paths get folded
+// 
+#define DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, _pressure_, _dpad_) \
+	static EVT_DS3_RAW_TO_HID_INPUT_REPORT _prefix_##_P##_pressure_##_D##_dpad_; \
+	static VOID _prefix_##_P##_pressure_##_D##_dpad_( \
+		_In_ const PDS3_RAW_INPUT_REPORT Input, \
+		_Out_ PUCHAR Output, \
+		_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables, \
+		_In_ const PLARGE_INTEGER PerformanceFrequency \
+	) \
+	{ \
+		UNREFERENCED_PARAMETER(PerformanceFrequency); \
+		\
+		_generic_( \
+			Input, \
+			Output, \
+			(DS_PRESSURE_EXPOSURE_MODE)(_pressure_), \
+			(DS_DPAD_EXPOSURE_MODE)(_dpad_), \
+			ThumbTables \
+		); \
+	}
+
+//
+// Generates all combinations of the pressure and D-Pad exposure flags
+// 
+#define DS3_DEFINE_PRESSURE_DPAD_CONVERTERS(_generic_, _prefix_) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 0, 0) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 0, 1) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 0, 2) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 0, 3) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 1, 0) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 1, 1) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 1, 2) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 1, 3) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 2, 0) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 2, 1) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 2, 2) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 2, 3) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 3, 0) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 3, 1) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 3, 2) \
+	DS3_DEFINE_PRESSURE_DPAD_CONVERTER(_generic_, _prefix_, 3, 3)
+
+//
+// Lookup table of variants, indexed by [PressureExposureMode][DPadExposureMode]
+// 
+#define DS3_PRESSURE_DPAD_CONVERTER_TABLE(_prefix_) \
+	{ \
+		{ _prefix_##_P0_D0, _prefix_##_P0_D1, _prefix_##_P0_D2, _prefix_##_P0_D3 }, \
+		{ _prefix_##_P1_D0, _prefix_##_P1_D1, _prefix_##_P1_D2, _prefix_##_P1_D3 }, \
+		{ _prefix_##_P2_D0, _prefix_##_P2_D1, _prefix_##_P2_D2, _prefix_##_P2_D3 }, \
+		{ _prefix_##_P3_D0, _prefix_##_P3_D1, _prefix_##_P3_D2, _prefix_##_P3_D3 }, \
+	}
+
+DS3_DEFINE_PRESSURE_DPAD_CONVERTERS(DS3_RAW_TO_SDF_HID_INPUT_REPORT, DS3_RAW_TO_SDF)
+
+DS3_DEFINE_PRESSURE_DPAD_CONVERTERS(DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01, DS3_RAW_TO_GPJ_01)
+
+static CONST PFN_DS3_RAW_TO_HID_INPUT_REPORT G_Ds3SdfConverters[4][4] =
+	DS3_PRESSURE_DPAD_CONVERTER_TABLE(DS3_RAW_TO_SDF);
+
+static CONST PFN_DS3_RAW_TO_HID_INPUT_REPORT G_Ds3GpjConverters[4][4] =
+	DS3_PRESSURE_DPAD_CONVERTER_TABLE(DS3_RAW_TO_GPJ_01);
+
+static EVT_DS3_RAW_TO_HID_INPUT_REPORT DS3_RAW_TO_GPJ_02;
+static VOID DS3_RAW_TO_GPJ_02(
+	_In_ const PDS3_RAW_INPUT_REPORT Input,
+	_Out_ PUCHAR Output,
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ const PLARGE_INTEGER PerformanceFrequency
+)
+{
+	UNREFERENCED_PARAMETER(ThumbTables);
+	UNREFERENCED_PARAMETER(PerformanceFrequency);
+
+	DS3_RAW_TO_GPJ_HID_INPUT_REPORT_02(Input, Output);
+}
+
+static EVT_DS3_RAW_TO_HID_INPUT_REPORT DS3_RAW_TO_SIXAXIS;
+static VOID DS3_RAW_TO_SIXAXIS(
+	_In_ const PDS3_RAW_INPUT_REPORT Input,
+	_Out_ PUCHAR Output,
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ const PLARGE_INTEGER PerformanceFrequency
+)
+{
+	UNREFERENCED_PARAMETER(PerformanceFrequency);
+
+	DS3_RAW_TO_SIXAXIS_HID_INPUT_REPORT(Input, Output, ThumbTables);
+}
+
+static EVT_DS3_RAW_TO_HID_INPUT_REPORT DS3_RAW_TO_DS4WINDOWS_WIRED;
+static VOID DS3_RAW_TO_DS4WINDOWS_WIRED(
+	_In_ const PDS3_RAW_INPUT_REPORT Input,
+	_Out_ PUCHAR Output,
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ const PLARGE_INTEGER PerformanceFrequency
+)
+{
+	DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(Input, Output, TRUE, ThumbTables, PerformanceFrequency);
+}
+
+static EVT_DS3_RAW_TO_HID_INPUT_REPORT DS3_RAW_TO_DS4WINDOWS_WIRELESS;
+static VOID DS3_RAW_TO_DS4WINDOWS_WIRELESS(
+	_In_ const PDS3_RAW_INPUT_REPORT Input,
+	_Out_ PUCHAR Output,
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ const PLARGE_INTEGER PerformanceFrequency
+)
+{
+	DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(Input, Output, FALSE, ThumbTables, PerformanceFrequency);
+}
+
+static EVT_DS3_RAW_TO_HID_INPUT_REPORT DS3_RAW_TO_XINPUTHID;
+static VOID DS3_RAW_TO_XINPUTHID(
+	_In_ const PDS3_RAW_INPUT_REPORT Input,
+	_Out_ PUCHAR Output,
+	_In_ const PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ const PLARGE_INTEGER PerformanceFrequency
+)
+{
+	UNREFERENCED_PARAMETER(PerformanceFrequency);
+
+	// ReSharper disable once CppRedundantCastExpression
+	DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(Input, (PXINPUT_HID_INPUT_REPORT)Output, ThumbTables);
+}
+
+//
+// Picks the converter variants matching the provided configuration
+// 
+VOID DS3_SELECT_HID_INPUT_REPORT_CONVERTERS(
+	_In_ const PDS_DRIVER_CONFIGURATION Configuration,
+	_In_ const BOOLEAN IsWired,
+	_Out_ PFN_DS3_RAW_TO_HID_INPUT_REPORT* Primary,
+	_Out_ PFN_DS3_RAW_TO_HID_INPUT_REPORT* Secondary
+)
+{
+	*Primary = NULL;
+	*Secondary = NULL;
+
+	switch (Configuration->HidDeviceMode) // NOLINT(clang-diagnostic-switch-enum)
 	{
-	case 0x10: // N
-		Output->GD_GamePadHatSwitch = 1;
-		break;
-	case 0x30: // NE
-		Output->GD_GamePadHatSwitch = 2;
-		break;
-	case 0x20: // E
-		Output->GD_GamePadHatSwitch = 3;
+	case DsHidMiniDeviceModeSDF:
+		*Primary = G_Ds3SdfConverters
+			[Configuration->SDF.PressureExposureMode & 0x3]
+			[Configuration->SDF.DPadExposureMode & 0x3];
 		break;
-	case 0x60: // SE
-		Output->GD_GamePadHatSwitch = 4;
-		break;
-	case 0x40: // S
-		Output->GD_GamePadHatSwitch = 5;
+	case DsHidMiniDeviceModeGPJ:
+		*Primary = G_Ds3GpjConverters
+			[Configuration->GPJ.PressureExposureMode & 0x3]
+			[Configuration->GPJ.DPadExposureMode & 0x3];
+
+		//
+		// Pressure values are exposed in a separate report
+		// 
+		if ((Configuration->GPJ.PressureExposureMode & DsPressureExposureModeAnalogue) != 0)
+		{
+			*Secondary = DS3_RAW_TO_GPJ_02;
+		}
 		break;
-	case 0xC0: // SW
-		Output->GD_GamePadHatSwitch = 6;
+	case DsHidMiniDeviceModeSixaxisCompatible:
+		*Primary = DS3_RAW_TO_SIXAXIS;
 		break;
-	case 0x80: // W
-		Output->GD_GamePadHatSwitch = 7;
+	case DsHidMiniDeviceModeDS4WindowsCompatible:
+		*Primary = IsWired ? DS3_RAW_TO_DS4WINDOWS_WIRED : DS3_RAW_TO_DS4WINDOWS_WIRELESS;
 		break;
-	case 0x90: // NW
-		Output->GD_GamePadHatSwitch = 8;
+	case DsHidMiniDeviceModeXInputHIDCompatible:
+		*Primary = DS3_RAW_TO_XINPUTHID;
 		break;
-	default: // Released
-		Output->GD_GamePadHatSwitch = 0;
+	default:
 		break;
 	}
+}
 
-	Output->GD_GamePadSystemControlSystemMainMenu = Input->Buttons.Individual.PS;
+//
+// Size of the input report(s) exposed in the provided mode, 0 if unsupported
+// 
+ULONG DS3_GET_HID_INPUT_REPORT_SIZE(
+	_In_ DS_HID_DEVICE_MODE Mode
+)
+{
+	switch (Mode) // NOLINT(clang-diagnostic-switch-enum)
+	{
+	case DsHidMiniDeviceModeSDF:
+	case DsHidMiniDeviceModeGPJ:
+		return DS3_SDF_GPJ_HID_INPUT_REPORT_SIZE;
+	case DsHidMiniDeviceModeSixaxisCompatible:
+		return SIXAXIS_HID_INPUT_REPORT_SIZE;
+	case DsHidMiniDeviceModeDS4WindowsCompatible:
+		return DS3_DS4REV1_USB_HID_INPUT_REPORT_SIZE;
+	case DsHidMiniDeviceModeXInputHIDCompatible:
+		return XINPUTHID_HID_INPUT_REPORT_SIZE;
+	case DsHidMiniDeviceModeRaw:
+		return RAW_PASSTHROUGH_HID_INPUT_REPORT_SIZE;
+	default:
+		return 0;
+	}
 }
+
+//
+// Builds the mask of report bits reflecting controller state, stamped bits changing with every
+// report are cleared so they don't defeat change detection. Returns TRUE if any bit got cleared.
+// 
+BOOLEAN DS3_GET_HID_INPUT_REPORT_COMPARE_MASK(
+	_In_ DS_HID_DEVICE_MODE Mode,
+	_Out_writes_(DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE) PUCHAR Mask
+)
+{
+	RtlFillMemory(Mask, DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE, 0xFF);
+
+	switch (Mode) // NOLINT(clang-diagnostic-switch-enum)
+	{
+	case DsHidMiniDeviceModeDS4WindowsCompatible:
+		// Frame counter (upper 6 bits), PS and touchpad click remain
+		Mask[7] = 0x03;
+		// Sensor timestamp
+		Mask[10] = 0x00;
+		Mask[11] = 0x00;
+		return TRUE;
+	case DsHidMiniDeviceModeRaw:
+		// Sequence number and arrival time
+		RtlZeroMemory(
+			&Mask[FIELD_OFFSET(DS3_RAW_PASSTHROUGH_HID_INPUT_REPORT, SequenceNumber)],
+			RAW_PASSTHROUGH_HID_INPUT_REPORT_SIZE - FIELD_OFFSET(DS3_RAW_PASSTHROUGH_HID_INPUT_REPORT, SequenceNumber)
+		);
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
+
+#pragma endregion
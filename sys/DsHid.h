@@ -22,12 +22,17 @@ extern CONST HID_REPORT_DESCRIPTOR G_XInputHIDCompatible_HidReportDescriptor[];
 
 extern CONST HID_DESCRIPTOR G_XInputHIDCompatible_HidDescriptor;
 
+extern CONST HID_REPORT_DESCRIPTOR G_RawPassthrough_HidReportDescriptor[];
+
+extern CONST HID_DESCRIPTOR G_RawPassthrough_HidDescriptor;
+
 #define DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE	0x40
 #define DS3_DS4REV1_USB_HID_INPUT_REPORT_SIZE	DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE
 #define DS3_SDF_GPJ_HID_INPUT_REPORT_SIZE		0x27
 #define SIXAXIS_HID_INPUT_REPORT_SIZE			0x0C
 #define SIXAXIS_HID_GET_FEATURE_REPORT_SIZE		0x31
 #define XINPUTHID_HID_INPUT_REPORT_SIZE			0x11
+#define RAW_PASSTHROUGH_HID_INPUT_REPORT_SIZE	sizeof(DS3_RAW_PASSTHROUGH_HID_INPUT_REPORT)
 
 #define DS3_RAW_SLIDER_IDLE_THRESHOLD			0x7F // 127 ( (256 * 0,5 ) -1 )
 #define DS3_RAW_AXIS_IDLE_THRESHOLD_LOWER		0x3F // 63 ( ( 128 * 0,5 ) - 1 )
@@ -52,49 +57,110 @@ void DS3_RAW_AXIS_TRANSFORM(
 	_In_ BOOLEAN FlipY
 );
 
-VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
-	_In_ PDS3_RAW_INPUT_REPORT Input,
-	_Out_ PUCHAR Output,
-	_In_ DS_PRESSURE_EXPOSURE_MODE PressureMode,
-	_In_ DS_DPAD_EXPOSURE_MODE DPadExposureMode,
-	_In_ PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ PDS_FLIP_AXIS_SETTINGS FlipAxis
-);
-
-VOID DS3_RAW_TO_GPJ_HID_INPUT_REPORT_02(
-	_In_ PDS3_RAW_INPUT_REPORT Input,
-	_Out_ PUCHAR Output
+void DS3_THUMB_AXIS_LUT_BUILD(
+	_Out_ PDS_THUMB_AXIS_LUT Table,
+	_In_ PDS_AXIS_DEADZONE DeadZone,
+	_In_ BOOLEAN FlipX,
+	_In_ BOOLEAN FlipY,
+	_In_ const DS_RESPONSE_CURVE_LUT* CurveX,
+	_In_ const DS_RESPONSE_CURVE_LUT* CurveY
 );
 
-VOID DS3_RAW_TO_SDF_HID_INPUT_REPORT(
-	_In_ PDS3_RAW_INPUT_REPORT Input,
-	_Out_ PUCHAR Output,
-	_In_ DS_PRESSURE_EXPOSURE_MODE PressureMode,
-	_In_ DS_DPAD_EXPOSURE_MODE DPadExposureMode,
-	_In_ PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ PDS_FLIP_AXIS_SETTINGS FlipAxis
+void DS3_RESPONSE_CURVE_LUT_BUILD(
+	_Out_ PDS_RESPONSE_CURVE_LUT Table,
+	_In_ const DS_RESPONSE_CURVE* Curve,
+	_In_ BOOLEAN IsCentered
 );
 
-VOID DS3_RAW_TO_SIXAXIS_HID_INPUT_REPORT(
+//
+// Fetches the pre-computed transformation of a thumb axis pair
+// 
+VOID
+FORCEINLINE
+DS3_THUMB_AXIS_LUT_APPLY(
+	_In_ const DS_THUMB_AXIS_LUT* Table,
+	_In_ UCHAR InputX,
+	_In_ UCHAR InputY,
+	_Out_ PUCHAR OutputX,
+	_Out_ PUCHAR OutputY
+)
+{
+	const USHORT entry = Table->Entries[(USHORT)(InputY << 8) | InputX];
+
+	*OutputX = (UCHAR)(entry & 0xFF);
+	*OutputY = (UCHAR)(entry >> 8);
+}
+
+//
+// Applies the pre-computed response curves to all pressure channels of a raw input report
+// 
+VOID
+FORCEINLINE
+DS3_PRESSURE_LUT_APPLY(
+	_In_ const DS_PRESSURE_LOOKUP_TABLES* Tables,
+	_Inout_ PDS3_RAW_INPUT_REPORT Report
+)
+{
+	for (ULONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+	{
+		Report->Pressure.bValues[channel] = Tables->Channels[channel].Entries[Report->Pressure.bValues[channel]];
+	}
+}
+
+//
+// Holds each pressure channel at its last reported value until it moved further than the
+// channel threshold; fully released and fully engaged values always pass through
+//   Kept branch-free so the compiler can vectorize the 12 byte compare/select
+// 
+VOID
+FORCEINLINE
+DS3_PRESSURE_NOISE_GATE_APPLY(
+	_In_ const UCHAR* Thresholds,
+	_Inout_ PUCHAR HeldValues,
+	_Inout_ PDS3_RAW_INPUT_REPORT Report
+)
+{
+	for (ULONG channel = 0; channel < DS_PRESSURE_CHANNEL_COUNT; channel++)
+	{
+		const UCHAR raw = Report->Pressure.bValues[channel];
+		const UCHAR held = HeldValues[channel];
+		const UCHAR delta = (raw > held) ? (UCHAR)(raw - held) : (UCHAR)(held - raw);
+		const BOOLEAN pass = (delta > Thresholds[channel]) | (raw == 0x00) | (raw == 0xFF);
+
+		HeldValues[channel] = pass ? raw : held;
+		Report->Pressure.bValues[channel] = HeldValues[channel];
+	}
+}
+
+//
+// Converts a raw input report into a HID device mode specific input report
+// 
+typedef
+_Function_class_(EVT_DS3_RAW_TO_HID_INPUT_REPORT)
+VOID
+EVT_DS3_RAW_TO_HID_INPUT_REPORT(
 	_In_ PDS3_RAW_INPUT_REPORT Input,
 	_Out_ PUCHAR Output,
-	_In_ PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_In_ PDS_THUMB_LOOKUP_TABLES ThumbTables,
+	_In_ PLARGE_INTEGER PerformanceFrequency
 );
 
-UCHAR REVERSE_BITS(_In_ UCHAR x);
+typedef EVT_DS3_RAW_TO_HID_INPUT_REPORT* PFN_DS3_RAW_TO_HID_INPUT_REPORT;
 
-VOID DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
-	_In_ PDS3_RAW_INPUT_REPORT Input,
-	_Out_ PUCHAR Output,
+VOID DS3_SELECT_HID_INPUT_REPORT_CONVERTERS(
+	_In_ PDS_DRIVER_CONFIGURATION Configuration,
 	_In_ BOOLEAN IsWired,
-	_In_ PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ PDS_FLIP_AXIS_SETTINGS FlipAxis
+	_Out_ PFN_DS3_RAW_TO_HID_INPUT_REPORT* Primary,
+	_Out_ PFN_DS3_RAW_TO_HID_INPUT_REPORT* Secondary
 );
 
-VOID DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(
-	_In_ PDS3_RAW_INPUT_REPORT Input,
-	_Out_ PXINPUT_HID_INPUT_REPORT Output,
-	_In_ PDS_THUMB_SETTINGS ThumbSettings,
-	_In_ PDS_FLIP_AXIS_SETTINGS FlipAxis
+ULONG DS3_GET_HID_INPUT_REPORT_SIZE(
+	_In_ DS_HID_DEVICE_MODE Mode
+);
+
+BOOLEAN DS3_GET_HID_INPUT_REPORT_COMPARE_MASK(
+	_In_ DS_HID_DEVICE_MODE Mode,
+	_Out_writes_(DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE) PUCHAR Mask
 );
+
+UCHAR REVERSE_BITS(_In_ UCHAR x);
@@ -431,6 +431,14 @@ DMF_DsHidMini_Open(
 		pHidCfg->HidDeviceAttributes.ProductID = pDevCtx->ProductId;
 		pHidCfg->HidDeviceAttributes.VersionNumber = pDevCtx->VersionNumber;
 
+		break;
+	case DsHidMiniDeviceModeRaw:
+
+		pHidCfg->HidDescriptor = &G_RawPassthrough_HidDescriptor;
+		pHidCfg->HidDescriptorLength = sizeof(G_RawPassthrough_HidDescriptor);
+		pHidCfg->HidReportDescriptor = G_RawPassthrough_HidReportDescriptor;
+		pHidCfg->HidReportDescriptorLength = G_RawPassthrough_HidDescriptor.DescriptorList[0].wReportLength;
+
 		break;
 	default:
 
@@ -514,31 +522,47 @@ DsHidMini_RetrieveNextInputReport(
 	DMF_CONTEXT_DsHidMini* moduleContext = DMF_CONTEXT_GET(dmfModuleParent);
 	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(DMF_ParentDeviceGet(DmfModule));
 
-	*Buffer = moduleContext->InputReport;
+	//
+	// Buffered reports are handed out first, oldest to newest
+	//   Every InputReportGenerate call site holds the backlog lock
+	// 
+	if (pDevCtx->InputReportBacklog.Count > 0)
+	{
+		*Buffer = pDevCtx->InputReportBacklog.Reports[pDevCtx->InputReportBacklog.Head];
 
-	switch (pDevCtx->Configuration.HidDeviceMode)  // NOLINT(clang-diagnostic-switch-enum)
+		pDevCtx->InputReportBacklog.Head =
+			(pDevCtx->InputReportBacklog.Head + 1) % DS_INPUT_REPORT_BACKLOG_MAX_DEPTH;
+		pDevCtx->InputReportBacklog.Count--;
+	}
+	else
+	{
+		*Buffer = moduleContext->InputReport;
+	}
+
+	//
+	// Counters are stamped here so skipped, held back or dropped reports don't advance them
+	// 
+	if (pDevCtx->Configuration.HidDeviceMode == DsHidMiniDeviceModeDS4WindowsCompatible)
+	{
+		moduleContext->Ds4FrameCounter = (moduleContext->Ds4FrameCounter + 1) & 0x3F;
+
+		(*Buffer)[7] = (UCHAR)(((*Buffer)[7] & 0x03) | (moduleContext->Ds4FrameCounter << 2));
+	}
+	else if (pDevCtx->Configuration.HidDeviceMode == DsHidMiniDeviceModeRaw)
+	{
+		((PDS3_RAW_PASSTHROUGH_HID_INPUT_REPORT)*Buffer)->SequenceNumber = ++moduleContext->RawReportSequence;
+	}
+
+	*BufferSize = pDevCtx->InputReportConverters.ReportLength;
+
+	if (*BufferSize == 0)
 	{
-	case DsHidMiniDeviceModeSDF:
-	case DsHidMiniDeviceModeGPJ:
-		*BufferSize = DS3_SDF_GPJ_HID_INPUT_REPORT_SIZE;
-		break;
-	case DsHidMiniDeviceModeSixaxisCompatible:
-		*BufferSize = SIXAXIS_HID_INPUT_REPORT_SIZE;
-		break;
-	case DsHidMiniDeviceModeDS4WindowsCompatible:
-		*BufferSize = DS3_DS4REV1_USB_HID_INPUT_REPORT_SIZE;
-		break;
-	case DsHidMiniDeviceModeXInputHIDCompatible:
-		*BufferSize = XINPUTHID_HID_INPUT_REPORT_SIZE;
-		break;
-	default:
 		TraceError(
 			TRACE_DSHIDMINIDRV,
 			"Unsupported HID device mode: 0x%04X",
 			pDevCtx->Configuration.HidDeviceMode
 		);
 		status = STATUS_INVALID_PARAMETER;
-		break;
 	}
 
 	/*
@@ -576,6 +600,126 @@ DSHM_ProcessHidInputReport(
 	FuncExitNoReturn(TRACE_DSHIDMINIDRV);
 }
 
+//
+// Feeds the arrival of a new input report into the inter-arrival statistics
+// 
+static
+void
+DSHM_RecordInputReportArrival(
+	_In_ PDEVICE_CONTEXT Context
+)
+{
+	LARGE_INTEGER now;
+
+	QueryPerformanceCounter(&now);
+
+	const ULONGLONG freq = (ULONGLONG)Context->PerformanceFrequency.QuadPart;
+	const ULONGLONG timestamp = (((ULONGLONG)now.QuadPart / freq) * 1000000)
+		+ ((((ULONGLONG)now.QuadPart % freq) * 1000000) / freq);
+
+	DS_INPUT_INTERVAL_UPDATE(&Context->InputInterval.Stats, timestamp);
+}
+
+//
+// Toggles alternative rumble mode and indicates the change with a short rumble
+// 
+static void
+DSHM_ToggleAlternativeRumbleMode(
+	_In_ PDEVICE_CONTEXT DeviceContext
+)
+{
+	TraceEvents(TRACE_LEVEL_INFORMATION,
+		TRACE_DSHIDMINIDRV,
+		"!! Toggling alternative rumble mode"
+	);
+	DeviceContext->RumbleControlState.AltMode.IsEnabled = !DeviceContext->RumbleControlState.AltMode.IsEnabled;
+
+	//
+	// Send rumble feedback to indicate change in rumble mode
+	//
+	DS3_SET_LARGE_RUMBLE_DURATION(DeviceContext, 0x30);
+	DS3_SET_SMALL_RUMBLE_DURATION(DeviceContext, 0x20);
+	DS3_SET_BOTH_RUMBLE_STRENGTH(DeviceContext, 0x00, 0xFF);
+	(void)DSHM_SendOutputReport(DeviceContext, Ds3OutputReportSourceDriverLowPriority);
+
+	//
+	// Restore default rumble duration
+	//
+	DS3_SET_LARGE_RUMBLE_DURATION(DeviceContext, 0xFF);
+	DS3_SET_SMALL_RUMBLE_DURATION(DeviceContext, 0xFF);
+}
+
+//
+// Delivers input reports held back by the rate limit
+// 
+_Use_decl_annotations_
+VOID
+DSHM_EvtInputRateLimitTimerFunc(
+	WDFTIMER Timer
+)
+{
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(WdfTimerGetParentObject(Timer));
+
+	DSHM_ReleaseHeldInputReports(pDevCtx, DMF_CONTEXT_GET((DMFMODULE)pDevCtx->DsHidMiniModule));
+}
+
+//
+// Executes the action of a button combination held long enough
+// 
+_Use_decl_annotations_
+VOID
+DSHM_EvtButtonComboTimerFunc(
+	WDFTIMER Timer
+)
+{
+	NTSTATUS status;
+
+	FuncEntry(TRACE_DSHIDMINIDRV);
+
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(WdfTimerGetParentObject(Timer));
+
+	switch (DS3_BUTTON_COMBO_ENGINE_EXPIRE(&pDevCtx->ButtonCombos))
+	{
+	case DsButtonComboActionWirelessDisconnect:
+
+		if (pDevCtx->ConnectionType != DsDeviceConnectionTypeBth)
+		{
+			break;
+		}
+
+		TraceEvents(TRACE_LEVEL_INFORMATION,
+			TRACE_DSHIDMINIDRV,
+			"!! Quick disconnect combination detected, sending disconnect request"
+		);
+
+		//
+		// Send disconnect request
+		// 
+		if (!NT_SUCCESS(status = DsBth_SendDisconnectRequest(pDevCtx)))
+		{
+			TraceError(
+				TRACE_DSHIDMINIDRV,
+				"Sending disconnect request failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"DsBth_SendDisconnectRequest", status);
+		}
+
+		break;
+
+	case DsButtonComboActionToggleAlternativeRumble:
+
+		DSHM_ToggleAlternativeRumbleMode(pDevCtx);
+
+		break;
+
+	default:
+		break;
+	}
+
+	FuncExitNoReturn(TRACE_DSHIDMINIDRV);
+}
+
 //
 // Called when data is available on the USB Interrupt IN pipe.
 // 
@@ -586,18 +730,23 @@ VOID DsUsb_EvtUsbInterruptPipeReadComplete(
 	WDFCONTEXT Context
 )
 {
-	LARGE_INTEGER freq, t2;
 	DS_BATTERY_STATUS battery;
 
 	UNREFERENCED_PARAMETER(Pipe);
 
 	FuncEntry(TRACE_DSHIDMINIDRV);
 
-	//
-	// Validate expected packet size
-	// 
-	if (NumBytesTransferred < sizeof(DS3_RAW_INPUT_REPORT))
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(Context);
+
+	const PDS3_RAW_INPUT_REPORT pInReport = (PDS3_RAW_INPUT_REPORT)WdfMemoryGetBuffer(Buffer, NULL);
+
+	switch (DS_USB_INPUT_PIPELINE_VALIDATE(
+		&pDevCtx->Connection.Usb.InterruptIn.Stats,
+		(const UCHAR*)pInReport,
+		NumBytesTransferred
+	))
 	{
+	case DsUsbInputTransferShort:
 		TraceEvents(
 			TRACE_LEVEL_WARNING,
 			TRACE_DSHIDMINIDRV,
@@ -605,71 +754,64 @@ VOID DsUsb_EvtUsbInterruptPipeReadComplete(
 			NumBytesTransferred,
 			sizeof(DS3_RAW_INPUT_REPORT)
 		);
-
 		FuncExitNoReturn(TRACE_DSHIDMINIDRV);
 		return;
+	case DsUsbInputTransferBroken:
+		//
+		// Some controllers occasionally send this broken report, ignore packet
+		// 
+		FuncExitNoReturn(TRACE_DSHIDMINIDRV);
+		return;
+	default:
+		break;
 	}
 
-	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(Context);
-	DMF_CONTEXT_DsHidMini* pModCtx = DMF_CONTEXT_GET((DMFMODULE)pDevCtx->DsHidMiniModule);
-	const PDS3_RAW_INPUT_REPORT pInReport = (PDS3_RAW_INPUT_REPORT)WdfMemoryGetBuffer(Buffer, NULL);
+	const ULONGLONG lastArrival = pDevCtx->InputInterval.Stats.LastTimestamp;
+
+	DS_INPUT_LATENCY_BEGIN(&pDevCtx->InputLatency);
+
+	DSHM_RecordInputReportArrival(pDevCtx);
 
 	//
-	// Some controllers occasionally send this broken report, ignore packet
+	// Validation mode reports every gap immediately, tagged with the reader settings in use
 	// 
-	if (pInReport->Reserved0 == 0xFF)
+	if (pDevCtx->Connection.Usb.InterruptIn.IsValidationEnabled
+		&& pDevCtx->InputInterval.Stats.GapCount != pDevCtx->Connection.Usb.InterruptIn.ValidatedGapCount)
 	{
-		FuncExitNoReturn(TRACE_DSHIDMINIDRV);
-		return;
-	}
+		pDevCtx->Connection.Usb.InterruptIn.ValidatedGapCount = pDevCtx->InputInterval.Stats.GapCount;
 
-	QueryPerformanceFrequency(&freq);
-	LARGE_INTEGER* t1 = &pDevCtx->Connection.Usb.ChargingCycleTimestamp;
+		TraceInformation(
+			TRACE_DSHIDMINIDRV,
+			"USB input gap of %I64u us (%d pending reads, %d bytes transfer length, %I64d bytes received)",
+			pDevCtx->InputInterval.Stats.LastTimestamp - lastArrival,
+			pDevCtx->Connection.Usb.InterruptIn.RequestCount,
+			pDevCtx->Connection.Usb.InterruptIn.TransferLength,
+			NumBytesTransferred
+		);
+	}
 
 #ifdef DBG
 	DumpAsHex(">> USB", pInReport, (ULONG)sizeof(DS3_RAW_INPUT_REPORT));
 #endif
 
+	battery = (DS_BATTERY_STATUS)pInReport->BatteryStatus;
+
 	//
-	// Handle special case of SIXAXIS.SYS emulation
+	// Update battery status property, written deferred and only on change
 	// 
-	if (pDevCtx->Configuration.HidDeviceMode == DsHidMiniDeviceModeSixaxisCompatible)
-	{
-		RtlCopyMemory(
-			&pModCtx->GetFeatureReport,
-			pInReport,
-			sizeof(DS3_RAW_INPUT_REPORT)
-		);
-
-		pModCtx->GetFeatureReport.AccelerometerX = 0x03FF - _byteswap_ushort(pModCtx->GetFeatureReport.AccelerometerX);
-		pModCtx->GetFeatureReport.AccelerometerY = _byteswap_ushort(pModCtx->GetFeatureReport.AccelerometerY);
-		pModCtx->GetFeatureReport.AccelerometerZ = _byteswap_ushort(pModCtx->GetFeatureReport.AccelerometerZ);
-		pModCtx->GetFeatureReport.Gyroscope = _byteswap_ushort(pModCtx->GetFeatureReport.Gyroscope);
-	}
+	DsDevice_SetDeviceBatteryStatus(pDevCtx, battery);
 
-	battery = (DS_BATTERY_STATUS)pInReport->BatteryStatus;
+	const PDS_LED_SETTINGS pLED = &pDevCtx->Configuration.LEDSettings;
 
 	//
-	// Update battery status property
+	// Stop cycling LEDs once no longer charging
 	// 
-	if (battery != pDevCtx->BatteryStatus)
+	if (battery != DsBatteryStatusCharging && pDevCtx->Connection.Usb.IsChargingCycleActive)
 	{
-		WDF_DEVICE_PROPERTY_DATA propertyData;
-
-		WDF_DEVICE_PROPERTY_DATA_INIT(&propertyData, &DEVPKEY_DsHidMini_RO_BatteryStatus);
-		propertyData.Flags |= PLUGPLAY_PROPERTY_PERSISTENT;
-		propertyData.Lcid = LOCALE_NEUTRAL;
-
-		(void)WdfDeviceAssignProperty(
-			(WDFDEVICE)Context,
-			&propertyData,
-			DEVPROP_TYPE_BYTE,
-			sizeof(BYTE),
-			&battery
-		);
-	}
+		pDevCtx->Connection.Usb.IsChargingCycleActive = FALSE;
 
-	const PDS_LED_SETTINGS pLED = &pDevCtx->Configuration.LEDSettings;
+		WdfTimerStop(pDevCtx->Connection.Usb.ChargingCycleTimer, FALSE);
+	}
 
 	//
 	// Check if state has changed to Charged
@@ -703,76 +845,18 @@ VOID DsUsb_EvtUsbInterruptPipeReadComplete(
 		}
 	}
 	//
-	// If charging, cycle LEDs
+	// If charging, cycle LEDs, the periodic timer takes over from here
 	// 
 	else if (battery == DsBatteryStatusCharging)
 	{
-		if (pDevCtx->Connection.Usb.ChargingCycleTimestamp.QuadPart == 0)
+		if (!pDevCtx->Connection.Usb.IsChargingCycleActive)
 		{
-			QueryPerformanceCounter(t1);
-		}
-
-		QueryPerformanceCounter(&t2);
-
-		const LONGLONG ms = (t2.QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
-
-		//
-		// 1 second passed
-		// 
-		if (ms > 1000)
-		{
-			//
-			// Reset
-			// 
-			pDevCtx->Connection.Usb.ChargingCycleTimestamp.QuadPart = 0;
-
-			UCHAR led = DS3_LED_OFF;
-
-			switch (pLED->Mode)
-			{
-			case DsLEDModeBatteryIndicatorPlayerIndex:
-
-				led = DS3_GET_LED_FLAGS(pDevCtx) << 1;
-
-			//
-			// Cycle through
-			// 
-				if (led > DS3_LED_4 || led < DS3_LED_1)
-				{
-					led = DS3_LED_1;
-				}
-
-				break;
-			case DsLEDModeBatteryIndicatorBarGraph:
+			pDevCtx->Connection.Usb.IsChargingCycleActive = TRUE;
 
-				led = DS3_GET_LED_FLAGS(pDevCtx);
-
-			//
-			// Cycle graph from 1 to 4 and repeat
-			// 
-				if (led & 0xF0)
-				{
-					led = DS3_LED_1;
-				}
-				else
-				{
-					led |= (!led) ? DS3_LED_1 : led << 1;
-				}
-
-				break;
-			}
-
-			if (
-				(pLED->Authority == DsLEDAuthorityDriver /* Driver wins over Automatic or Application */ ||
-					pDevCtx->OutputReport.Mode == Ds3OutputReportModeDriverHandled) &&
-				/* validate mode range */
-				pLED->Mode > DsLEDModeUnknown && pLED->Mode < DsLEDModeCustomPattern
-				)
-			{
-				DS3_SET_LED_FLAGS(pDevCtx, led);
-
-				(void)DSHM_SendOutputReport(pDevCtx, Ds3OutputReportSourceDriverLowPriority);
-			}
+			WdfTimerStart(
+				pDevCtx->Connection.Usb.ChargingCycleTimer,
+				WDF_REL_TIMEOUT_IN_MS(1000)
+			);
 		}
 	}
 	else
@@ -780,6 +864,11 @@ VOID DsUsb_EvtUsbInterruptPipeReadComplete(
 		pDevCtx->BatteryStatus = battery;
 	}
 
+	//
+	// Button combos, pre-compiled into masks on configuration load
+	// 
+	DS3_BUTTON_COMBO_ENGINE_UPDATE(&pDevCtx->ButtonCombos, pInReport->Buttons.lButtons);
+
 	DSHM_ProcessHidInputReport(pDevCtx, pInReport);
 
 	FuncExitNoReturn(TRACE_DSHIDMINIDRV);
@@ -797,16 +886,15 @@ DsBth_HidInterruptReadContinuousRequestCompleted(
 	_In_ VOID* ClientBufferContextOutput,
 	_In_ NTSTATUS CompletionStatus)
 {
-	NTSTATUS status;
 	PUCHAR buffer;
 	size_t bufferLength;
 	PDEVICE_CONTEXT pDevCtx;
-	LARGE_INTEGER freq, * t1, t2;
+	LARGE_INTEGER * t1, t2;
 	LONGLONG ms;
 	DS_BATTERY_STATUS battery;
-	DMF_CONTEXT_DsHidMini* pModCtx;
 	PDS3_RAW_INPUT_REPORT pInReport;
 	WDFDEVICE device;
+	BOOLEAN isOrdered;
 
 	UNREFERENCED_PARAMETER(ClientBufferContextOutput);
 
@@ -827,8 +915,22 @@ DsBth_HidInterruptReadContinuousRequestCompleted(
 
 	device = DMF_ParentDeviceGet(DmfModule);
 	pDevCtx = DeviceGetContext(device);
-	pModCtx = DMF_CONTEXT_GET((DMFMODULE)pDevCtx->DsHidMiniModule);
-	QueryPerformanceFrequency(&freq);
+
+	InterlockedIncrement64(&pDevCtx->Connection.Bth.HidInterrupt.CompletionCount);
+
+	//
+	// With multiple reads pending completions may race each other, so they get serialized.
+	//   Ordering relies on BthPS3 completing the queued reads first in, first out. DS3 reports
+	//   carry no counter of their own, so nothing gets dropped here: a callback overtaken by
+	//   the next one on the way to the lock applies a report one interval old until the next
+	//   one arrives, which beats discarding a valid report.
+	// 
+	isOrdered = (pDevCtx->Connection.Bth.HidInterrupt.RequestCount > 1);
+
+	if (isOrdered)
+	{
+		WdfWaitLockAcquire(pDevCtx->Connection.Bth.HidInterrupt.ReadLock, NULL);
+	}
 
 	buffer = (PUCHAR)OutputBuffer;
 	bufferLength = OutputBufferSize;
@@ -850,31 +952,23 @@ DsBth_HidInterruptReadContinuousRequestCompleted(
 	*/
 	if (buffer[2] == 0xFF)
 	{
+		if (isOrdered)
+		{
+			WdfWaitLockRelease(pDevCtx->Connection.Bth.HidInterrupt.ReadLock);
+		}
+
 		return ContinuousRequestTarget_BufferDisposition_ContinuousRequestTargetAndContinueStreaming;
 	}
 
+	DS_INPUT_LATENCY_BEGIN(&pDevCtx->InputLatency);
+
+	DSHM_RecordInputReportArrival(pDevCtx);
+
 	//
 	// Skip to report ID
 	// 
 	pInReport = (PDS3_RAW_INPUT_REPORT)&buffer[1];
 
-	//
-	// Handle special case of SIXAXIS.SYS emulation
-	// 
-	if (pDevCtx->Configuration.HidDeviceMode == DsHidMiniDeviceModeSixaxisCompatible)
-	{
-		RtlCopyMemory(
-			&pModCtx->GetFeatureReport,
-			pInReport,
-			sizeof(DS3_RAW_INPUT_REPORT)
-		);
-
-		pModCtx->GetFeatureReport.AccelerometerX = 0x03FF - _byteswap_ushort(pModCtx->GetFeatureReport.AccelerometerX);
-		pModCtx->GetFeatureReport.AccelerometerY = _byteswap_ushort(pModCtx->GetFeatureReport.AccelerometerY);
-		pModCtx->GetFeatureReport.AccelerometerZ = _byteswap_ushort(pModCtx->GetFeatureReport.AccelerometerZ);
-		pModCtx->GetFeatureReport.Gyroscope = _byteswap_ushort(pModCtx->GetFeatureReport.Gyroscope);
-	}
-
 	//
 	// Grab battery info
 	// 
@@ -904,7 +998,7 @@ DsBth_HidInterruptReadContinuousRequestCompleted(
 
 		QueryPerformanceCounter(&t2);
 
-		ms = (t2.QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
+		ms = (t2.QuadPart - t1->QuadPart) / (pDevCtx->PerformanceFrequency.QuadPart / 1000);
 
 		//
 		// First ever call or time span has elapsed
@@ -922,20 +1016,7 @@ DsBth_HidInterruptReadContinuousRequestCompleted(
 			//
 			// Update battery status property
 			// 
-
-			WDF_DEVICE_PROPERTY_DATA propertyData;
-
-			WDF_DEVICE_PROPERTY_DATA_INIT(&propertyData, &DEVPKEY_DsHidMini_RO_BatteryStatus);
-			propertyData.Flags |= PLUGPLAY_PROPERTY_PERSISTENT;
-			propertyData.Lcid = LOCALE_NEUTRAL;
-
-			(void)WdfDeviceAssignProperty(
-				device,
-				&propertyData,
-				DEVPROP_TYPE_BYTE,
-				sizeof(BYTE),
-				&battery
-			);
+			DsDevice_SetDeviceBatteryStatus(pDevCtx, battery);
 
 			const PDS_LED_SETTINGS pLED = &pDevCtx->Configuration.LEDSettings;
 
@@ -1023,227 +1104,39 @@ DsBth_HidInterruptReadContinuousRequestCompleted(
 	}
 
 	//
-	// Quick disconnect combo detected
+	// Button combos, pre-compiled into masks on configuration load
 	// 
-	if (pDevCtx->Configuration.WirelessDisconnectButtonCombo.IsEnabled)
-	{
-		int engagedCount = 0;
-		for (int buttonIndex = 0; buttonIndex < (int)_countof(pDevCtx->Configuration.WirelessDisconnectButtonCombo.Buttons); buttonIndex++)
-		{
-			if ((pInReport->Buttons.lButtons >> pDevCtx->Configuration.WirelessDisconnectButtonCombo.Buttons[buttonIndex]) & 1)
-			{
-				engagedCount++;
-			}
-		}
-
-		if (engagedCount == _countof(pDevCtx->Configuration.WirelessDisconnectButtonCombo.Buttons))
-		{
-			TraceEvents(TRACE_LEVEL_INFORMATION,
-				TRACE_DSHIDMINIDRV,
-				"!! Quick disconnect combination detected"
-			);
-
-			t1 = &pDevCtx->Connection.Bth.QuickDisconnectTimestamp;
-
-			if (pDevCtx->Connection.Bth.QuickDisconnectTimestamp.QuadPart == 0)
-			{
-				QueryPerformanceCounter(t1);
-			}
-
-			QueryPerformanceCounter(&t2);
-
-			ms = (t2.QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
-
-			//
-			// 1 second passed
-			// 
-			if (ms > pDevCtx->Configuration.WirelessDisconnectButtonCombo.HoldTime)
-			{
-				TraceEvents(TRACE_LEVEL_INFORMATION,
-					TRACE_DSHIDMINIDRV,
-					"!! Sending disconnect request"
-				);
-
-				//
-				// Send disconnect request
-				// 
-				status = DsBth_SendDisconnectRequest(pDevCtx);
-
-				if (!NT_SUCCESS(status))
-				{
-					TraceError(
-						TRACE_DSHIDMINIDRV,
-						"Sending disconnect request failed with status %!STATUS!",
-						status
-					);
-					EventWriteFailedWithNTStatus(__FUNCTION__, L"DsBth_SendDisconnectRequest", status);
-				}
-
-				//
-				// No further processing
-				// 
-				return ContinuousRequestTarget_BufferDisposition_ContinuousRequestTargetAndStopStreaming;
-			}
-		}
-		else
-		{
-			pDevCtx->Connection.Bth.QuickDisconnectTimestamp.QuadPart = 0;
-		}
-	}
+	DS3_BUTTON_COMBO_ENGINE_UPDATE(&pDevCtx->ButtonCombos, pInReport->Buttons.lButtons);
 
 	//
-	// Alternative rumble toggle combo detected
+	// Idle disconnect detection, only transitions (re-)arm the timer
 	// 
-	if (pDevCtx->Configuration.RumbleSettings.AlternativeMode.ToggleButtonCombo.IsEnabled)
+	const BOOLEAN isIdle = !pDevCtx->Configuration.DisableWirelessIdleTimeout && DS3_RAW_IS_IDLE(pInReport);
+
+	if (isIdle != pDevCtx->Connection.Bth.IsIdle)
 	{
-		int engagedCount = 0;
-		for (int buttonIndex = 0; buttonIndex < (int)_countof(pDevCtx->Configuration.RumbleSettings.AlternativeMode.ToggleButtonCombo.Buttons); buttonIndex++)
-		{
-			if ((pInReport->Buttons.lButtons >> pDevCtx->Configuration.RumbleSettings.AlternativeMode.ToggleButtonCombo.Buttons[buttonIndex]) & 1)
-			{
-				engagedCount++;
-			}
-		}
+		pDevCtx->Connection.Bth.IsIdle = isIdle;
 
-		if (engagedCount == _countof(pDevCtx->Configuration.RumbleSettings.AlternativeMode.ToggleButtonCombo.Buttons))
+		if (isIdle)
 		{
-			TraceEvents(TRACE_LEVEL_INFORMATION,
-				TRACE_DSHIDMINIDRV,
-				"!! Alternative mode toggle combination detected"
+			WdfTimerStart(
+				pDevCtx->Connection.Bth.Timers.IdleDisconnect,
+				WDF_REL_TIMEOUT_IN_MS(pDevCtx->Configuration.WirelessIdleTimeoutPeriodMs)
 			);
-			if (pDevCtx->RumbleControlState.AltMode.IsToggleAllowed)
-			{
-				t1 = &pDevCtx->RumbleControlState.AltMode.QuickToggleTimestamp;
-
-				if (pDevCtx->RumbleControlState.AltMode.QuickToggleTimestamp.QuadPart == 0)
-				{
-					QueryPerformanceCounter(t1);
-				}
-
-				QueryPerformanceCounter(&t2);
-
-				ms = (t2.QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
-
-				//
-				// Combo was held for the user defined time period
-				// 
-				if (ms > pDevCtx->Configuration.WirelessDisconnectButtonCombo.HoldTime)
-				{
-					TraceEvents(TRACE_LEVEL_INFORMATION,
-						TRACE_DSHIDMINIDRV,
-						"!! Toggling alternative rumble mode"
-					);
-					pDevCtx->RumbleControlState.AltMode.IsEnabled = !pDevCtx->RumbleControlState.AltMode.IsEnabled;
-
-					//
-					// Send rumble feedback to indicate change in rumble mode
-					//
-					DS3_SET_LARGE_RUMBLE_DURATION(pDevCtx, 0x30);
-					DS3_SET_SMALL_RUMBLE_DURATION(pDevCtx, 0x20);
-					DS3_SET_BOTH_RUMBLE_STRENGTH(pDevCtx, 0x00, 0xFF);
-					(void)DSHM_SendOutputReport(pDevCtx, Ds3OutputReportSourceDriverLowPriority);
-
-					//
-					// Restore default rumble duration
-					//
-					DS3_SET_LARGE_RUMBLE_DURATION(pDevCtx, 0xFF);
-					DS3_SET_SMALL_RUMBLE_DURATION(pDevCtx, 0xFF);
-
-
-					//
-					// Register the time the toggle was triggered
-					// Disallow toggling again while combo is being held
-					//
-					t1->QuadPart = t2.QuadPart;
-					pDevCtx->RumbleControlState.AltMode.IsToggleAllowed = FALSE;
-				}
-			}
-			else
-			{
-				TraceEvents(TRACE_LEVEL_INFORMATION,
-					TRACE_DSHIDMINIDRV,
-					"!! Alternative rumble mode toggling prevented"
-				);
-			}
 		}
 		else
 		{
-			if (pDevCtx->RumbleControlState.AltMode.IsToggleAllowed)
-			{
-				pDevCtx->RumbleControlState.AltMode.QuickToggleTimestamp.QuadPart = 0;
-			}
-			else
-			{
-				t1 = &pDevCtx->RumbleControlState.AltMode.QuickToggleTimestamp;
-				QueryPerformanceCounter(&t2);
-				ms = (t2.QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
-				if (ms > 1000) // wait 1 second before re-enabling toggle combo after releasing it
-				{
-					TraceEvents(TRACE_LEVEL_INFORMATION,
-						TRACE_DSHIDMINIDRV,
-						"!! Prevention time after releasing alt mode toggle combo has passed. Allowing combo again"
-					);
-					pDevCtx->RumbleControlState.AltMode.IsToggleAllowed = TRUE;
-					pDevCtx->RumbleControlState.AltMode.QuickToggleTimestamp.QuadPart = 0;
-				}
-			}
+			WdfTimerStop(pDevCtx->Connection.Bth.Timers.IdleDisconnect, FALSE);
 		}
 	}
 
-	//
-	// Idle disconnect detection
-	// 
-	if (!pDevCtx->Configuration.DisableWirelessIdleTimeout && DS3_RAW_IS_IDLE(pInReport))
-	{
-		t1 = &pDevCtx->Connection.Bth.IdleDisconnectTimestamp;
-
-		if (pDevCtx->Connection.Bth.IdleDisconnectTimestamp.QuadPart == 0)
-		{
-			QueryPerformanceCounter(t1);
-		}
-
-		QueryPerformanceCounter(&t2);
-
-		ms = (t2.QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
-
-		//
-		// Timeout has been reached
-		// 
-		if (ms > pDevCtx->Configuration.WirelessIdleTimeoutPeriodMs)
-		{
-			TraceEvents(TRACE_LEVEL_INFORMATION,
-				TRACE_DSHIDMINIDRV,
-				"!! Idle timeout detected, sending disconnect request"
-			);
-
-			//
-			// Send disconnect request
-			// 
-			status = DsBth_SendDisconnectRequest(pDevCtx);
-
-			if (!NT_SUCCESS(status))
-			{
-				TraceError(
-					TRACE_DSHIDMINIDRV,
-					"Sending disconnect request failed with status %!STATUS!",
-					status
-				);
-				EventWriteFailedWithNTStatus(__FUNCTION__, L"DsBth_SendDisconnectRequest", status);
-			}
+	DSHM_ProcessHidInputReport(pDevCtx, pInReport);
 
-			//
-			// No further processing
-			// 
-			return ContinuousRequestTarget_BufferDisposition_ContinuousRequestTargetAndStopStreaming;
-		}
-	}
-	else
+	if (isOrdered)
 	{
-		pDevCtx->Connection.Bth.IdleDisconnectTimestamp.QuadPart = 0;
+		WdfWaitLockRelease(pDevCtx->Connection.Bth.HidInterrupt.ReadLock);
 	}
 
-	DSHM_ProcessHidInputReport(pDevCtx, pInReport);
-
 	return ContinuousRequestTarget_BufferDisposition_ContinuousRequestTargetAndContinueStreaming;
 }
 
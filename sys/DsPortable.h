@@ -0,0 +1,67 @@
+#pragma once
+
+//
+// Minimal type and helper definitions for the pure computational cores
+//   (input interval statistics, output mailbox, output rate control, motion,
+//   USB input transfer validation) which don't depend on WDF, DMF or any
+//   driver state. Keeps them compilable outside the driver, e.g. by the
+//   portable test harness under tests/
+//
+
+#ifdef _WIN32
+
+#include <Windows.h>
+#include <stdlib.h>
+
+#else
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef void VOID, * PVOID;
+typedef unsigned char UCHAR, * PUCHAR;
+typedef unsigned char BOOLEAN, * PBOOLEAN;
+typedef int16_t SHORT, * PSHORT;
+typedef uint16_t USHORT, * PUSHORT;
+typedef int32_t LONG, * PLONG;
+typedef uint32_t ULONG, * PULONG;
+typedef int64_t LONGLONG, * PLONGLONG;
+typedef uint64_t ULONGLONG, * PULONGLONG;
+typedef double DOUBLE;
+
+#define TRUE	1
+#define FALSE	0
+
+#define MAXUSHORT	0xFFFF
+#define MAXULONG	0xFFFFFFFFUL
+
+#define FORCEINLINE	__inline__ __attribute__((always_inline))
+
+#ifndef min
+#define min(a, b)	(((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b)	(((a) > (b)) ? (a) : (b))
+#endif
+
+#define RtlZeroMemory(Destination, Length)			memset((Destination), 0, (Length))
+#define RtlCopyMemory(Destination, Source, Length)	memcpy((Destination), (Source), (Length))
+
+#define _byteswap_ushort(Value)	__builtin_bswap16(Value)
+
+#define UNREFERENCED_PARAMETER(P)	((void)(P))
+
+//
+// SAL annotations carry no meaning outside of MSVC
+//
+#define _In_
+#define _In_opt_
+#define _Out_
+#define _Out_opt_
+#define _Inout_
+#define _In_reads_bytes_(size)
+#define _Out_writes_bytes_(size)
+#define _Use_decl_annotations_
+
+#endif
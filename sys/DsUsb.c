@@ -95,11 +95,13 @@ DsUsbConfigContReaderForInterruptEndPoint(
 
 	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(Device);
 
+	const PDS_USB_INPUT_PIPELINE_SETTINGS pPipeline = &pDevCtx->Configuration.UsbInputPipeline;
+
 	WDF_USB_CONTINUOUS_READER_CONFIG_INIT(
 		&contReaderConfig,
 		DsUsb_EvtUsbInterruptPipeReadComplete,
 		Device, // Context
-		INTERRUPT_IN_BUFFER_LENGTH // TransferLength
+		pPipeline->TransferLength // TransferLength
 	);
 
 	contReaderConfig.EvtUsbTargetPipeReadersFailed = DsUsbEvtUsbInterruptReadersFailed;
@@ -109,8 +111,20 @@ DsUsbConfigContReaderForInterruptEndPoint(
 	// Driver must explicitly call WdfIoTargetStart to kick start the
 	// reader.  In this sample, it's done in D0Entry.
 	// By default, framework queues two requests to the target
-	// endpoint. Driver can configure up to 10 requests with CONFIG macro.
+	// endpoint, the configuration can request up to 10.
+	// Completion callbacks aren't serialized or ordered by the
+	// framework, a delayed one may get applied after a younger one.
 	//
+	contReaderConfig.NumPendingReads = pPipeline->RequestCount;
+
+	TraceVerbose(
+		TRACE_DSUSB,
+		"USB input pipeline: %d request(s) of %d bytes, validation %d",
+		pPipeline->RequestCount,
+		pPipeline->TransferLength,
+		pPipeline->IsValidationEnabled
+	);
+
 	if (!NT_SUCCESS(status = WdfUsbTargetPipeConfigContinuousReader(
 		pDevCtx->Connection.Usb.InterruptInPipe,
 		&contReaderConfig
@@ -120,6 +134,15 @@ DsUsbConfigContReaderForInterruptEndPoint(
 			"WdfUsbTargetPipeConfigContinuousReader failed %x\n",
 			status);
 	}
+	else
+	{
+		//
+		// Later configuration reloads don't affect the reader, remember what it runs with
+		// 
+		pDevCtx->Connection.Usb.InterruptIn.RequestCount = pPipeline->RequestCount;
+		pDevCtx->Connection.Usb.InterruptIn.TransferLength = pPipeline->TransferLength;
+		pDevCtx->Connection.Usb.InterruptIn.IsValidationEnabled = pPipeline->IsValidationEnabled;
+	}
 
 	FuncExit(TRACE_DSUSB, "status=%!STATUS!", status);
 
@@ -128,120 +151,123 @@ DsUsbConfigContReaderForInterruptEndPoint(
 
 //
 // Send buffer to Interrupt OUT endpoint asynchronously
+//   The request belongs to CompletionRoutine (EvtUsbRequestCompletionRoutine if NULL)
+//   once the send got started, a TimeoutMs of 0 lets it wait indefinitely
 // 
 NTSTATUS
 USB_WriteInterruptPipeAsync(
 	WDFIOTARGET IoTarget,
 	WDFUSBPIPE Pipe,
 	PVOID Buffer,
-	size_t BufferLength
+	size_t BufferLength,
+	ULONG TimeoutMs,
+	PFN_WDF_REQUEST_COMPLETION_ROUTINE CompletionRoutine,
+	WDFCONTEXT CompletionContext
 )
 {
 	NTSTATUS status;
-	WDFREQUEST request;
+	WDFREQUEST request = NULL;
 	WDF_OBJECT_ATTRIBUTES attributes;
+	WDF_REQUEST_SEND_OPTIONS sendOptions;
 	WDFMEMORY memory;
 	PVOID writeBufferPointer;
 
-	WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+	FuncEntry(TRACE_DSUSB);
 
-	if (!NT_SUCCESS(status = WdfRequestCreate(
-		&attributes,
-		IoTarget,
-		&request
-	)))
+	do
 	{
-		TraceError(
-			TRACE_DSUSB,
-			"WdfRequestCreate failed with status %!STATUS!",
-			status
-		);
-		return status;
-	}
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
 
-	WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
-	attributes.ParentObject = request;
+		if (!NT_SUCCESS(status = WdfRequestCreate(
+			&attributes,
+			IoTarget,
+			&request
+		)))
+		{
+			TraceError(
+				TRACE_DSUSB,
+				"WdfRequestCreate failed with status %!STATUS!",
+				status
+			);
+			request = NULL;
+			break;
+		}
 
-	if (!NT_SUCCESS(status = WdfMemoryCreate(
-		&attributes,
-		NonPagedPoolNx,
-		DS3_POOL_TAG,
-		BufferLength,
-		&memory,
-		&writeBufferPointer
-	)))
-	{
-		TraceError(
-			TRACE_DSUSB,
-			"WdfMemoryCreate failed with status %!STATUS!",
-			status
-		);
-		return status;
-	}
+		WDF_OBJECT_ATTRIBUTES_INIT(&attributes);
+		attributes.ParentObject = request;
 
-	RtlCopyMemory(writeBufferPointer, Buffer, BufferLength);
+		if (!NT_SUCCESS(status = WdfMemoryCreate(
+			&attributes,
+			NonPagedPoolNx,
+			DS3_POOL_TAG,
+			BufferLength,
+			&memory,
+			&writeBufferPointer
+		)))
+		{
+			TraceError(
+				TRACE_DSUSB,
+				"WdfMemoryCreate failed with status %!STATUS!",
+				status
+			);
+			break;
+		}
 
-	if (!NT_SUCCESS(status = WdfUsbTargetPipeFormatRequestForWrite(
-		Pipe,
-		request,
-		memory,
-		NULL
-	)))
-	{
-		TraceError(
-			TRACE_DSUSB,
-			"WdfUsbTargetPipeFormatRequestForWrite failed with status %!STATUS!",
-			status
+		RtlCopyMemory(writeBufferPointer, Buffer, BufferLength);
+
+		if (!NT_SUCCESS(status = WdfUsbTargetPipeFormatRequestForWrite(
+			Pipe,
+			request,
+			memory,
+			NULL
+		)))
+		{
+			TraceError(
+				TRACE_DSUSB,
+				"WdfUsbTargetPipeFormatRequestForWrite failed with status %!STATUS!",
+				status
+			);
+			break;
+		}
+
+		WdfRequestSetCompletionRoutine(
+			request,
+			(CompletionRoutine != NULL) ? CompletionRoutine : EvtUsbRequestCompletionRoutine,
+			CompletionContext
 		);
-		return status;
-	}
 
-	WdfRequestSetCompletionRoutine(
-		request,
-		EvtUsbRequestCompletionRoutine,
-		NULL
-	);
+		WDF_REQUEST_SEND_OPTIONS_INIT(&sendOptions, 0);
 
-	if (WdfRequestSend(request,
-		IoTarget,
-		NULL) == FALSE)
-	{
-		status = WdfRequestGetStatus(request);
-	}
+		if (TimeoutMs > 0)
+		{
+			WDF_REQUEST_SEND_OPTIONS_SET_TIMEOUT(&sendOptions, WDF_REL_TIMEOUT_IN_MS(TimeoutMs));
+		}
 
-	if (!NT_SUCCESS(status))
-	{
-		TraceError(
-			TRACE_DSUSB,
-			"WdfRequestSend failed with status %!STATUS!",
-			status
-		);
-	}
+		if (WdfRequestSend(request,
+			IoTarget,
+			&sendOptions) == FALSE)
+		{
+			status = WdfRequestGetStatus(request);
 
-	return status;
-}
+			TraceError(
+				TRACE_DSUSB,
+				"WdfRequestSend failed with status %!STATUS!",
+				status
+			);
+			break;
+		}
 
-//
-// Send the Output Report buffer content to the Interrupt OUT endpoint and wait for completion
-// 
-NTSTATUS
-USB_WriteInterruptOutSync(
-	_In_ PDEVICE_CONTEXT Context,
-	_In_ PWDF_MEMORY_DESCRIPTOR Memory
-)
-{
-	ULONG bytesWritten;
-	NTSTATUS status;
+		//
+		// Owned by the completion routine from here on
+		// 
+		request = NULL;
 
-	FuncEntry(TRACE_DSUSB);
+	} while (FALSE);
 
-	status = WdfUsbTargetPipeWriteSynchronously(
-		Context->Connection.Usb.InterruptOutPipe,
-		NULL,
-		NULL,
-		Memory,
-		&bytesWritten
-	);
+	if (request != NULL)
+	{
+		WdfObjectDelete(request);
+	}
 
 	FuncExit(TRACE_DSUSB, "status=%!STATUS!", status);
 
@@ -433,17 +459,6 @@ NTSTATUS DsUsb_PrepareHardware(WDFDEVICE Device)
 
 #pragma endregion
 
-		if (!NT_SUCCESS(status = DsUsbConfigContReaderForInterruptEndPoint(Device)))
-		{
-			TraceError(
-				TRACE_DSUSB,
-				"DsUsbConfigContReaderForInterruptEndPoint failed with %!STATUS!",
-				status
-			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"DsUsbConfigContReaderForInterruptEndPoint", status);
-			break;
-		}
-
 #pragma region Request device MAC address
 
 		//
@@ -486,6 +501,34 @@ NTSTATUS DsUsb_PrepareHardware(WDFDEVICE Device)
 			pDevCtx->DeviceAddress.Address[5]
 		);
 
+		sprintf_s(
+			pDevCtx->DeviceAddressString,
+			ARRAYSIZE(pDevCtx->DeviceAddressString),
+			"%02X%02X%02X%02X%02X%02X",
+			pDevCtx->DeviceAddress.Address[0],
+			pDevCtx->DeviceAddress.Address[1],
+			pDevCtx->DeviceAddress.Address[2],
+			pDevCtx->DeviceAddress.Address[3],
+			pDevCtx->DeviceAddress.Address[4],
+			pDevCtx->DeviceAddress.Address[5]
+		);
+
+		//
+		// The address is known now, device-specific reader settings can apply
+		// 
+		(void)ConfigLoadForDevice(pDevCtx, FALSE);
+
+		if (!NT_SUCCESS(status = DsUsbConfigContReaderForInterruptEndPoint(Device)))
+		{
+			TraceError(
+				TRACE_DSUSB,
+				"DsUsbConfigContReaderForInterruptEndPoint failed with %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"DsUsbConfigContReaderForInterruptEndPoint", status);
+			break;
+		}
+
 		//
 		// Convert to expected hex string
 		// 
@@ -586,7 +629,10 @@ NTSTATUS DsUsb_PrepareHardware(WDFDEVICE Device)
 			WdfUsbTargetDeviceGetIoTarget(pDevCtx->Connection.Usb.UsbDevice),
 			pDevCtx->Connection.Usb.InterruptOutPipe,
 			(PVOID)G_Ds3UsbHidOutputReport,
-			DS3_USB_HID_OUTPUT_REPORT_SIZE
+			DS3_USB_HID_OUTPUT_REPORT_SIZE,
+			0,
+			NULL,
+			NULL
 		)))
 		{
 			EventWriteFailedWithNTStatus(__FUNCTION__, L"Sending initial output report", status);
@@ -594,18 +640,6 @@ NTSTATUS DsUsb_PrepareHardware(WDFDEVICE Device)
 
 	} while (FALSE);
 
-    sprintf_s(
-        pDevCtx->DeviceAddressString,
-        ARRAYSIZE(pDevCtx->DeviceAddressString),
-        "%02X%02X%02X%02X%02X%02X",
-        pDevCtx->DeviceAddress.Address[0],
-        pDevCtx->DeviceAddress.Address[1],
-        pDevCtx->DeviceAddress.Address[2],
-        pDevCtx->DeviceAddress.Address[3],
-        pDevCtx->DeviceAddress.Address[4],
-        pDevCtx->DeviceAddress.Address[5]
-    );
-
 	FuncExit(TRACE_DSUSB, "status=%!STATUS!", status);
 
 	return status;
@@ -670,11 +704,79 @@ NTSTATUS DsUdb_D0Exit(WDFDEVICE Device)
 		WdfIoTargetCancelSentIo
 	);
 
+	pDevCtx->Connection.Usb.IsChargingCycleActive = FALSE;
+	WdfTimerStop(pDevCtx->Connection.Usb.ChargingCycleTimer, FALSE);
+
 	FuncExit(TRACE_DSUSB, "status=%!STATUS!", status);
 
 	return status;
 }
 
+//
+// Cycles the LEDs once per second while the battery is charging
+// 
+_Use_decl_annotations_
+VOID
+DsUsb_EvtChargingCycleTimerFunc(
+	WDFTIMER  Timer
+)
+{
+	FuncEntry(TRACE_DSUSB);
+
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(WdfTimerGetParentObject(Timer));
+	const PDS_LED_SETTINGS pLED = &pDevCtx->Configuration.LEDSettings;
+
+	UCHAR led = DS3_LED_OFF;
+
+	switch (pLED->Mode)
+	{
+	case DsLEDModeBatteryIndicatorPlayerIndex:
+
+		led = DS3_GET_LED_FLAGS(pDevCtx) << 1;
+
+		//
+		// Cycle through
+		// 
+		if (led > DS3_LED_4 || led < DS3_LED_1)
+		{
+			led = DS3_LED_1;
+		}
+
+		break;
+	case DsLEDModeBatteryIndicatorBarGraph:
+
+		led = DS3_GET_LED_FLAGS(pDevCtx);
+
+		//
+		// Cycle graph from 1 to 4 and repeat
+		// 
+		if (led & 0xF0)
+		{
+			led = DS3_LED_1;
+		}
+		else
+		{
+			led |= (!led) ? DS3_LED_1 : led << 1;
+		}
+
+		break;
+	}
+
+	if (
+		(pLED->Authority == DsLEDAuthorityDriver /* Driver wins over Automatic or Application */ ||
+			pDevCtx->OutputReport.Mode == Ds3OutputReportModeDriverHandled) &&
+		/* validate mode range */
+		pLED->Mode > DsLEDModeUnknown && pLED->Mode < DsLEDModeCustomPattern
+		)
+	{
+		DS3_SET_LED_FLAGS(pDevCtx, led);
+
+		(void)DSHM_SendOutputReport(pDevCtx, Ds3OutputReportSourceDriverLowPriority);
+	}
+
+	FuncExitNoReturn(TRACE_DSUSB);
+}
+
 //
 // Reader failed for some reason
 // 
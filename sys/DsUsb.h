@@ -27,13 +27,10 @@ NTSTATUS USB_WriteInterruptPipeAsync(
     _In_ WDFIOTARGET IoTarget,
     _In_ WDFUSBPIPE Pipe,
     _In_ PVOID Buffer,
-    _In_ size_t BufferLength
-);
-
-NTSTATUS
-USB_WriteInterruptOutSync(
-    _In_ PDEVICE_CONTEXT Context,
-    _In_ PWDF_MEMORY_DESCRIPTOR Memory
+    _In_ size_t BufferLength,
+    _In_ ULONG TimeoutMs,
+    _In_opt_ PFN_WDF_REQUEST_COMPLETION_ROUTINE CompletionRoutine,
+    _In_opt_ WDFCONTEXT CompletionContext
 );
 
 EVT_WDF_REQUEST_COMPLETION_ROUTINE EvtUsbRequestCompletionRoutine;
@@ -52,3 +49,5 @@ NTSTATUS
 DsUdb_D0Exit(
     WDFDEVICE Device
 );
+
+EVT_WDF_TIMER DsUsb_EvtChargingCycleTimerFunc;
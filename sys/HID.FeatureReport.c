@@ -2,6 +2,73 @@
 #include "HID.FeatureReport.tmh"
 
 
+//
+// Builds the SIXAXIS.SYS GET_FEATURE view of the latest raw report, unless the
+// cached one is still current. Caller must hold SixaxisFeature.Lock.
+// 
+static void
+DSHM_MaterializeSixaxisFeatureReport(
+	_In_ PDEVICE_CONTEXT DeviceContext
+)
+{
+	LONG sequence;
+
+	do
+	{
+		sequence = InterlockedOr(&DeviceContext->SixaxisFeature.Sequence, 0);
+
+		if (sequence == DeviceContext->SixaxisFeature.FeatureSequence)
+		{
+			return;
+		}
+
+		//
+		// Input completion is in the middle of updating, try again
+		// 
+		if (sequence & 1)
+		{
+			YieldProcessor();
+			continue;
+		}
+
+		RtlCopyMemory(
+			&DeviceContext->SixaxisFeature.FeatureReport,
+			&DeviceContext->SixaxisFeature.LatestReport,
+			sizeof(DS3_RAW_INPUT_REPORT)
+		);
+	} while (sequence != InterlockedOr(&DeviceContext->SixaxisFeature.Sequence, 0));
+
+	const PDS3_RAW_INPUT_REPORT pReport = &DeviceContext->SixaxisFeature.FeatureReport;
+
+	pReport->AccelerometerX = 0x03FF - _byteswap_ushort(pReport->AccelerometerX);
+	pReport->AccelerometerY = _byteswap_ushort(pReport->AccelerometerY);
+	pReport->AccelerometerZ = _byteswap_ushort(pReport->AccelerometerZ);
+	pReport->Gyroscope = _byteswap_ushort(pReport->Gyroscope);
+
+	DeviceContext->SixaxisFeature.FeatureSequence = sequence;
+}
+
+//
+// Remembers the latest shaped and motion-calibrated report for SIXAXIS.SYS GET_FEATURE requests
+// 
+void
+DSHM_UpdateSixaxisFeatureSource(
+	_In_ PDEVICE_CONTEXT DeviceContext,
+	_In_ PDS3_RAW_INPUT_REPORT Report
+)
+{
+	InterlockedIncrement(&DeviceContext->SixaxisFeature.Sequence);
+
+	RtlCopyMemory(
+		&DeviceContext->SixaxisFeature.LatestReport,
+		Report,
+		sizeof(DS3_RAW_INPUT_REPORT)
+	);
+
+	InterlockedIncrement(&DeviceContext->SixaxisFeature.Sequence);
+}
+
+
 _Use_decl_annotations_
 NTSTATUS
 DSHM_GetFeature(
@@ -107,16 +174,22 @@ DSHM_GetFeature(
 	// 
 	if (Packet->reportId == 0x00 && DeviceContext->Configuration.HidDeviceMode == DsHidMiniDeviceModeSixaxisCompatible)
 	{
+		WdfWaitLockAcquire(DeviceContext->SixaxisFeature.Lock, NULL);
+
+		DSHM_MaterializeSixaxisFeatureReport(DeviceContext);
+
 		//
-		// Copy last received raw report to buffer
+		// Copy last received report to buffer
 		// 
 		RtlCopyMemory(
 			Packet->reportBuffer,
-			&ModuleContext->GetFeatureReport,
+			&DeviceContext->SixaxisFeature.FeatureReport,
 			Packet->reportBufferLen < SIXAXIS_HID_GET_FEATURE_REPORT_SIZE ? Packet->reportBufferLen :
 			SIXAXIS_HID_GET_FEATURE_REPORT_SIZE
 		);
 
+		WdfWaitLockRelease(DeviceContext->SixaxisFeature.Lock);
+
 		//
 		// Alter report ID header to expected values
 		// 
@@ -30,9 +30,21 @@ DSHM_WriteReport(
 	_Out_ ULONG* ReportSize
 );
 
+void
+DSHM_UpdateSixaxisFeatureSource(
+	_In_ PDEVICE_CONTEXT DeviceContext,
+	_In_ PDS3_RAW_INPUT_REPORT Report
+);
+
 void
 DSHM_ParseInputReport(
 	_In_ PDEVICE_CONTEXT DeviceContext,
 	_In_ DMF_CONTEXT_DsHidMini* ModuleContext,
 	_In_ PDS3_RAW_INPUT_REPORT Report
 );
+
+void
+DSHM_ReleaseHeldInputReports(
+	_In_ PDEVICE_CONTEXT DeviceContext,
+	_In_ DMF_CONTEXT_DsHidMini* ModuleContext
+);
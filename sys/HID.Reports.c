@@ -14,8 +14,6 @@ DSHM_WriteReport(
 	FuncEntry(TRACE_DSHIDMINIDRV);
 
 	NTSTATUS status = STATUS_NOT_IMPLEMENTED;
-	PUCHAR buffer = NULL;
-	size_t bufferSize = 0;
 
 #ifdef DSHM_FEATURE_FFB
 
@@ -281,52 +279,14 @@ DSHM_WriteReport(
 		DeviceContext->OutputReport.Mode = Ds3OutputReportModeWriteReportPassThrough;
 
 		//
-		// Get raw buffer pointer (connection agnostic)
+		// Take over what we received, LED states must not be overwritten from outside unless allowed
 		// 
-		DS3_GET_UNIFIED_OUTPUT_REPORT_BUFFER(
+		DS3_SET_OUTPUT_REPORT_BODY(
 			DeviceContext,
-			&buffer,
-			&bufferSize
+			&Packet->reportBuffer[3],
+			DeviceContext->Configuration.LEDSettings.Authority == DsLEDAuthorityDriver
 		);
 
-		//
-		// Prevent LED states from being overwritten from outside
-		// 
-		if (DeviceContext->Configuration.LEDSettings.Authority == DsLEDAuthorityDriver)
-		{
-			UCHAR ledBlock[sizeof(UCHAR) + (sizeof(DS_LED) * 4)];
-
-			//
-			// Backup LED states
-			// 
-			RtlCopyMemory(ledBlock, &buffer[9], ARRAYSIZE(ledBlock));
-
-			//
-			// Overwrite with what we received
-			// 
-			RtlCopyMemory(
-				buffer,
-				&Packet->reportBuffer[3],
-				bufferSize
-			);
-
-			//
-			// Restore LED states
-			// 
-			RtlCopyMemory(&buffer[9], ledBlock, ARRAYSIZE(ledBlock));
-		}
-		else
-		{
-			//
-			// Overwrite with what we received
-			// 
-			RtlCopyMemory(
-				buffer,
-				&Packet->reportBuffer[3],
-				bufferSize
-			);
-		}
-
 		(void)DSHM_SendOutputReport(DeviceContext, Ds3OutputReportSourcePassThrough);
 
 		status = STATUS_SUCCESS;
@@ -80,6 +80,28 @@ DSHM_EvtDispatchDeviceMessage(
 
 		status = STATUS_SUCCESS;
 	}
+	else if (MessageHeader->Command.Device == DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_INTERVAL)
+	{
+		DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE_INIT(
+			(PDSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE)MessageHeader,
+			MessageHeader->TargetIndex,
+			&DeviceContext->InputInterval.Stats
+		);
+
+		status = STATUS_SUCCESS;
+	}
+#ifdef DSHM_FEATURE_INPUT_LATENCY
+	else if (MessageHeader->Command.Device == DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_LATENCY)
+	{
+		DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE_INIT(
+			(PDSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE)MessageHeader,
+			MessageHeader->TargetIndex,
+			&DeviceContext->InputLatency
+		);
+
+		status = STATUS_SUCCESS;
+	}
+#endif
 
 	FuncExit(TRACE_IPC, "status=%!STATUS!", status);
 
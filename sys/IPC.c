@@ -240,6 +240,21 @@ NTSTATUS InitIPC(void)
 	context->IPC.SharedRegions.HID.Buffer = pHIDBuf;
 	context->IPC.SharedRegions.HID.BufferSize = hidRegionSize;
 
+	//
+	// The region size follows the allocation granularity, which the layout can't be checked against at compile time
+	// 
+	context->IPC.SharedRegions.HID.IsMotionAvailable =
+		(DSHM_IPC_HID_MOTION_REGION_OFFSET + (sizeof(IPC_HID_MOTION_MESSAGE) * DSHM_MAX_DEVICES)) <= hidRegionSize;
+
+	if (!context->IPC.SharedRegions.HID.IsMotionAvailable)
+	{
+		TraceWarning(
+			TRACE_IPC,
+			"HID region of %d bytes too small for motion messages, motion values won't be published",
+			hidRegionSize
+		);
+	}
+
 	// 
 	// Start thread now that context is initialized at its minimum requirement
 	// 
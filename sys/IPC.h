@@ -92,6 +92,14 @@ typedef enum
 	// Requests a wait handle for input report state changes
 	// 
 	DSHM_IPC_MSG_CMD_DEVICE_GET_HID_WAIT_HANDLE,
+	//
+	// Requests the per-stage input latency histograms
+	// 
+	DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_LATENCY,
+	//
+	// Requests the input report inter-arrival statistics
+	// 
+	DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_INTERVAL,
 } DSHM_IPC_MSG_CMD_DEVICE;
 
 //
@@ -207,6 +215,91 @@ typedef struct _DSHM_IPC_MSG_GET_HID_WAIT_HANDLE_RESPONSE
 	
 } DSHM_IPC_MSG_GET_HID_WAIT_HANDLE_RESPONSE, *PDSHM_IPC_MSG_GET_HID_WAIT_HANDLE_RESPONSE;
 
+//
+// Latency summary and histogram of one input processing stage
+// 
+typedef struct _DSHM_IPC_INPUT_LATENCY_STAGE
+{
+	//
+	// Number of recorded samples
+	// 
+	UINT64 Count;
+
+	//
+	// Median, 99th percentile and maximum in microseconds
+	//   Percentiles are the upper bound of the bucket they fall into
+	// 
+	UINT32 P50Microseconds;
+	UINT32 P99Microseconds;
+	UINT32 MaxMicroseconds;
+
+	//
+	// Raw log2 buckets in QPC ticks, see DS_INPUT_LATENCY_BUCKET_COUNT
+	// 
+	UINT32 Buckets[DS_INPUT_LATENCY_BUCKET_COUNT];
+	
+} DSHM_IPC_INPUT_LATENCY_STAGE, *PDSHM_IPC_INPUT_LATENCY_STAGE;
+
+//
+// Requests the per-stage input latency histograms of a given device
+// 
+typedef struct _DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE
+{
+	DSHM_IPC_MSG_HEADER Header;
+
+	//
+	// QPC frequency to convert the raw bucket boundaries
+	// 
+	UINT64 Frequency;
+
+	//
+	// Indexed by DS_INPUT_LATENCY_STAGE
+	// 
+	DSHM_IPC_INPUT_LATENCY_STAGE Stages[DsInputLatencyStageCount];
+	
+} DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE, *PDSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE;
+
+//
+// Requests the input report inter-arrival statistics of a given device
+// 
+typedef struct _DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE
+{
+	DSHM_IPC_MSG_HEADER Header;
+
+	//
+	// Number of recorded intervals
+	// 
+	UINT64 Count;
+
+	//
+	// Interval extremes and mean in microseconds
+	// 
+	UINT32 MinMicroseconds;
+	UINT32 MaxMicroseconds;
+	UINT32 MeanMicroseconds;
+
+	//
+	// Interval variance in microseconds squared
+	// 
+	UINT64 Variance;
+
+	//
+	// Intervals long enough to indicate lost reports
+	// 
+	UINT64 GapCount;
+
+	//
+	// Estimated number of reports lost in all gaps
+	// 
+	UINT64 MissedReports;
+
+	//
+	// Interval histogram in 1 millisecond steps, see DS_INPUT_INTERVAL_BUCKET_COUNT
+	// 
+	UINT32 Buckets[DS_INPUT_INTERVAL_BUCKET_COUNT];
+	
+} DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE, *PDSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE;
+
 typedef
 _Function_class_(EVT_DSHM_IPC_DispatchDeviceMessage)
 _IRQL_requires_same_
@@ -320,6 +413,74 @@ DSHM_IPC_MSG_GET_HID_WAIT_HANDLE_RESPONSE_INIT(
 	Message->WaitHandle = WaitHandle;
 }
 
+VOID
+FORCEINLINE
+DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE_INIT(
+	_Inout_ PDSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE Message,
+	_In_ UINT32 DeviceIndex,
+	_In_ const PDS_INPUT_INTERVAL_STATS Stats
+)
+{
+	const UINT32 size = sizeof(DSHM_IPC_MSG_GET_INPUT_INTERVAL_RESPONSE);
+	ULONG mean;
+	ULONGLONG variance;
+	RtlZeroMemory(Message, size);
+
+	DS_INPUT_INTERVAL_SUMMARY(Stats, &mean, &variance);
+
+	Message->Header.Type = DSHM_IPC_MSG_TYPE_RESPONSE_ONLY;
+	Message->Header.Target = DSHM_IPC_MSG_TARGET_CLIENT;
+	Message->Header.Command.Device = DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_INTERVAL;
+	Message->Header.TargetIndex = DeviceIndex;
+	Message->Header.Size = size;
+
+	Message->Count = Stats->Count;
+	Message->MinMicroseconds = (Stats->Count > 0) ? Stats->MinInterval : 0;
+	Message->MaxMicroseconds = Stats->MaxInterval;
+	Message->MeanMicroseconds = mean;
+	Message->Variance = variance;
+	Message->GapCount = Stats->GapCount;
+	Message->MissedReports = Stats->MissedReports;
+	RtlCopyMemory(Message->Buckets, Stats->Buckets, sizeof(Message->Buckets));
+}
+
+#ifdef DSHM_FEATURE_INPUT_LATENCY
+VOID
+FORCEINLINE
+DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE_INIT(
+	_Inout_ PDSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE Message,
+	_In_ UINT32 DeviceIndex,
+	_In_ const PDS_INPUT_LATENCY_STATS Stats
+)
+{
+	const UINT32 size = sizeof(DSHM_IPC_MSG_GET_INPUT_LATENCY_RESPONSE);
+	LARGE_INTEGER freq;
+	RtlZeroMemory(Message, size);
+
+	QueryPerformanceFrequency(&freq);
+
+	Message->Header.Type = DSHM_IPC_MSG_TYPE_RESPONSE_ONLY;
+	Message->Header.Target = DSHM_IPC_MSG_TARGET_CLIENT;
+	Message->Header.Command.Device = DSHM_IPC_MSG_CMD_DEVICE_GET_INPUT_LATENCY;
+	Message->Header.TargetIndex = DeviceIndex;
+	Message->Header.Size = size;
+
+	Message->Frequency = (UINT64)freq.QuadPart;
+
+	for (ULONG stage = 0; stage < DsInputLatencyStageCount; stage++)
+	{
+		const PDS_INPUT_LATENCY_HISTOGRAM pHistogram = &Stats->Stages[stage];
+		const PDSHM_IPC_INPUT_LATENCY_STAGE pStage = &Message->Stages[stage];
+
+		RtlCopyMemory(pStage->Buckets, pHistogram->Buckets, sizeof(pStage->Buckets));
+		pStage->Count = pHistogram->Count;
+		pStage->P50Microseconds = DS_INPUT_LATENCY_PERCENTILE_US(pHistogram, 500);
+		pStage->P99Microseconds = DS_INPUT_LATENCY_PERCENTILE_US(pHistogram, 990);
+		pStage->MaxMicroseconds = DS_INPUT_LATENCY_TICKS_TO_US(pHistogram->MaxTicks);
+	}
+}
+#endif
+
 
 NTSTATUS InitIPC(void);
 
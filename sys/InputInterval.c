@@ -0,0 +1,126 @@
+#include "DsPortable.h"
+#include "InputInterval.h"
+
+
+//
+// Resets all statistics
+//
+VOID
+DS_INPUT_INTERVAL_INIT(
+	PDS_INPUT_INTERVAL_STATS Stats
+)
+{
+	RtlZeroMemory(Stats, sizeof(DS_INPUT_INTERVAL_STATS));
+
+	Stats->MinInterval = MAXULONG;
+}
+
+//
+// Forgets the previous arrival so a connection break doesn't count as interval
+//
+VOID
+DS_INPUT_INTERVAL_RESTART(
+	PDS_INPUT_INTERVAL_STATS Stats
+)
+{
+	Stats->LastTimestamp = 0;
+	Stats->ConsecutiveGaps = 0;
+}
+
+//
+// Records the arrival of a new report, Timestamp in microseconds
+//
+VOID
+DS_INPUT_INTERVAL_UPDATE(
+	PDS_INPUT_INTERVAL_STATS Stats,
+	ULONGLONG Timestamp
+)
+{
+	const ULONGLONG last = Stats->LastTimestamp;
+
+	Stats->LastTimestamp = Timestamp;
+
+	if (last == 0 || Timestamp < last)
+	{
+		return;
+	}
+
+	const ULONG interval = (ULONG)min(Timestamp - last, MAXULONG);
+
+	Stats->Count++;
+	Stats->Sum += interval;
+	Stats->SumOfSquares += (ULONGLONG)interval * interval;
+
+	if (interval < Stats->MinInterval)
+	{
+		Stats->MinInterval = interval;
+	}
+
+	if (interval > Stats->MaxInterval)
+	{
+		Stats->MaxInterval = interval;
+	}
+
+	Stats->Buckets[min(interval / 1000, DS_INPUT_INTERVAL_BUCKET_COUNT - 1)]++;
+
+	//
+	// Gaps are judged against the average of regular intervals only, so bursts of loss don't raise the bar
+	//
+	const ULONG expected = Stats->ExpectedInterval >> 4;
+	const ULONG scaled = min(interval, MAXULONG >> 5) << 4;
+
+	if (Stats->Count > DS_INPUT_INTERVAL_WARMUP_COUNT
+		&& expected > 0
+		&& interval > expected * DS_INPUT_INTERVAL_GAP_FACTOR)
+	{
+		Stats->GapCount++;
+		Stats->MissedReports += ((interval + (expected / 2)) / expected) - 1;
+
+		//
+		// A steady run of gaps means the device slowed down for good, start over from the new rate
+		//
+		if (++Stats->ConsecutiveGaps >= DS_INPUT_INTERVAL_REBASELINE_COUNT)
+		{
+			Stats->ExpectedInterval = scaled;
+			Stats->ConsecutiveGaps = 0;
+		}
+
+		return;
+	}
+
+	Stats->ConsecutiveGaps = 0;
+
+	//
+	// Exponential moving average with a weight of 1/16
+	//
+	Stats->ExpectedInterval = (Stats->ExpectedInterval == 0)
+		? scaled
+		: (ULONG)((((ULONGLONG)Stats->ExpectedInterval * 15) + scaled) / 16);
+}
+
+//
+// Mean in microseconds and variance in microseconds squared
+//
+VOID
+DS_INPUT_INTERVAL_SUMMARY(
+	const PDS_INPUT_INTERVAL_STATS Stats,
+	PULONG Mean,
+	PULONGLONG Variance
+)
+{
+	if (Stats->Count == 0)
+	{
+		*Mean = 0;
+		*Variance = 0;
+		return;
+	}
+
+	//
+	// Not on the hot path, floating point avoids the truncated mean skewing small variances
+	//
+	const DOUBLE mean = (DOUBLE)Stats->Sum / (DOUBLE)Stats->Count;
+	const DOUBLE variance = ((DOUBLE)Stats->SumOfSquares / (DOUBLE)Stats->Count) - (mean * mean);
+
+	*Mean = (ULONG)(mean + 0.5);
+	*Variance = (variance > 0.0) ? (ULONGLONG)(variance + 0.5) : 0;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+//
+// Input report inter-arrival statistics (jitter and gap detection)
+//   Pure integer code without WDF or Win32 API dependencies, timestamps
+//   are supplied by the caller in microseconds
+//
+
+//
+// Bucket N counts intervals of [N, N + 1) milliseconds, the last one also takes everything beyond
+//
+#define DS_INPUT_INTERVAL_BUCKET_COUNT		32
+
+//
+// An interval exceeding the expected one by this factor counts as a gap
+//
+#define DS_INPUT_INTERVAL_GAP_FACTOR		2
+
+//
+// Intervals required before gap detection kicks in
+//
+#define DS_INPUT_INTERVAL_WARMUP_COUNT		16
+
+//
+// Consecutive gaps after which the expected interval is considered outdated (lasting rate change)
+//
+#define DS_INPUT_INTERVAL_REBASELINE_COUNT	8
+
+//
+// Streaming inter-arrival statistics
+//
+typedef struct _DS_INPUT_INTERVAL_STATS
+{
+	//
+	// Arrival time of the previous report, 0 if none since the last restart
+	//
+	ULONGLONG LastTimestamp;
+
+	//
+	// Number of recorded intervals
+	//
+	ULONGLONG Count;
+
+	//
+	// Extremes in microseconds
+	//
+	ULONG MinInterval;
+	ULONG MaxInterval;
+
+	//
+	// Running sums for mean and variance (exact, in microseconds and microseconds squared)
+	//
+	ULONGLONG Sum;
+	ULONGLONG SumOfSquares;
+
+	//
+	// Expected interval in 1/16 microseconds, averaged over regular intervals only and
+	// re-baselined after a run of DS_INPUT_INTERVAL_REBASELINE_COUNT gaps
+	//
+	ULONG ExpectedInterval;
+
+	//
+	// Gaps in a row since the last regular interval
+	//
+	ULONG ConsecutiveGaps;
+
+	//
+	// Intervals long enough to indicate lost reports
+	//
+	ULONGLONG GapCount;
+
+	//
+	// Estimated number of reports lost in all gaps
+	//
+	ULONGLONG MissedReports;
+
+	//
+	// Interval histogram
+	//
+	ULONG Buckets[DS_INPUT_INTERVAL_BUCKET_COUNT];
+
+} DS_INPUT_INTERVAL_STATS, * PDS_INPUT_INTERVAL_STATS;
+
+VOID
+DS_INPUT_INTERVAL_INIT(
+	_Out_ PDS_INPUT_INTERVAL_STATS Stats
+);
+
+VOID
+DS_INPUT_INTERVAL_RESTART(
+	_Inout_ PDS_INPUT_INTERVAL_STATS Stats
+);
+
+VOID
+DS_INPUT_INTERVAL_UPDATE(
+	_Inout_ PDS_INPUT_INTERVAL_STATS Stats,
+	_In_ ULONGLONG Timestamp
+);
+
+VOID
+DS_INPUT_INTERVAL_SUMMARY(
+	_In_ const PDS_INPUT_INTERVAL_STATS Stats,
+	_Out_ PULONG Mean,
+	_Out_ PULONGLONG Variance
+);
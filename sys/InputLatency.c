@@ -0,0 +1,63 @@
+#include "Driver.h"
+
+#ifdef DSHM_FEATURE_INPUT_LATENCY
+
+//
+// Converts QPC ticks to microseconds, split to not overflow on large values
+//
+ULONG
+DS_INPUT_LATENCY_TICKS_TO_US(
+	ULONGLONG Ticks
+)
+{
+	LARGE_INTEGER freq;
+
+	QueryPerformanceFrequency(&freq);
+
+	const ULONGLONG frequency = (ULONGLONG)freq.QuadPart;
+	const ULONGLONG us = ((Ticks / frequency) * 1000000) + (((Ticks % frequency) * 1000000) / frequency);
+
+	return (ULONG)min(us, MAXULONG);
+}
+
+//
+// Walks the buckets until the requested share of samples is covered
+//
+ULONG
+DS_INPUT_LATENCY_PERCENTILE_US(
+	const PDS_INPUT_LATENCY_HISTOGRAM Histogram,
+	ULONG Permille
+)
+{
+	const UINT64 count = Histogram->Count;
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	//
+	// Rank of the sample at the requested percentile, rounded up
+	//
+	const UINT64 rank = ((count * Permille) + 999) / 1000;
+	UINT64 seen = 0;
+
+	for (ULONG index = 0; index < DS_INPUT_LATENCY_BUCKET_COUNT; index++)
+	{
+		seen += Histogram->Buckets[index];
+
+		if (seen >= rank)
+		{
+			//
+			// Bucket 0 only holds zero-tick samples, the max is a tighter bound for the top bucket(s)
+			//
+			const ULONGLONG upper = (index == 0) ? 0 : (1ULL << index);
+
+			return DS_INPUT_LATENCY_TICKS_TO_US(min(upper, Histogram->MaxTicks));
+		}
+	}
+
+	return DS_INPUT_LATENCY_TICKS_TO_US(Histogram->MaxTicks);
+}
+
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+//
+// Per-stage input latency instrumentation
+//   All stages are measured from the interrupt IN completion in QPC ticks and
+//   aggregated in log2 buckets, recording a sample costs one QPC read plus a
+//   handful of integer operations. Compiled out if DSHM_FEATURE_INPUT_LATENCY
+//   is not defined.
+//
+
+//
+// Bucket 0 counts samples of 0 ticks, bucket N counts [2^(N-1), 2^N) ticks
+//   The last bucket also takes everything beyond
+//
+#define DS_INPUT_LATENCY_BUCKET_COUNT	32
+
+//
+// Measurement points, each relative to the interrupt IN completion
+//
+typedef enum _DS_INPUT_LATENCY_STAGE
+{
+	//
+	// Raw report copied to the IPC shared memory region
+	//
+	DsInputLatencyStageIpcPublish = 0,
+
+	//
+	// Raw report shaped and converted into the HID mode report
+	//
+	DsInputLatencyStagePostTransform,
+
+	//
+	// DMF_VirtualHidMini_InputReportGenerate returned with the report delivered
+	//
+	DsInputLatencyStageHidSubmit,
+
+	DsInputLatencyStageCount
+
+} DS_INPUT_LATENCY_STAGE;
+
+typedef struct _DS_INPUT_LATENCY_HISTOGRAM
+{
+	UINT32 Buckets[DS_INPUT_LATENCY_BUCKET_COUNT];
+
+	UINT64 Count;
+
+	UINT64 MaxTicks;
+
+} DS_INPUT_LATENCY_HISTOGRAM, * PDS_INPUT_LATENCY_HISTOGRAM;
+
+//
+// Per-device latency statistics
+//   Only updated from the input completion path, readers may observe a sample in progress
+//
+typedef struct _DS_INPUT_LATENCY_STATS
+{
+	//
+	// QPC timestamp of the interrupt IN completion currently being processed
+	//
+	LARGE_INTEGER CompletionTime;
+
+	DS_INPUT_LATENCY_HISTOGRAM Stages[DsInputLatencyStageCount];
+
+} DS_INPUT_LATENCY_STATS, * PDS_INPUT_LATENCY_STATS;
+
+#ifdef DSHM_FEATURE_INPUT_LATENCY
+
+static FORCEINLINE VOID DS_INPUT_LATENCY_RECORD(
+	_Inout_ PDS_INPUT_LATENCY_STATS Stats,
+	_In_ DS_INPUT_LATENCY_STAGE Stage
+)
+{
+	LARGE_INTEGER now;
+	ULONG index = 0;
+
+	QueryPerformanceCounter(&now);
+
+	const ULONGLONG ticks = (ULONGLONG)(now.QuadPart - Stats->CompletionTime.QuadPart);
+	const PDS_INPUT_LATENCY_HISTOGRAM pHistogram = &Stats->Stages[Stage];
+
+	if (_BitScanReverse64(&index, ticks))
+	{
+		index = min(index + 1, DS_INPUT_LATENCY_BUCKET_COUNT - 1);
+	}
+
+	pHistogram->Buckets[index]++;
+	pHistogram->Count++;
+
+	if (ticks > pHistogram->MaxTicks)
+	{
+		pHistogram->MaxTicks = ticks;
+	}
+}
+
+#define DS_INPUT_LATENCY_BEGIN(_stats_)				QueryPerformanceCounter(&(_stats_)->CompletionTime)
+#define DS_INPUT_LATENCY_END(_stats_, _stage_)		DS_INPUT_LATENCY_RECORD((_stats_), (_stage_))
+
+//
+// Upper bound of the bucket holding the given percentile (in 1/10 percent) in microseconds
+//
+ULONG
+DS_INPUT_LATENCY_PERCENTILE_US(
+	_In_ const PDS_INPUT_LATENCY_HISTOGRAM Histogram,
+	_In_ ULONG Permille
+);
+
+//
+// Converts QPC ticks to microseconds
+//
+ULONG
+DS_INPUT_LATENCY_TICKS_TO_US(
+	_In_ ULONGLONG Ticks
+);
+
+#else
+
+#define DS_INPUT_LATENCY_BEGIN(_stats_)				((void)0)
+#define DS_INPUT_LATENCY_END(_stats_, _stage_)		((void)0)
+
+#endif
@@ -2,6 +2,459 @@
 #include "InputReport.tmh"
 
 
+//
+// Compares the state carried by two reports of the current mode, ignoring stamped counters and timestamps
+// 
+static
+BOOLEAN
+DSHM_IsInputReportStateEqual(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ const UCHAR* Left,
+	_In_ const UCHAR* Right
+)
+{
+	const ULONG length = DeviceContext->InputReportConverters.ReportLength;
+
+	if (!DeviceContext->InputReportConverters.HasVolatileBits)
+	{
+		return RtlEqualMemory(Left, Right, length);
+	}
+
+	const PUCHAR pMask = DeviceContext->InputReportConverters.CompareMask;
+
+	for (ULONG index = 0; index < length; index++)
+	{
+		if (((Left[index] ^ Right[index]) & pMask[index]) != 0)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+//
+// Checks if the current input report equals the last submitted one of the same
+// type and the configured heartbeat period has not elapsed yet
+// 
+static
+BOOLEAN
+DSHM_IsInputReportUnchanged(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ const DMF_CONTEXT_DsHidMini* ModuleDeviceContext,
+	_In_ const PDS_SUBMITTED_INPUT_REPORT LastSubmitted,
+	_Out_ PLARGE_INTEGER Now
+)
+{
+	const PDS_INPUT_CHANGE_DETECTION_SETTINGS pSettings = &DeviceContext->Configuration.InputChangeDetection;
+
+	Now->QuadPart = 0;
+
+	if (!pSettings->IsEnabled)
+	{
+		return FALSE;
+	}
+
+	QueryPerformanceCounter(Now);
+
+	if (!LastSubmitted->IsValid
+		|| !DSHM_IsInputReportStateEqual(DeviceContext, LastSubmitted->Report, ModuleDeviceContext->InputReport))
+	{
+		return FALSE;
+	}
+
+	if (pSettings->HeartbeatPeriodMs == 0)
+	{
+		return TRUE;
+	}
+
+	const LONGLONG ms = (Now->QuadPart - LastSubmitted->Timestamp.QuadPart)
+		/ (DeviceContext->PerformanceFrequency.QuadPart / 1000);
+
+	return (ms < pSettings->HeartbeatPeriodMs) ? TRUE : FALSE;
+}
+
+//
+// Appends a report to the backlog, discarding the oldest one(s) if full
+//   Must be called with the backlog lock held
+// 
+static
+void
+DSHM_EnqueueInputReport(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ const PUCHAR Report,
+	_In_ ULONG Depth
+)
+{
+	while (DeviceContext->InputReportBacklog.Count >= Depth)
+	{
+		DeviceContext->InputReportBacklog.Head =
+			(DeviceContext->InputReportBacklog.Head + 1) % DS_INPUT_REPORT_BACKLOG_MAX_DEPTH;
+		DeviceContext->InputReportBacklog.Count--;
+		DeviceContext->InputReportBacklog.OverwrittenCount++;
+	}
+
+	const ULONG tail = (DeviceContext->InputReportBacklog.Head + DeviceContext->InputReportBacklog.Count)
+		% DS_INPUT_REPORT_BACKLOG_MAX_DEPTH;
+
+	RtlCopyMemory(
+		DeviceContext->InputReportBacklog.Reports[tail],
+		Report,
+		DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE
+	);
+	DeviceContext->InputReportBacklog.Count++;
+}
+
+//
+// Hands out buffered reports (oldest first) for as long as reads are pending
+//   Must be called with the backlog lock held
+// 
+static
+void
+DSHM_DeliverInputReports(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ DMF_CONTEXT_DsHidMini* ModuleDeviceContext
+)
+{
+	while (DeviceContext->InputReportBacklog.Count > 0)
+	{
+		const NTSTATUS status = DMF_VirtualHidMini_InputReportGenerate(
+			ModuleDeviceContext->DmfModuleVirtualHidMini,
+			DsHidMini_RetrieveNextInputReport
+		);
+
+		if (!NT_SUCCESS(status))
+		{
+			if (status != STATUS_NO_MORE_ENTRIES)
+			{
+				TraceError(
+					TRACE_DSHIDMINIDRV,
+					"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
+					status
+				);
+				EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
+			}
+
+			break;
+		}
+	}
+}
+
+//
+// Checks if the minimum interval since the last delivered report of the same type has not elapsed yet
+// 
+static
+BOOLEAN
+DSHM_IsInputReportThrottled(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ const PDS_SUBMITTED_INPUT_REPORT LastSubmitted,
+	_In_ const PLARGE_INTEGER Now
+)
+{
+	if (!LastSubmitted->IsValid)
+	{
+		return FALSE;
+	}
+
+	const LONGLONG interval = (DeviceContext->PerformanceFrequency.QuadPart / 1000)
+		* DeviceContext->Configuration.InputRateLimit.MinimumIntervalMs;
+
+	return ((Now->QuadPart - LastSubmitted->Timestamp.QuadPart) < interval) ? TRUE : FALSE;
+}
+
+//
+// Holds the current report back until the release timer fires, replacing any older held one
+//   If the interval already elapsed the report gets released right away instead, UMDF timers
+//   run at system timer resolution (typically 15.6 ms) so a short wait overshoots noticeably
+// 
+static
+void
+DSHM_HoldInputReport(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ DMF_CONTEXT_DsHidMini* ModuleDeviceContext,
+	_In_ ULONG Index
+)
+{
+	BOOLEAN isDue = FALSE;
+
+	WdfWaitLockAcquire(DeviceContext->InputReportBacklog.Lock, NULL);
+	{
+		if (DeviceContext->InputRateLimit.IsPending[Index])
+		{
+			DeviceContext->InputRateLimit.DecimatedCount++;
+		}
+
+		RtlCopyMemory(
+			DeviceContext->InputRateLimit.Reports[Index],
+			ModuleDeviceContext->InputReport,
+			DS3_COMMON_MAX_HID_INPUT_REPORT_SIZE
+		);
+		DeviceContext->InputRateLimit.IsPending[Index] = TRUE;
+
+		//
+		// Ticks are aligned to the last release so the delivery rate stays steady
+		// 
+		if (!DeviceContext->InputRateLimit.IsReleaseScheduled)
+		{
+			LARGE_INTEGER now;
+
+			QueryPerformanceCounter(&now);
+
+			const LONGLONG elapsedMs = (now.QuadPart - DeviceContext->InputRateLimit.LastReleaseTime.QuadPart)
+				/ (DeviceContext->PerformanceFrequency.QuadPart / 1000);
+			const LONGLONG interval = DeviceContext->Configuration.InputRateLimit.MinimumIntervalMs;
+
+			if (elapsedMs >= interval)
+			{
+				isDue = TRUE;
+			}
+			else
+			{
+				DeviceContext->InputRateLimit.IsReleaseScheduled = TRUE;
+
+				WdfTimerStart(
+					DeviceContext->InputRateLimit.ReleaseTimer,
+					WDF_REL_TIMEOUT_IN_MS(interval - elapsedMs)
+				);
+			}
+		}
+	}
+	WdfWaitLockRelease(DeviceContext->InputReportBacklog.Lock);
+
+	if (isDue)
+	{
+		DSHM_ReleaseHeldInputReports(DeviceContext, ModuleDeviceContext);
+	}
+}
+
+//
+// Discards a held report superseded by one equal to the last delivered state
+// 
+static
+void
+DSHM_DropHeldInputReport(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ ULONG Index
+)
+{
+	WdfWaitLockAcquire(DeviceContext->InputReportBacklog.Lock, NULL);
+	{
+		if (DeviceContext->InputRateLimit.IsPending[Index])
+		{
+			DeviceContext->InputRateLimit.IsPending[Index] = FALSE;
+			DeviceContext->InputRateLimit.DecimatedCount++;
+		}
+	}
+	WdfWaitLockRelease(DeviceContext->InputReportBacklog.Lock);
+}
+
+//
+// Notifies the HID class that a new input report is available
+//   Reports identical to the last submitted one of the same type are
+//   skipped unless the configured heartbeat period has elapsed. If no
+//   HID read is pending, the report is held back in the backlog until
+//   the next submission finds a pending read. Returns TRUE only if this
+//   very report got handed to a pending read, older backlog entries
+//   delivered along the way don't count.
+// 
+static
+BOOLEAN
+DSHM_SubmitInputReport(
+	_In_ const PDEVICE_CONTEXT DeviceContext,
+	_In_ DMF_CONTEXT_DsHidMini* ModuleDeviceContext,
+	_In_ const PDS_SUBMITTED_INPUT_REPORT LastSubmitted
+)
+{
+	NTSTATUS status;
+	LARGE_INTEGER now;
+	const PDS_INPUT_REPORT_BACKLOG_SETTINGS pBacklogSettings = &DeviceContext->Configuration.InputReportBacklog;
+	const DS_INPUT_RATE_LIMIT_POLICY ratePolicy = DeviceContext->Configuration.InputRateLimit.Policy;
+	const ULONG depth = pBacklogSettings->IsLatestOnly ? 1 : pBacklogSettings->Depth;
+	BOOLEAN isDelivered = FALSE;
+	const BOOLEAN isUnchanged = DSHM_IsInputReportUnchanged(
+		DeviceContext,
+		ModuleDeviceContext,
+		LastSubmitted,
+		&now
+	);
+
+	if (ratePolicy != DsInputRateLimitPolicyDisabled)
+	{
+		const ULONG index = (ULONG)(LastSubmitted - ModuleDeviceContext->LastSubmittedReports);
+
+		if (isUnchanged)
+		{
+			//
+			// Back to the delivered state, an intermediate held report would be stale by now
+			// 
+			if (ratePolicy == DsInputRateLimitPolicyLatestWins)
+			{
+				DSHM_DropHeldInputReport(DeviceContext, index);
+			}
+
+			return FALSE;
+		}
+
+		if (ratePolicy == DsInputRateLimitPolicyLatestWins)
+		{
+			DSHM_HoldInputReport(DeviceContext, ModuleDeviceContext, index);
+
+			return FALSE;
+		}
+
+		if (now.QuadPart == 0)
+		{
+			QueryPerformanceCounter(&now);
+		}
+
+		//
+		// Too early, LastSubmitted stays untouched so the change is picked up by the next report
+		// 
+		if (DSHM_IsInputReportThrottled(DeviceContext, LastSubmitted, &now))
+		{
+			DeviceContext->InputRateLimit.DecimatedCount++;
+			return FALSE;
+		}
+	}
+
+	//
+	// Deliver straight away and drop if nobody is listening
+	// 
+	if (depth == 0)
+	{
+		if (isUnchanged)
+		{
+			return FALSE;
+		}
+
+		//
+		// The retrieval callback inspects the backlog, which the release timer may touch concurrently
+		// 
+		WdfWaitLockAcquire(DeviceContext->InputReportBacklog.Lock, NULL);
+		{
+			status = DMF_VirtualHidMini_InputReportGenerate(
+				ModuleDeviceContext->DmfModuleVirtualHidMini,
+				DsHidMini_RetrieveNextInputReport
+			);
+
+			if (NT_SUCCESS(status))
+			{
+				RtlCopyMemory(LastSubmitted->Report, ModuleDeviceContext->InputReport, sizeof(LastSubmitted->Report));
+				LastSubmitted->Timestamp = now;
+				LastSubmitted->IsValid = TRUE;
+				isDelivered = TRUE;
+			}
+			else if (status == STATUS_NO_MORE_ENTRIES)
+			{
+				DeviceContext->InputReportBacklog.DroppedCount++;
+			}
+		}
+		WdfWaitLockRelease(DeviceContext->InputReportBacklog.Lock);
+
+		if (!NT_SUCCESS(status) && status != STATUS_NO_MORE_ENTRIES)
+		{
+			TraceError(
+				TRACE_DSHIDMINIDRV,
+				"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
+				status
+			);
+			EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
+		}
+
+		return isDelivered;
+	}
+
+	WdfWaitLockAcquire(DeviceContext->InputReportBacklog.Lock, NULL);
+	{
+		if (!isUnchanged)
+		{
+			DSHM_EnqueueInputReport(DeviceContext, ModuleDeviceContext->InputReport, depth);
+
+			RtlCopyMemory(LastSubmitted->Report, ModuleDeviceContext->InputReport, sizeof(LastSubmitted->Report));
+			LastSubmitted->Timestamp = now;
+			LastSubmitted->IsValid = TRUE;
+		}
+
+		DSHM_DeliverInputReports(DeviceContext, ModuleDeviceContext);
+
+		//
+		// The current report is the newest backlog entry, it's through once nothing is left behind
+		// 
+		isDelivered = (!isUnchanged && DeviceContext->InputReportBacklog.Count == 0);
+	}
+	WdfWaitLockRelease(DeviceContext->InputReportBacklog.Lock);
+
+	return isDelivered;
+}
+
+//
+// Releases the reports held back by the "latest wins" rate limit
+// 
+_Use_decl_annotations_
+void
+DSHM_ReleaseHeldInputReports(
+	_In_ PDEVICE_CONTEXT DeviceContext,
+	_In_ DMF_CONTEXT_DsHidMini* ModuleContext
+)
+{
+	const PDS_INPUT_REPORT_BACKLOG_SETTINGS pBacklogSettings = &DeviceContext->Configuration.InputReportBacklog;
+	const ULONG depth = pBacklogSettings->IsLatestOnly ? 1 : pBacklogSettings->Depth;
+
+	FuncEntry(TRACE_DSHIDMINIDRV);
+
+	WdfWaitLockAcquire(DeviceContext->InputReportBacklog.Lock, NULL);
+	{
+		LARGE_INTEGER now;
+
+		DeviceContext->InputRateLimit.IsReleaseScheduled = FALSE;
+		QueryPerformanceCounter(&now);
+
+		for (ULONG index = 0; index < ARRAYSIZE(DeviceContext->InputRateLimit.IsPending); index++)
+		{
+			if (!DeviceContext->InputRateLimit.IsPending[index])
+			{
+				continue;
+			}
+
+			const PDS_SUBMITTED_INPUT_REPORT pLastSubmitted = &ModuleContext->LastSubmittedReports[index];
+
+			//
+			// A tick with nothing left to release (held reports got dropped) doesn't restart the interval
+			// 
+			DeviceContext->InputRateLimit.LastReleaseTime = now;
+			DeviceContext->InputRateLimit.IsPending[index] = FALSE;
+
+			//
+			// Routed through the backlog, the report buffer belongs to the input completion path
+			//   Room for both report types is made so a primary report doesn't get lost to its secondary
+			// 
+			DSHM_EnqueueInputReport(
+				DeviceContext,
+				DeviceContext->InputRateLimit.Reports[index],
+				max(depth, (ULONG)ARRAYSIZE(DeviceContext->InputRateLimit.IsPending))
+			);
+
+			RtlCopyMemory(pLastSubmitted->Report, DeviceContext->InputRateLimit.Reports[index], sizeof(pLastSubmitted->Report));
+			pLastSubmitted->Timestamp = now;
+			pLastSubmitted->IsValid = TRUE;
+		}
+
+		DSHM_DeliverInputReports(DeviceContext, ModuleContext);
+
+		//
+		// Without backlog whatever found no pending read is lost
+		// 
+		if (depth == 0 && DeviceContext->InputReportBacklog.Count > 0)
+		{
+			DeviceContext->InputReportBacklog.DroppedCount += DeviceContext->InputReportBacklog.Count;
+			DeviceContext->InputReportBacklog.Count = 0;
+		}
+	}
+	WdfWaitLockRelease(DeviceContext->InputReportBacklog.Lock);
+
+	FuncExitNoReturn(TRACE_DSHIDMINIDRV);
+}
+
 //
 // Protocol-agnostic function that transforms the raw input report to HID-mode-compatible ones
 // 
@@ -15,6 +468,16 @@ DSHM_ParseInputReport(
 {
 	FuncEntry(TRACE_DSHIDMINIDRV);
 
+	//
+	// Motion calibration only learns while nobody is handling the controller
+	// 
+	DS3_MOTION_UPDATE(
+		&DeviceContext->Motion,
+		&DeviceContext->Configuration.Motion,
+		Report,
+		DS3_RAW_IS_IDLE(Report)
+	);
+
 #pragma region IPC Copy
 
 	const WDFDRIVER driver = WdfGetDriver();
@@ -33,194 +496,155 @@ DSHM_ParseInputReport(
 		const size_t offset = (sizeof(IPC_HID_INPUT_REPORT_MESSAGE) * (DeviceContext->SlotIndex - 1));
 		const PIPC_HID_INPUT_REPORT_MESSAGE pHIDBuffer = (PIPC_HID_INPUT_REPORT_MESSAGE)(pDrvCtx->IPC.SharedRegions.HID.Buffer +
 			offset);
-
+		// motion values live in their own array behind the input report slots (if it fits the region)
+		const PIPC_HID_MOTION_MESSAGE pMotionBuffer = pDrvCtx->IPC.SharedRegions.HID.IsMotionAvailable
+			? (PIPC_HID_MOTION_MESSAGE)(pDrvCtx->IPC.SharedRegions.HID.Buffer +
+				DSHM_IPC_HID_MOTION_REGION_OFFSET + (sizeof(IPC_HID_MOTION_MESSAGE) * (DeviceContext->SlotIndex - 1)))
+			: NULL;
+
+		// odd sequence tells readers an update is in progress
+		if (pMotionBuffer)
+		{
+			InterlockedIncrement(&pMotionBuffer->Sequence);
+		}
 		// prefix each report with associated device index
 		pHIDBuffer->SlotIndex = DeviceContext->SlotIndex;
 		// skip index and copy unmodified raw report to the section
 		RtlCopyMemory(&pHIDBuffer->InputReport, Report, sizeof(DS3_RAW_INPUT_REPORT));
+		if (pMotionBuffer)
+		{
+			// calibrated motion values
+			pMotionBuffer->SlotIndex = DeviceContext->SlotIndex;
+			RtlCopyMemory(&pMotionBuffer->Motion, &DeviceContext->Motion.Sample, sizeof(DS3_MOTION_SAMPLE));
+			// both copies are consistent again
+			InterlockedIncrement(&pMotionBuffer->Sequence);
+		}
 
 		// signal any reader that there is new data available
 		SetEvent(DeviceContext->IPC.InputReportWaitHandle);
+
+		DS_INPUT_LATENCY_END(&DeviceContext->InputLatency, DsInputLatencyStageIpcPublish);
 	}
 
 #pragma endregion
 
-#pragma region HID Input Report (SDF, GPJ ID 01) processing
+#pragma region HID Input Report processing
 
-	switch (DeviceContext->Configuration.HidDeviceMode) // NOLINT(clang-diagnostic-switch-enum)
+	//
+	// Raw passthrough skips shaping and conversion, consumers get the native report as received
+	// 
+	if (DeviceContext->Configuration.HidDeviceMode == DsHidMiniDeviceModeRaw)
 	{
-	case DsHidMiniDeviceModeGPJ:
+		const PDS3_RAW_PASSTHROUGH_HID_INPUT_REPORT pRaw = (PDS3_RAW_PASSTHROUGH_HID_INPUT_REPORT)ModuleDeviceContext->InputReport;
 
-		DS3_RAW_TO_GPJ_HID_INPUT_REPORT_01(
-			Report,
-			ModuleDeviceContext->InputReport,
-			DeviceContext->Configuration.GPJ.PressureExposureMode,
-			DeviceContext->Configuration.GPJ.DPadExposureMode,
-			&DeviceContext->Configuration.ThumbSettings,
-			&DeviceContext->Configuration.FlipAxis
-		);
+		pRaw->ReportId = 0x01;
+		RtlCopyMemory(&pRaw->Report, Report, sizeof(DS3_RAW_INPUT_REPORT));
+		pRaw->Timestamp = DeviceContext->InputInterval.Stats.LastTimestamp;
 
-#ifdef DBG
-		DumpAsHex(">> MULTI", ModuleDeviceContext->InputReport, DS3_SDF_GPJ_HID_INPUT_REPORT_SIZE);
-#endif
+		DS_INPUT_LATENCY_END(&DeviceContext->InputLatency, DsInputLatencyStagePostTransform);
 
-		break;
-	case DsHidMiniDeviceModeSDF:
-
-		DS3_RAW_TO_SDF_HID_INPUT_REPORT(
-			Report,
-			ModuleDeviceContext->InputReport,
-			DeviceContext->Configuration.SDF.PressureExposureMode,
-			DeviceContext->Configuration.SDF.DPadExposureMode,
-			&DeviceContext->Configuration.ThumbSettings,
-			&DeviceContext->Configuration.FlipAxis
-		);
+		if (DSHM_SubmitInputReport(
+			DeviceContext,
+			ModuleDeviceContext,
+			&ModuleDeviceContext->LastSubmittedReports[0]
+		))
+		{
+			DS_INPUT_LATENCY_END(&DeviceContext->InputLatency, DsInputLatencyStageHidSubmit);
+		}
 
-		break;
-	default:
-		break;
+		FuncExitNoReturn(TRACE_DSHIDMINIDRV);
+		return;
 	}
 
 	//
-	// Notify new Input Report is available
+	// Gate and shape pressure values and calibrate motion once so all converters report the same response
 	// 
-	NTSTATUS status = DMF_VirtualHidMini_InputReportGenerate(
-		ModuleDeviceContext->DmfModuleVirtualHidMini,
-		DsHidMini_RetrieveNextInputReport
-	);
-	if (!NT_SUCCESS(status) && status != STATUS_NO_MORE_ENTRIES)
+	DS3_RAW_INPUT_REPORT shapedReport;
+	PDS3_RAW_INPUT_REPORT pInput = Report;
+	const PDS_PRESSURE_NOISE_GATE_SETTINGS pNoiseGate = &DeviceContext->Configuration.PressureNoiseGate;
+	const BOOLEAN isMotionCalibrated = (DeviceContext->Motion.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED) != 0;
+
+	if (pNoiseGate->IsEnabled || DeviceContext->PressureLookupTables.IsActive || isMotionCalibrated)
 	{
-		TraceError(
-			TRACE_DSHIDMINIDRV,
-			"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
-			status
-		);
-		EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
+		RtlCopyMemory(&shapedReport, Report, sizeof(DS3_RAW_INPUT_REPORT));
+		pInput = &shapedReport;
 	}
 
-#pragma endregion
-
-#pragma region HID Input Report (GPJ ID 02) processing
-
-	if (DeviceContext->Configuration.HidDeviceMode == DsHidMiniDeviceModeGPJ
-		&& (DeviceContext->Configuration.GPJ.PressureExposureMode & DsPressureExposureModeAnalogue) != 0)
+	if (pNoiseGate->IsEnabled)
 	{
-		DS3_RAW_TO_GPJ_HID_INPUT_REPORT_02(
-			Report,
-			ModuleDeviceContext->InputReport
-		);
-
-		//
-		// Notify new Input Report is available
-		// 
-		status = DMF_VirtualHidMini_InputReportGenerate(
-			ModuleDeviceContext->DmfModuleVirtualHidMini,
-			DsHidMini_RetrieveNextInputReport
+		DS3_PRESSURE_NOISE_GATE_APPLY(
+			pNoiseGate->Thresholds,
+			DeviceContext->PressureNoiseGateValues,
+			&shapedReport
 		);
-		if (!NT_SUCCESS(status) && status != STATUS_NO_MORE_ENTRIES)
-		{
-			TraceError(
-				TRACE_DSHIDMINIDRV,
-				"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
-				status
-			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
-		}
 	}
 
-#pragma endregion
+	if (DeviceContext->PressureLookupTables.IsActive)
+	{
+		DS3_PRESSURE_LUT_APPLY(&DeviceContext->PressureLookupTables, &shapedReport);
+	}
 
-#pragma region HID Input Report (SIXAXIS compatible) processing
+	if (isMotionCalibrated)
+	{
+		DS3_MOTION_APPLY(&DeviceContext->Motion, &shapedReport);
+	}
 
+	//
+	// Handle special case of SIXAXIS.SYS emulation
+	// 
 	if (DeviceContext->Configuration.HidDeviceMode == DsHidMiniDeviceModeSixaxisCompatible)
 	{
-		DS3_RAW_TO_SIXAXIS_HID_INPUT_REPORT(
-			Report,
-			ModuleDeviceContext->InputReport,
-			&DeviceContext->Configuration.ThumbSettings,
-			&DeviceContext->Configuration.FlipAxis
-		);
-
-		//
-		// Notify new Input Report is available
-		// 
-		status = DMF_VirtualHidMini_InputReportGenerate(
-			ModuleDeviceContext->DmfModuleVirtualHidMini,
-			DsHidMini_RetrieveNextInputReport
-		);
-		if (!NT_SUCCESS(status) && status != STATUS_NO_MORE_ENTRIES)
-		{
-			TraceError(
-				TRACE_DSHIDMINIDRV,
-				"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
-				status
-			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
-		}
+		DSHM_UpdateSixaxisFeatureSource(DeviceContext, pInput);
 	}
 
-#pragma endregion
-
-#pragma region HID Input Report (DualShock 4 Rev1 compatible) processing
+	//
+	// Converters got selected on configuration (re-)load, no mode checks required here
+	// 
+	const PFN_DS3_RAW_TO_HID_INPUT_REPORT pfnPrimary = DeviceContext->InputReportConverters.Primary;
+	const PFN_DS3_RAW_TO_HID_INPUT_REPORT pfnSecondary = DeviceContext->InputReportConverters.Secondary;
 
-	if (DeviceContext->Configuration.HidDeviceMode == DsHidMiniDeviceModeDS4WindowsCompatible)
+	if (pfnPrimary)
 	{
-		DS3_RAW_TO_DS4WINDOWS_HID_INPUT_REPORT(
-			Report,
+		pfnPrimary(
+			pInput,
 			ModuleDeviceContext->InputReport,
-			(DeviceContext->ConnectionType == DsDeviceConnectionTypeUsb) ? TRUE : FALSE,
-			&DeviceContext->Configuration.ThumbSettings,
-			&DeviceContext->Configuration.FlipAxis
+			&DeviceContext->ThumbLookupTables,
+			&DeviceContext->PerformanceFrequency
 		);
 
+		DS_INPUT_LATENCY_END(&DeviceContext->InputLatency, DsInputLatencyStagePostTransform);
+
 		//
-		// Notify new Input Report is available
+		// Only the primary report counts towards submit latency, and only if it went out right away.
+		// Skipped, held back or backlogged reports don't count at all
 		// 
-		status = DMF_VirtualHidMini_InputReportGenerate(
-			ModuleDeviceContext->DmfModuleVirtualHidMini,
-			DsHidMini_RetrieveNextInputReport
-		);
-		if (!NT_SUCCESS(status) && status != STATUS_NO_MORE_ENTRIES)
+		if (DSHM_SubmitInputReport(
+			DeviceContext,
+			ModuleDeviceContext,
+			&ModuleDeviceContext->LastSubmittedReports[0]
+		))
 		{
-			TraceError(
-				TRACE_DSHIDMINIDRV,
-				"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
-				status
-			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
+			DS_INPUT_LATENCY_END(&DeviceContext->InputLatency, DsInputLatencyStageHidSubmit);
 		}
 	}
 
-#pragma endregion
-
-#pragma region HID Input Report (XINPUT compatible HID device) processing
-
-	if (DeviceContext->Configuration.HidDeviceMode == DsHidMiniDeviceModeXInputHIDCompatible)
+	//
+	// Additional report (GPJ ID 02)
+	// 
+	if (pfnSecondary)
 	{
-		DS3_RAW_TO_XINPUTHID_HID_INPUT_REPORT(
-			Report,
-			// ReSharper disable once CppRedundantCastExpression
-			(PXINPUT_HID_INPUT_REPORT)ModuleDeviceContext->InputReport,
-			&DeviceContext->Configuration.ThumbSettings,
-			&DeviceContext->Configuration.FlipAxis
+		pfnSecondary(
+			pInput,
+			ModuleDeviceContext->InputReport,
+			&DeviceContext->ThumbLookupTables,
+			&DeviceContext->PerformanceFrequency
 		);
 
-		//
-		// Notify new Input Report is available
-		// 
-		status = DMF_VirtualHidMini_InputReportGenerate(
-			ModuleDeviceContext->DmfModuleVirtualHidMini,
-			DsHidMini_RetrieveNextInputReport
+		(void)DSHM_SubmitInputReport(
+			DeviceContext,
+			ModuleDeviceContext,
+			&ModuleDeviceContext->LastSubmittedReports[1]
 		);
-		if (!NT_SUCCESS(status) && status != STATUS_NO_MORE_ENTRIES)
-		{
-			TraceError(
-				TRACE_DSHIDMINIDRV,
-				"DMF_VirtualHidMini_InputReportGenerate failed with status %!STATUS!",
-				status
-			);
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_VirtualHidMini_InputReportGenerate", status);
-		}
 	}
 
 #pragma endregion
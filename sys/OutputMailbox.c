@@ -0,0 +1,170 @@
+#include "DsPortable.h"
+#include "OutputMailbox.h"
+
+
+//
+// Lane a byte of the wire report belongs to, offsets in the common layout as used by DS3_SET_OUTPUT_REPORT_BODY
+//
+static DS_OUTPUT_LANE
+DS_OUTPUT_MAILBOX_LANE_OF(
+	const PDS_OUTPUT_MAILBOX Mailbox,
+	ULONG Offset
+)
+{
+	if (Offset < Mailbox->HeaderLength)
+	{
+		return DsOutputLaneControl;
+	}
+
+	const ULONG offset = Offset - Mailbox->HeaderLength;
+
+	if (offset >= 1 && offset <= 4)
+	{
+		return DsOutputLaneRumble;
+	}
+
+	if (offset >= 9 && offset <= 29)
+	{
+		return DsOutputLaneLed;
+	}
+
+	return DsOutputLaneControl;
+}
+
+//
+// Resets to an empty mailbox
+//
+VOID
+DS_OUTPUT_MAILBOX_INIT(
+	PDS_OUTPUT_MAILBOX Mailbox,
+	ULONG HeaderLength
+)
+{
+	RtlZeroMemory(Mailbox, sizeof(DS_OUTPUT_MAILBOX));
+
+	Mailbox->HeaderLength = HeaderLength;
+	Mailbox->PendingPriority = MAXULONG;
+}
+
+//
+// Stores the latest full report and returns the lanes whose content changed
+//
+ULONG
+DS_OUTPUT_MAILBOX_UPDATE(
+	PDS_OUTPUT_MAILBOX Mailbox,
+	const UCHAR* Buffer,
+	ULONG Length
+)
+{
+	ULONG changed = 0;
+
+	Length = min(Length, DS_OUTPUT_MAILBOX_REPORT_SIZE);
+
+	for (ULONG offset = 0; offset < Length; offset++)
+	{
+		if (Mailbox->Report[offset] != Buffer[offset])
+		{
+			changed |= DS_OUTPUT_LANE_FLAG(DS_OUTPUT_MAILBOX_LANE_OF(Mailbox, offset));
+			Mailbox->Report[offset] = Buffer[offset];
+		}
+	}
+
+	if (!Mailbox->IsContentValid || Length != Mailbox->ReportLength)
+	{
+		changed = DS_OUTPUT_LANE_FLAGS_ALL;
+	}
+
+	Mailbox->ReportLength = Length;
+	Mailbox->IsContentValid = TRUE;
+
+	return changed;
+}
+
+//
+// Marks lanes as due for sending, lower priority values are more urgent
+//
+VOID
+DS_OUTPUT_MAILBOX_POST(
+	PDS_OUTPUT_MAILBOX Mailbox,
+	ULONG Lanes,
+	ULONG Priority
+)
+{
+	Mailbox->PostCount++;
+
+	if (Mailbox->PendingLanes != 0)
+	{
+		Mailbox->CoalescedCount++;
+	}
+
+	Mailbox->PendingLanes |= (Lanes & DS_OUTPUT_LANE_FLAGS_ALL);
+
+	//
+	// A more urgent post must not lose its priority to a later, less urgent one
+	//
+	if (Priority < Mailbox->PendingPriority)
+	{
+		Mailbox->PendingPriority = Priority;
+	}
+}
+
+//
+// Copies the merged report if anything is pending and empties the mailbox
+//
+BOOLEAN
+DS_OUTPUT_MAILBOX_TAKE(
+	PDS_OUTPUT_MAILBOX Mailbox,
+	UCHAR* Buffer,
+	ULONG BufferLength,
+	PULONG Length,
+	PULONG Lanes
+)
+{
+	*Length = 0;
+	*Lanes = 0;
+
+	if (Mailbox->PendingLanes == 0 || BufferLength < Mailbox->ReportLength)
+	{
+		return FALSE;
+	}
+
+	for (ULONG offset = 0; offset < Mailbox->ReportLength; offset++)
+	{
+		Buffer[offset] = Mailbox->Report[offset];
+	}
+
+	*Length = Mailbox->ReportLength;
+	*Lanes = Mailbox->PendingLanes;
+
+	Mailbox->PendingLanes = 0;
+	Mailbox->PendingPriority = MAXULONG;
+	Mailbox->TakeCount++;
+
+	return TRUE;
+}
+
+//
+// Raises the urgency of what's already pending without counting as a post
+//
+VOID
+DS_OUTPUT_MAILBOX_ESCALATE(
+	PDS_OUTPUT_MAILBOX Mailbox,
+	ULONG Priority
+)
+{
+	if (Mailbox->PendingLanes != 0 && Priority < Mailbox->PendingPriority)
+	{
+		Mailbox->PendingPriority = Priority;
+	}
+}
+
+//
+// Forgets what the device state is, the next update counts every lane as changed
+//
+VOID
+DS_OUTPUT_MAILBOX_INVALIDATE(
+	PDS_OUTPUT_MAILBOX Mailbox
+)
+{
+	Mailbox->IsContentValid = FALSE;
+}
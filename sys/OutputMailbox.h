@@ -0,0 +1,131 @@
+#pragma once
+
+//
+// Latest-wins output report mailbox
+//   Producers update the lanes of the device state, the output worker takes whatever
+//   is pending as one merged report. Posts arriving faster than the worker can send
+//   replace each other instead of queueing up, so a sent report is never older than
+//   one send period. Pure integer code depending on DsPortable.h only, the caller
+//   provides the locking.
+//
+
+//
+// Largest output report (Bluetooth, including the 2 bytes of transport header)
+//
+#define DS_OUTPUT_MAILBOX_REPORT_SIZE		0x32
+
+//
+// Independently updated portions of the output report
+//
+typedef enum _DS_OUTPUT_LANE
+{
+	//
+	// Rumble durations and strengths
+	//
+	DsOutputLaneRumble = 0,
+
+	//
+	// LED flags and blink patterns
+	//
+	DsOutputLaneLed,
+
+	//
+	// Everything else (transport header, report ID, reserved bytes)
+	//
+	DsOutputLaneControl,
+
+	DsOutputLaneCount
+
+} DS_OUTPUT_LANE;
+
+#define DS_OUTPUT_LANE_FLAG(_lane_)		(1UL << (_lane_))
+#define DS_OUTPUT_LANE_FLAGS_ALL		((1UL << DsOutputLaneCount) - 1)
+
+typedef struct _DS_OUTPUT_MAILBOX
+{
+	//
+	// Latest content of all lanes, laid out as the wire report
+	//
+	UCHAR Report[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+
+	//
+	// Valid bytes in Report
+	//
+	ULONG ReportLength;
+
+	//
+	// Transport-specific bytes preceding the common report layout (1 on USB, 2 on Bluetooth)
+	//
+	ULONG HeaderLength;
+
+	//
+	// FALSE until the first update and after invalidation, every lane then counts as changed
+	//
+	BOOLEAN IsContentValid;
+
+	//
+	// Lanes posted but not taken by the worker yet
+	//
+	ULONG PendingLanes;
+
+	//
+	// Most urgent (lowest) priority among the pending posts, MAXULONG if none
+	//
+	ULONG PendingPriority;
+
+	//
+	// Number of posts
+	//
+	ULONGLONG PostCount;
+
+	//
+	// Posts that replaced content the worker hadn't taken yet
+	//
+	ULONGLONG CoalescedCount;
+
+	//
+	// Merged reports handed to the worker
+	//
+	ULONGLONG TakeCount;
+
+} DS_OUTPUT_MAILBOX, * PDS_OUTPUT_MAILBOX;
+
+VOID
+DS_OUTPUT_MAILBOX_INIT(
+	_Out_ PDS_OUTPUT_MAILBOX Mailbox,
+	_In_ ULONG HeaderLength
+);
+
+ULONG
+DS_OUTPUT_MAILBOX_UPDATE(
+	_Inout_ PDS_OUTPUT_MAILBOX Mailbox,
+	_In_reads_bytes_(Length) const UCHAR* Buffer,
+	_In_ ULONG Length
+);
+
+VOID
+DS_OUTPUT_MAILBOX_POST(
+	_Inout_ PDS_OUTPUT_MAILBOX Mailbox,
+	_In_ ULONG Lanes,
+	_In_ ULONG Priority
+);
+
+BOOLEAN
+DS_OUTPUT_MAILBOX_TAKE(
+	_Inout_ PDS_OUTPUT_MAILBOX Mailbox,
+	_Out_writes_bytes_(BufferLength) UCHAR* Buffer,
+	_In_ ULONG BufferLength,
+	_Out_ PULONG Length,
+	_Out_ PULONG Lanes
+);
+
+VOID
+DS_OUTPUT_MAILBOX_ESCALATE(
+	_Inout_ PDS_OUTPUT_MAILBOX Mailbox,
+	_In_ ULONG Priority
+);
+
+VOID
+DS_OUTPUT_MAILBOX_INVALIDATE(
+	_Inout_ PDS_OUTPUT_MAILBOX Mailbox
+);
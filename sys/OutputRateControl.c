@@ -0,0 +1,112 @@
+#include "DsPortable.h"
+#include "OutputRateControl.h"
+
+
+//
+// Resets to the shortest period, counters included. The first slow send backs off from there
+//
+VOID
+DS_OUTPUT_RATE_CONTROL_INIT(
+	PDS_OUTPUT_RATE_CONTROL Control,
+	ULONG MinPeriod,
+	ULONG MaxPeriod
+)
+{
+	RtlZeroMemory(Control, sizeof(DS_OUTPUT_RATE_CONTROL));
+
+	Control->MinPeriod = min(MinPeriod, MaxPeriod);
+	Control->MaxPeriod = MaxPeriod;
+	Control->Period = Control->MinPeriod;
+	Control->PeakPeriod = Control->MinPeriod;
+}
+
+//
+// Microseconds to wait from Now before the next send is allowed
+//
+ULONG
+DS_OUTPUT_RATE_CONTROL_GET_DELAY(
+	const PDS_OUTPUT_RATE_CONTROL Control,
+	ULONGLONG Now
+)
+{
+	const ULONGLONG last = Control->LastSendTimestamp;
+
+	if (last == 0 || Now < last || (Now - last) >= Control->Period)
+	{
+		return 0;
+	}
+
+	return Control->Period - (ULONG)(Now - last);
+}
+
+//
+// Feeds a finished send back into the period
+//
+VOID
+DS_OUTPUT_RATE_CONTROL_COMPLETE(
+	PDS_OUTPUT_RATE_CONTROL Control,
+	ULONGLONG SendTimestamp,
+	ULONGLONG CompletionTimestamp,
+	BOOLEAN IsSuccess
+)
+{
+	const ULONG completion = (CompletionTimestamp > SendTimestamp)
+		? (ULONG)min(CompletionTimestamp - SendTimestamp, MAXULONG / DS_OUTPUT_RATE_CONTROL_SMOOTHING)
+		: 0;
+	ULONG period = Control->Period;
+
+	Control->SendCount++;
+	Control->LastSendTimestamp = CompletionTimestamp;
+
+	if (Control->SmoothedCompletion == 0)
+	{
+		Control->SmoothedCompletion = completion * DS_OUTPUT_RATE_CONTROL_SMOOTHING;
+	}
+	else
+	{
+		Control->SmoothedCompletion = Control->SmoothedCompletion
+			- (Control->SmoothedCompletion / DS_OUTPUT_RATE_CONTROL_SMOOTHING)
+			+ completion;
+	}
+
+	if (!IsSuccess)
+	{
+		Control->FailureCount++;
+	}
+
+	if (!IsSuccess || completion > period)
+	{
+		//
+		// The link can't keep up, at least wait as long as this send took
+		//
+		period = max(period * DS_OUTPUT_RATE_CONTROL_BACKOFF_FACTOR, completion);
+		period = max(period, DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US);
+		period = min(period, Control->MaxPeriod);
+
+		if (period > Control->Period)
+		{
+			Control->BackoffCount++;
+		}
+	}
+	else
+	{
+		//
+		// Probe for a shorter period, never below what the link takes on average
+		//
+		const ULONG average = Control->SmoothedCompletion / DS_OUTPUT_RATE_CONTROL_SMOOTHING;
+
+		period = (period > DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US)
+			? period - DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US
+			: 0;
+		period = max(period, average);
+		period = max(period, Control->MinPeriod);
+		period = min(period, Control->MaxPeriod);
+	}
+
+	Control->Period = period;
+
+	if (period > Control->PeakPeriod)
+	{
+		Control->PeakPeriod = period;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+//
+// Adaptive output rate control (AIMD)
+//   Sizes the minimum interval between two output reports from the observed send
+//   completion times. Failures and sends taking longer than the current period back
+//   off multiplicatively, every timely send shortens the period by a fixed step.
+//   Pure integer code without WDF dependencies, timestamps are supplied by the caller
+//   in microseconds.
+//
+
+//
+// Period decrease per timely send in microseconds
+//
+#define DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US		1000
+
+//
+// Period multiplier on backoff
+//
+#define DS_OUTPUT_RATE_CONTROL_BACKOFF_FACTOR		2
+
+//
+// Weight of a new sample in the smoothed completion time (1/N)
+//
+#define DS_OUTPUT_RATE_CONTROL_SMOOTHING			8
+
+typedef struct _DS_OUTPUT_RATE_CONTROL
+{
+	//
+	// Bounds of Period in microseconds
+	//
+	ULONG MinPeriod;
+	ULONG MaxPeriod;
+
+	//
+	// Current minimum interval between two sends in microseconds
+	//
+	ULONG Period;
+
+	//
+	// Completion time average, scaled by DS_OUTPUT_RATE_CONTROL_SMOOTHING, 0 if no sample yet
+	//
+	ULONG SmoothedCompletion;
+
+	//
+	// Completion time of the last send, 0 if none yet
+	//
+	ULONGLONG LastSendTimestamp;
+
+	//
+	// Number of completed sends
+	//
+	ULONGLONG SendCount;
+
+	//
+	// Sends the link reported as failed
+	//
+	ULONGLONG FailureCount;
+
+	//
+	// Number of times Period got increased
+	//
+	ULONGLONG BackoffCount;
+
+	//
+	// Largest Period reached
+	//
+	ULONG PeakPeriod;
+
+} DS_OUTPUT_RATE_CONTROL, * PDS_OUTPUT_RATE_CONTROL;
+
+VOID
+DS_OUTPUT_RATE_CONTROL_INIT(
+	_Out_ PDS_OUTPUT_RATE_CONTROL Control,
+	_In_ ULONG MinPeriod,
+	_In_ ULONG MaxPeriod
+);
+
+ULONG
+DS_OUTPUT_RATE_CONTROL_GET_DELAY(
+	_In_ const PDS_OUTPUT_RATE_CONTROL Control,
+	_In_ ULONGLONG Now
+);
+
+VOID
+DS_OUTPUT_RATE_CONTROL_COMPLETE(
+	_Inout_ PDS_OUTPUT_RATE_CONTROL Control,
+	_In_ ULONGLONG SendTimestamp,
+	_In_ ULONGLONG CompletionTimestamp,
+	_In_ BOOLEAN IsSuccess
+);
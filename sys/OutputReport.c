@@ -1,9 +1,68 @@
 #include "Driver.h"
 #include "OutputReport.tmh"
 
+//
+// Time a single output report send may take before it gets cancelled
+// 
+#define DSHM_OUTPUT_REPORT_SEND_TIMEOUT_MS		1000
+
+
+//
+// Checks whether a report that changed no mailbox lane needs to go out anyway
+//   The mailbox holds the state the device ends up in once the worker is done, so
+//   an update without changed lanes is a duplicate. Must be called with the output
+//   report lock held.
+//
+static
+BOOLEAN
+DSHM_IsDuplicateOutputReport(
+	_In_ const PDEVICE_CONTEXT Context,
+	_In_ const DS_OUTPUT_REPORT_SOURCE Source,
+	_In_ const ULONG ChangedLanes,
+	_In_ const PLARGE_INTEGER Now
+)
+{
+	const PDS_DRIVER_CONFIGURATION pConfig = &Context->Configuration;
+
+	//
+	// Driver-initiated updates (power-up, configuration changes) always go out
+	// 
+	if (!pConfig->IsOutputDeduplicatorEnabled
+		|| Source == Ds3OutputReportSourceDriverHighPriority
+		|| ChangedLanes != 0)
+	{
+		return FALSE;
+	}
+
+	//
+	// Periodically repeat the state so the device doesn't time out on e.g. rumble
+	// 
+	if (pConfig->OutputDeduplicatorRefreshPeriodMs > 0)
+	{
+		const LONGLONG ms = (Now->QuadPart - Context->OutputReport.Deduplicator.LastPostedTimestamp.QuadPart)
+			/ (Context->PerformanceFrequency.QuadPart / 1000);
+
+		if (ms >= (LONGLONG)pConfig->OutputDeduplicatorRefreshPeriodMs)
+		{
+			Context->OutputReport.Deduplicator.RefreshCount++;
+			return FALSE;
+		}
+	}
+
+	Context->OutputReport.Deduplicator.DroppedCount++;
+
+	TraceVerbose(
+		TRACE_DSHIDMINIDRV,
+		"Dropping duplicate output report (source %d)",
+		Source
+	);
+
+	return TRUE;
+}
+
 
 //
-// Enqueues current output report buffer to get sent to device.
+// Posts current output report buffer to the mailbox to get sent to device.
 //
 _Use_decl_annotations_
 NTSTATUS
@@ -14,10 +73,13 @@ DSHM_SendOutputReport(
 {
 	FuncEntry(TRACE_DSHIDMINIDRV);
 
-	NTSTATUS status;
-	PUCHAR sourceBuffer, sendBuffer;
-	size_t sourceBufferLength;
-	PDS_OUTPUT_REPORT_CONTEXT sendContext;
+	NTSTATUS status = STATUS_SUCCESS;
+	PUCHAR sourceBuffer;
+	ULONG sourceBufferLength;
+	ULONG changedLanes;
+	BOOLEAN isChanged;
+	BOOLEAN isPosted = FALSE;
+	LARGE_INTEGER now;
 	const PDS_DRIVER_CONFIGURATION pConfig = &Context->Configuration;	
 
 	WdfWaitLockAcquire(Context->OutputReport.Lock, NULL);
@@ -25,29 +87,13 @@ DSHM_SendOutputReport(
 	do
 	{
 		//
-		// Grab new buffer to send
-		//
-		if (!NT_SUCCESS(status = DMF_ThreadedBufferQueue_Fetch(
-			Context->OutputReport.Worker,
-			(PVOID*)&sendBuffer,
-			(PVOID*)&sendContext
-		)))
-		{
-			TraceError(
-				TRACE_DSHIDMINIDRV,
-				"DMF_ThreadedBufferQueue_Fetch failed with status %!STATUS!",
-				status
-			);
-
-			EventWriteFailedWithNTStatus(__FUNCTION__, L"DMF_ThreadedBufferQueue_Fetch", status);
-
-			break;
-		}
-
-		//
-		// Override LED pattern
+		// Override LED pattern, only needed if something touched the LEDs since or
+		// the device state is unknown
 		// 
-		if (pConfig->LEDSettings.Mode == DsLEDModeCustomPattern)
+		if (pConfig->LEDSettings.Mode == DsLEDModeCustomPattern
+			&& ((Context->OutputReport.Shadow.DirtyFields & DS_OUTPUT_SHADOW_FIELDS_LED) != 0
+				|| !Context->OutputReport.Mailbox.IsContentValid
+				|| Source == Ds3OutputReportSourceDriverHighPriority))
 		{
 			DS3_SET_LED_FLAGS(Context, pConfig->LEDSettings.CustomPatterns.LEDFlags);
 
@@ -86,233 +132,393 @@ DSHM_SendOutputReport(
 		}
 
 		//
-		// Get full report (including IDs etc.)
+		// Build full report (including IDs etc.) from the fields changed since the last one
 		//
-		DS3_GET_RAW_OUTPUT_REPORT_BUFFER(
+		isChanged = DS3_COMMIT_OUTPUT_SHADOW(
 			Context,
 			&sourceBuffer,
 			&sourceBufferLength
 		);
 
-		// 
-		// Timestamp arrival
+		QueryPerformanceCounter(&now);
+
 		//
-		QueryPerformanceCounter(&sendContext->ReceivedTimestamp);
+		// Merge into the latest state, anything not yet sent gets replaced
+		//   A clean shadow rebuilt the report already merged last time, so it can't change
+		//   any lane unless the mailbox content got invalidated meanwhile
 		// 
-		// Real buffer length
-		// 
-		sendContext->BufferSize = sourceBufferLength;
-		//
-		// Store origin
-		//
-		sendContext->ReportSource = Source;
+		if (isChanged || !Context->OutputReport.Mailbox.IsContentValid)
+		{
+			changedLanes = DS_OUTPUT_MAILBOX_UPDATE(
+				&Context->OutputReport.Mailbox,
+				sourceBuffer,
+				sourceBufferLength
+			);
+		}
+		else
+		{
+			changedLanes = 0;
+			Context->OutputReport.Shadow.SkippedCount++;
+		}
 
 		//
-		// Copy current report to buffer
-		//
-		RtlCopyMemory(sendBuffer, sourceBuffer, sourceBufferLength);
+		// Drop the report if the device already is or will be in that exact state
+		// 
+		if (DSHM_IsDuplicateOutputReport(Context, Source, changedLanes, &now))
+		{
+			break;
+		}
 
 		//
-		// Enqueue current report
-		//
-		DMF_ThreadedBufferQueue_Enqueue(
-			Context->OutputReport.Worker,
-			sendBuffer
+		// Sources double as priorities, driver high priority is the most urgent
+		// 
+		DS_OUTPUT_MAILBOX_POST(
+			&Context->OutputReport.Mailbox,
+			changedLanes != 0 ? changedLanes : DS_OUTPUT_LANE_FLAGS_ALL,
+			(ULONG)Source
 		);
 
+		Context->OutputReport.Deduplicator.LastPostedTimestamp = now;
+
+		isPosted = TRUE;
+
 	} while (FALSE);
 
 	WdfWaitLockRelease(Context->OutputReport.Lock);
 
+	//
+	// Wake the worker, multiple wake-ups before it runs collapse into one
+	// 
+	if (isPosted)
+	{
+		DMF_Thread_WorkReady(Context->OutputReport.Worker);
+	}
+
 	FuncExit(TRACE_DSHIDMINIDRV, "status=%!STATUS!", status);
 
 	return status;
 }
 
+
 //
-// Callback invoked when new output report packet is due to being processed
+// Converts performance counter ticks to microseconds
 // 
-_Use_decl_annotations_
-ThreadedBufferQueue_BufferDisposition
-DSHM_EvtExecuteOutputPacketReceived(
-	_In_ DMFMODULE DmfModule,
-	_In_ UCHAR* ClientWorkBuffer,
-	_In_ ULONG ClientWorkBufferSize,
-	_In_ VOID* ClientWorkBufferContext,
-	_Out_ NTSTATUS* NtStatus
+static
+ULONGLONG
+DSHM_OutputTicksToMicroseconds(
+	_In_ const PLARGE_INTEGER Ticks,
+	_In_ const PLARGE_INTEGER Frequency
 )
 {
-	FuncEntry(TRACE_DSHIDMINIDRV);
+	return (((ULONGLONG)Ticks->QuadPart / (ULONGLONG)Frequency->QuadPart) * 1000000)
+		+ ((((ULONGLONG)Ticks->QuadPart % (ULONGLONG)Frequency->QuadPart) * 1000000) / (ULONGLONG)Frequency->QuadPart);
+}
 
-	ThreadedBufferQueue_BufferDisposition retval = ThreadedBufferQueue_BufferDisposition_WorkComplete;
-	NTSTATUS status = STATUS_UNSUCCESSFUL;
-	const WDFDEVICE device = DMF_ParentDeviceGet(DmfModule);
-	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(device);
-	const PDS_OUTPUT_REPORT_CONTEXT pRepCtx = (PDS_OUTPUT_REPORT_CONTEXT)ClientWorkBufferContext;
-	const size_t bufferSize = pRepCtx->BufferSize;
+//
+// Re-initializes the adaptive rate control if its bounds got re-configured
+//   Must be called with the output report lock held and no send in flight
+// 
+static
+void
+DSHM_SyncOutputRateControl(
+	_In_ const PDEVICE_CONTEXT Context
+)
+{
+	const PDS_OUTPUT_RATE_CONTROL pControl = &Context->OutputReport.RateControl;
+	const ULONG maxPeriod = (ULONG)Context->Configuration.OutputRateControlMaxPeriodMs * 1000;
+	const ULONG minPeriod = min((ULONG)Context->Configuration.OutputRateControlMinPeriodMs * 1000, maxPeriod);
 
-	WDF_MEMORY_DESCRIPTOR memoryDesc;
-	LARGE_INTEGER freq;
-	LONGLONG ms;
-	ULONGLONG timeout;
-	size_t bytesWritten;
+	if (pControl->MinPeriod != minPeriod || pControl->MaxPeriod != maxPeriod)
+	{
+		DS_OUTPUT_RATE_CONTROL_INIT(pControl, minPeriod, maxPeriod);
+	}
+}
 
-	UNREFERENCED_PARAMETER(ClientWorkBufferSize);
-	UNREFERENCED_PARAMETER(NtStatus);	
+//
+// Milliseconds the pending mailbox content has to wait before it may be sent
+// 
+static
+ULONGLONG
+DSHM_GetOutputReportDelay(
+	_In_ const PDEVICE_CONTEXT Context,
+	_In_ const PLARGE_INTEGER Now,
+	_In_ const PLARGE_INTEGER Frequency
+)
+{
+	if (Context->Configuration.IsOutputRateControlAdaptive)
+	{
+		const ULONG us = DS_OUTPUT_RATE_CONTROL_GET_DELAY(
+			&Context->OutputReport.RateControl,
+			DSHM_OutputTicksToMicroseconds(Now, Frequency)
+		);
 
-	QueryPerformanceFrequency(&freq);
+		return (us + 999) / 1000;
+	}
 
 	//
-	// Last successful send timestamp
+	// Fixed period, wireless only
 	// 
-	LARGE_INTEGER* t1 = &pDevCtx->OutputReport.Cache.LastSentTimestamp;
+	if (Context->ConnectionType != DsDeviceConnectionTypeBth)
+	{
+		return 0;
+	}
 
 	//
-	// Current request received timestamp
+	// Calculate delay, the smaller the more frequent packets are sent
 	// 
-	const LARGE_INTEGER* t2 = &pRepCtx->ReceivedTimestamp;
+	const LONGLONG ms = (Now->QuadPart - Context->OutputReport.Cache.LastSentTimestamp.QuadPart)
+		/ (Frequency->QuadPart / 1000);
 
-	WDF_MEMORY_DESCRIPTOR_INIT_BUFFER(
-		&memoryDesc,
-		ClientWorkBuffer,
-		(ULONG)bufferSize
+	TraceVerbose(
+		TRACE_DSHIDMINIDRV,
+		"Time span since last packet was sent: %I64d ms",
+		ms
 	);
 
-	switch (pDevCtx->ConnectionType)
+	if (ms < Context->Configuration.OutputRateControlPeriodMs)
 	{
-#pragma region DsDeviceConnectionTypeUsb
+		return (ULONGLONG)(Context->Configuration.OutputRateControlPeriodMs - ms);
+	}
 
-	case DsDeviceConnectionTypeUsb:
+	return 0;
+}
 
-		status = USB_WriteInterruptOutSync(
-			pDevCtx,
-			&memoryDesc
-		);
+//
+// Finishes the in-flight send and lets the worker pick up whatever got posted meanwhile
+// 
+static
+void
+DSHM_OutputReportSendCompleted(
+	_In_ const PDEVICE_CONTEXT Context,
+	_In_ const NTSTATUS Status
+)
+{
+	LARGE_INTEGER completed;
+	ULONGLONG backoffCount;
 
-		if (NT_SUCCESS(status))
-		{
-			RtlCopyMemory(
-				pDevCtx->OutputReport.Cache.LastReport,
-				ClientWorkBuffer,
-				bufferSize
-			);
-		}
+	QueryPerformanceCounter(&completed);
 
-		break;
+	const ULONGLONG sent = DSHM_OutputTicksToMicroseconds(&Context->OutputReport.InFlight.SendTimestamp, &Context->PerformanceFrequency);
+	const ULONGLONG done = DSHM_OutputTicksToMicroseconds(&completed, &Context->PerformanceFrequency);
+	const ULONG latency = (done > sent) ? (ULONG)min(done - sent, MAXULONG) : 0;
 
-#pragma endregion
+	Context->OutputReport.InFlight.SendCount++;
+	Context->OutputReport.InFlight.LastLatencyUs = latency;
+	Context->OutputReport.InFlight.TotalLatencyUs += latency;
 
-#pragma region DsDeviceConnectionTypeBth
+	if (latency > Context->OutputReport.InFlight.MaxLatencyUs)
+	{
+		Context->OutputReport.InFlight.MaxLatencyUs = latency;
+	}
 
-	case DsDeviceConnectionTypeBth:
+	if (Status == STATUS_IO_TIMEOUT)
+	{
+		Context->OutputReport.InFlight.TimeoutCount++;
+	}
 
-		//
-		// Calculate delay, the smaller the more frequent packets are sent
+	//
+	// Feed the link behaviour back into the adaptive period
+	// 
+	backoffCount = Context->OutputReport.RateControl.BackoffCount;
+
+	DS_OUTPUT_RATE_CONTROL_COMPLETE(
+		&Context->OutputReport.RateControl,
+		sent,
+		done,
+		NT_SUCCESS(Status)
+	);
+
+	if (Context->OutputReport.RateControl.BackoffCount != backoffCount)
+	{
+		TraceVerbose(
+			TRACE_DSHIDMINIDRV,
+			"Output rate control backing off to %u us (status %!STATUS!)",
+			Context->OutputReport.RateControl.Period,
+			Status
+		);
+	}
+
+	if (NT_SUCCESS(Status))
+	{
 		// 
-		ms = (t2->QuadPart - t1->QuadPart) / (freq.QuadPart / 1000);
+		// Store last successful send
+		// 
+		Context->OutputReport.Cache.LastSentTimestamp = completed;
 
+		RtlCopyMemory(
+			Context->OutputReport.Cache.LastReport,
+			Context->OutputReport.InFlight.Buffer,
+			Context->OutputReport.InFlight.Length
+		);
+	}
+	else
+	{
 		TraceVerbose(
 			TRACE_DSHIDMINIDRV,
-			"Time span since last packet was sent: %I64d ms",
-			ms
+			"Output report send failed with status %!STATUS!",
+			Status
 		);
+	}
 
-	//
-	// Rate limit condition has been detected
-	// 
-		if (pRepCtx->ReportSource > Ds3OutputReportSourceDriverHighPriority
-			&& pDevCtx->Configuration.IsOutputRateControlEnabled > 0
-			&& ms < pDevCtx->Configuration.OutputRateControlPeriodMs)
+	WdfWaitLockAcquire(Context->OutputReport.Lock, NULL);
+	{
+		//
+		// The device didn't take the report, so the deduplicator mustn't hold back a retry
+		// 
+		if (!NT_SUCCESS(Status))
 		{
-			timeout = pDevCtx->Configuration.OutputRateControlPeriodMs - ms;
+			DS_OUTPUT_MAILBOX_INVALIDATE(&Context->OutputReport.Mailbox);
+		}
 
-			TraceVerbose(
-				TRACE_DSHIDMINIDRV,
-				"Rate control triggered, delaying buffer 0x%p for %I64u ms",
-				ClientWorkBuffer,
-				timeout
-			);
+		Context->OutputReport.InFlight.IsPending = FALSE;
+	}
+	WdfWaitLockRelease(Context->OutputReport.Lock);
+
+	DMF_Thread_WorkReady(Context->OutputReport.Worker);
+}
+
+//
+// Callback invoked when the mailbox got posted to, a send completed or the rate control delay elapsed
+// 
+_Use_decl_annotations_
+VOID
+DSHM_EvtOutputReportWork(
+	_In_ DMFMODULE DmfModule
+)
+{
+	FuncEntry(TRACE_DSHIDMINIDRV);
+
+	NTSTATUS status = STATUS_SUCCESS;
+	const WDFDEVICE device = DMF_ParentDeviceGet(DmfModule);
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(device);
+	const PDS_OUTPUT_MAILBOX pMailbox = &pDevCtx->OutputReport.Mailbox;
+
+	ULONG lanes;
+	BOOLEAN isTaken = FALSE;
+	LARGE_INTEGER now;
+	ULONGLONG timeout = 0;
+
+	QueryPerformanceCounter(&now);
 
+	WdfWaitLockAcquire(pDevCtx->OutputReport.Lock, NULL);
+	{
+		do
+		{
 			//
-			// Protect, must not run in parallel
+			// One report at a time, the completion wakes us up again
 			// 
-			WdfWaitLockAcquire(pDevCtx->OutputReport.Cache.Lock, NULL);
+			if (pDevCtx->OutputReport.InFlight.IsPending || pMailbox->PendingLanes == 0)
 			{
-				//
-				// We're still in overload condition, drop previous, if any
-				// 
-				if (pDevCtx->OutputReport.Cache.PendingClientBuffer)
-				{
-					TraceVerbose(
-						TRACE_DSHIDMINIDRV,
-						"Rate control still engaged, replacing buffer 0x%p with 0x%p",
-						pDevCtx->OutputReport.Cache.PendingClientBuffer,
-						ClientWorkBuffer
-					);
-
-					DMF_ThreadedBufferQueue_WorkCompleted(
-						pDevCtx->OutputReport.Worker,
-						pDevCtx->OutputReport.Cache.PendingClientBuffer,
-						STATUS_INVALID_DEVICE_REQUEST // Has no impact
-					);
-				}
-
-				//
-				// Overwrite after old one has been cancelled
-				// 
-				pDevCtx->OutputReport.Cache.PendingClientBuffer = ClientWorkBuffer;
-				pDevCtx->OutputReport.Cache.PendingClientBufferContext = ClientWorkBufferContext;
-
-				//
-				// Kick off delay send timer callback
-				// 
-				if (!pDevCtx->OutputReport.Cache.IsScheduled)
-				{
-					pDevCtx->OutputReport.Cache.IsScheduled = WdfTimerStart(
-						pDevCtx->OutputReport.Cache.SendDelayTimer,
-						WDF_REL_TIMEOUT_IN_MS(timeout)
-					);
-				}
+				break;
 			}
-			WdfWaitLockRelease(pDevCtx->OutputReport.Cache.Lock);
 
-			status = STATUS_PENDING; // Has no impact, just for trace
+			//
+			// Nothing in flight, so no completion can be feeding the rate control concurrently
+			// 
+			DSHM_SyncOutputRateControl(pDevCtx);
 
 			//
-			// Keep buffer slot occupied
+			// Rate limit condition has been detected, leave the content in the mailbox
 			// 
-			retval = ThreadedBufferQueue_BufferDisposition_WorkPending;
+			if (pMailbox->PendingPriority > Ds3OutputReportSourceDriverHighPriority
+				&& pDevCtx->Configuration.IsOutputRateControlEnabled > 0
+				&& (timeout = DSHM_GetOutputReportDelay(pDevCtx, &now, &pDevCtx->PerformanceFrequency)) > 0)
+			{
+				break;
+			}
 
-			break;
+			isTaken = DS_OUTPUT_MAILBOX_TAKE(
+				pMailbox,
+				pDevCtx->OutputReport.InFlight.Buffer,
+				sizeof(pDevCtx->OutputReport.InFlight.Buffer),
+				&pDevCtx->OutputReport.InFlight.Length,
+				&lanes
+			);
+
+			pDevCtx->OutputReport.InFlight.IsPending = isTaken;
+
+		} while (FALSE);
+	}
+	WdfWaitLockRelease(pDevCtx->OutputReport.Lock);
+
+	if (timeout > 0)
+	{
+		TraceVerbose(
+			TRACE_DSHIDMINIDRV,
+			"Rate control triggered, delaying mailbox for %I64u ms",
+			timeout
+		);
+
+		//
+		// Protect, must not run in parallel
+		// 
+		WdfWaitLockAcquire(pDevCtx->OutputReport.Cache.Lock, NULL);
+		{
+			//
+			// Posts until then keep replacing the mailbox content
+			// 
+			if (!pDevCtx->OutputReport.Cache.IsScheduled)
+			{
+				pDevCtx->OutputReport.Cache.IsScheduled = WdfTimerStart(
+					pDevCtx->OutputReport.Cache.SendDelayTimer,
+					WDF_REL_TIMEOUT_IN_MS(timeout)
+				);
+			}
 		}
+		WdfWaitLockRelease(pDevCtx->OutputReport.Cache.Lock);
+	}
 
-		status = DMF_DefaultTarget_SendSynchronously(
+	if (!isTaken)
+	{
+		FuncExitNoReturn(TRACE_DSHIDMINIDRV);
+		return;
+	}
+
+	TraceVerbose(
+		TRACE_DSHIDMINIDRV,
+		"Sending merged output report (lanes 0x%X)",
+		lanes
+	);
+
+	QueryPerformanceCounter(&pDevCtx->OutputReport.InFlight.SendTimestamp);
+
+	switch (pDevCtx->ConnectionType)
+	{
+#pragma region DsDeviceConnectionTypeUsb
+
+	case DsDeviceConnectionTypeUsb:
+
+		status = USB_WriteInterruptPipeAsync(
+			WdfUsbTargetPipeGetIoTarget(pDevCtx->Connection.Usb.InterruptOutPipe),
+			pDevCtx->Connection.Usb.InterruptOutPipe,
+			pDevCtx->OutputReport.InFlight.Buffer,
+			pDevCtx->OutputReport.InFlight.Length,
+			DSHM_OUTPUT_REPORT_SEND_TIMEOUT_MS,
+			DSHM_EvtOutputReportUsbWriteCompleted,
+			pDevCtx
+		);
+
+		break;
+
+#pragma endregion
+
+#pragma region DsDeviceConnectionTypeBth
+
+	case DsDeviceConnectionTypeBth:
+
+		status = DMF_DefaultTarget_Send(
 			pDevCtx->Connection.Bth.HidControl.OutputWriterModule,
-			ClientWorkBuffer,
-			bufferSize,
+			pDevCtx->OutputReport.InFlight.Buffer,
+			pDevCtx->OutputReport.InFlight.Length,
 			NULL,
 			0,
 			ContinuousRequestTarget_RequestType_Ioctl,
 			IOCTL_BTHPS3_HID_CONTROL_WRITE,
-			0,
-			&bytesWritten
+			DSHM_OUTPUT_REPORT_SEND_TIMEOUT_MS,
+			DSHM_EvtOutputReportBthWriteCompleted,
+			pDevCtx
 		);
 
-		if (NT_SUCCESS(status))
-		{
-			// 
-			// Store last successful send
-			// 
-
-			QueryPerformanceCounter(t1);
-
-			RtlCopyMemory(
-				pDevCtx->OutputReport.Cache.LastReport,
-				ClientWorkBuffer,
-				bufferSize
-			);
-		}
-
 		break;
 
 #pragma endregion
@@ -321,84 +527,106 @@ DSHM_EvtExecuteOutputPacketReceived(
 		status = STATUS_INVALID_PARAMETER;
 	}
 
-	*NtStatus = status;
+	//
+	// No completion callback will come, finish right here
+	// 
+	if (!NT_SUCCESS(status))
+	{
+		DSHM_OutputReportSendCompleted(pDevCtx, status);
+	}
 
 	FuncExit(TRACE_DSHIDMINIDRV, "status=%!STATUS!", status);
-
-	return retval;
 }
 
 //
-// Callback invoked after cache cooldown delay timer elapsed
+// Completion of an output report sent to the USB interrupt OUT endpoint
 // 
 _Use_decl_annotations_
 void
-DSHM_OutputReportDelayTimerElapsed(
-	WDFTIMER Timer
+DSHM_EvtOutputReportUsbWriteCompleted(
+	WDFREQUEST Request,
+	WDFIOTARGET Target,
+	PWDF_REQUEST_COMPLETION_PARAMS Params,
+	WDFCONTEXT Context
 )
 {
 	FuncEntry(TRACE_DSHIDMINIDRV);
 
-	const WDFDEVICE device = WdfTimerGetParentObject(Timer);
-	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(device);
-	const PUCHAR sourceBuffer = pDevCtx->OutputReport.Cache.PendingClientBuffer;
-	const PDS_OUTPUT_REPORT_CONTEXT pRepCtx = pDevCtx->OutputReport.Cache.PendingClientBufferContext;
-	PUCHAR targetBuffer;
-	PDS_OUTPUT_REPORT_CONTEXT targetBufferContext;	
+	UNREFERENCED_PARAMETER(Target);
 
-	//
-	// Protected region
-	// 
-	WdfWaitLockAcquire(pDevCtx->OutputReport.Cache.Lock, NULL);
-	{
-		TraceVerbose(
-			TRACE_DSHIDMINIDRV,
-			"Processing delayed buffer 0x%p",
-			sourceBuffer
-		);
+	const NTSTATUS status = Params->IoStatus.Status;
 
-		//
-		// Re-queue last cached buffer with high priority
-		// 
+	WdfObjectDelete(Request);
 
-		const NTSTATUS status = DMF_ThreadedBufferQueue_Fetch(
-			pDevCtx->OutputReport.Worker,
-			(PVOID*)&targetBuffer,
-			(PVOID*)&targetBufferContext
-		);
+	DSHM_OutputReportSendCompleted((PDEVICE_CONTEXT)Context, status);
 
-		if (NT_SUCCESS(status))
-		{
-			RtlCopyMemory(targetBuffer, sourceBuffer, pRepCtx->BufferSize);
+	FuncExit(TRACE_DSHIDMINIDRV, "status=%!STATUS!", status);
+}
+
+//
+// Completion of an output report sent to the Bluetooth HID control channel
+// 
+_Use_decl_annotations_
+VOID
+DSHM_EvtOutputReportBthWriteCompleted(
+	DMFMODULE DmfModule,
+	VOID* ClientRequestContext,
+	VOID* InputBuffer,
+	size_t InputBufferBytesRead,
+	VOID* OutputBuffer,
+	size_t OutputBufferBytesWritten,
+	NTSTATUS CompletionStatus
+)
+{
+	FuncEntry(TRACE_DSHIDMINIDRV);
 
-			targetBufferContext->BufferSize = pRepCtx->BufferSize;
-			targetBufferContext->ReceivedTimestamp = pRepCtx->ReceivedTimestamp;
+	UNREFERENCED_PARAMETER(DmfModule);
+	UNREFERENCED_PARAMETER(InputBuffer);
+	UNREFERENCED_PARAMETER(InputBufferBytesRead);
+	UNREFERENCED_PARAMETER(OutputBuffer);
+	UNREFERENCED_PARAMETER(OutputBufferBytesWritten);
 
-			//
-			// Set to high priority, bypasses rate control for this buffer
-			// 
-			targetBufferContext->ReportSource = Ds3OutputReportSourceDriverHighPriority;
+	DSHM_OutputReportSendCompleted((PDEVICE_CONTEXT)ClientRequestContext, CompletionStatus);
 
-			DMF_ThreadedBufferQueue_Enqueue(
-				pDevCtx->OutputReport.Worker,
-				targetBuffer
-			);
-		}
+	FuncExit(TRACE_DSHIDMINIDRV, "status=%!STATUS!", CompletionStatus);
+}
 
-		//
-		// Mark original buffer as completed
-		// 
-		DMF_ThreadedBufferQueue_WorkCompleted(
-			pDevCtx->OutputReport.Worker,
-			pDevCtx->OutputReport.Cache.PendingClientBuffer,
-			status
-		);
+//
+// Callback invoked after cache cooldown delay timer elapsed
+// 
+_Use_decl_annotations_
+void
+DSHM_OutputReportDelayTimerElapsed(
+	WDFTIMER Timer
+)
+{
+	FuncEntry(TRACE_DSHIDMINIDRV);
 
-		pDevCtx->OutputReport.Cache.PendingClientBuffer = NULL;
+	const WDFDEVICE device = WdfTimerGetParentObject(Timer);
+	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(device);
 
+	WdfWaitLockAcquire(pDevCtx->OutputReport.Cache.Lock, NULL);
+	{
 		pDevCtx->OutputReport.Cache.IsScheduled = FALSE;
 	}
 	WdfWaitLockRelease(pDevCtx->OutputReport.Cache.Lock);
 
+	TraceVerbose(
+		TRACE_DSHIDMINIDRV,
+		"Processing delayed mailbox content"
+	);
+
+	//
+	// Whatever is pending by now bypasses rate control, it has waited long enough
+	// 
+	WdfWaitLockAcquire(pDevCtx->OutputReport.Lock, NULL);
+	DS_OUTPUT_MAILBOX_ESCALATE(
+		&pDevCtx->OutputReport.Mailbox,
+		Ds3OutputReportSourceDriverHighPriority
+	);
+	WdfWaitLockRelease(pDevCtx->OutputReport.Lock);
+
+	DMF_Thread_WorkReady(pDevCtx->OutputReport.Worker);
+
 	FuncExitNoReturn(TRACE_DSHIDMINIDRV);
 }
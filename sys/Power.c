@@ -117,9 +117,26 @@ NTSTATUS DsHidMini_EvtDeviceD0Entry(
 	}
 	
 	//
-	// Start processing received output report packets
+	// Start processing output report mailbox posts
 	//
-	DMF_ThreadedBufferQueue_Start(pDevCtx->OutputReport.Worker);
+	DMF_Thread_Start(pDevCtx->OutputReport.Worker);
+
+	//
+	// Anything posted while powered down is still due
+	//
+	DMF_Thread_WorkReady(pDevCtx->OutputReport.Worker);
+
+	DsDevice_SetLastConnectedTime(pDevCtx);
+
+	//
+	// Time spent disconnected or in low power isn't an input interval
+	//
+	DS_INPUT_INTERVAL_RESTART(&pDevCtx->InputInterval.Stats);
+
+	WdfTimerStart(
+		pDevCtx->InputInterval.EventTimer,
+		WDF_REL_TIMEOUT_IN_MS(DSHM_INPUT_INTERVAL_EVENT_PERIOD_MS)
+	);
 	
 	FuncExit(TRACE_POWER, "status=%!STATUS!", status);
 
@@ -143,9 +160,40 @@ NTSTATUS DsHidMini_EvtDeviceD0Exit(
 	const PDEVICE_CONTEXT pDevCtx = DeviceGetContext(Device);
 
 	//
-	// Stop processing received output report packets
+	// A delayed send must not wake the worker once it's gone
+	//
+	WdfTimerStop(pDevCtx->OutputReport.Cache.SendDelayTimer, TRUE);
+	pDevCtx->OutputReport.Cache.IsScheduled = FALSE;
+
+	//
+	// Stop processing output report mailbox posts
+	//
+	DMF_Thread_Stop(pDevCtx->OutputReport.Worker);
+
+	//
+	// Device state is unknown after power-up, first output report must go through
+	//
+	WdfWaitLockAcquire(pDevCtx->OutputReport.Lock, NULL);
+	DS_OUTPUT_MAILBOX_INVALIDATE(&pDevCtx->OutputReport.Mailbox);
+	WdfWaitLockRelease(pDevCtx->OutputReport.Lock);
+
+	//
+	// No pending combo hold must fire while powered down
+	//
+	WdfTimerStop(pDevCtx->ButtonCombos.HoldTimer, FALSE);
+
+	//
+	// Held back input reports are outdated once powered up again
 	//
-	DMF_ThreadedBufferQueue_Stop(pDevCtx->OutputReport.Worker);
+	WdfTimerStop(pDevCtx->InputRateLimit.ReleaseTimer, TRUE);
+	pDevCtx->InputRateLimit.IsReleaseScheduled = FALSE;
+	pDevCtx->InputRateLimit.IsPending[0] = FALSE;
+	pDevCtx->InputRateLimit.IsPending[1] = FALSE;
+
+	//
+	// Nothing arrives while powered down, no point in waking up for it
+	//
+	WdfTimerStop(pDevCtx->InputInterval.EventTimer, TRUE);
 
 	if (pDevCtx->ConfigurationDirectoryWatcherWaitHandle)
 	{
@@ -176,6 +224,19 @@ NTSTATUS DsHidMini_EvtDeviceD0Exit(
 		);
 	}
 
+	//
+	// Don't lose pending property updates
+	// 
+	WdfTimerStop(pDevCtx->PropertyWriter.FlushTimer, TRUE);
+	DsDevice_FlushProperties(pDevCtx);
+
+	TraceInformation(
+		TRACE_POWER,
+		"Property writes issued: %lld, suppressed: %lld",
+		pDevCtx->PropertyWriter.WritesIssued,
+		pDevCtx->PropertyWriter.WritesSuppressed
+	);
+
 	FuncExit(TRACE_POWER, "status=%!STATUS!", status);
 
 	return status;
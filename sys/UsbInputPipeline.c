@@ -0,0 +1,39 @@
+#include "DsPortable.h"
+#include <DsHidMini/Ds3Types.h>
+#include "UsbInputPipeline.h"
+
+
+//
+// Classifies a completed interrupt IN transfer, counts the unexpected ones
+//
+DS_USB_INPUT_TRANSFER
+DS_USB_INPUT_PIPELINE_VALIDATE(
+	PDS_USB_INPUT_PIPELINE_STATS Stats,
+	const UCHAR* Buffer,
+	size_t NumBytesTransferred
+)
+{
+	if (NumBytesTransferred < sizeof(DS3_RAW_INPUT_REPORT))
+	{
+		Stats->ShortTransferCount++;
+
+		return DsUsbInputTransferShort;
+	}
+
+	//
+	// Only the first report is used, any further ones get dropped. The report is
+	// shorter than the max. packet size so the transfer normally ends after it,
+	// this only catches misbehaving devices or hubs
+	// 
+	if (NumBytesTransferred >= (sizeof(DS3_RAW_INPUT_REPORT) * 2))
+	{
+		Stats->OversizedTransferCount++;
+	}
+
+	if (((const DS3_RAW_INPUT_REPORT*)Buffer)->Reserved0 == 0xFF)
+	{
+		return DsUsbInputTransferBroken;
+	}
+
+	return DsUsbInputTransferReport;
+}
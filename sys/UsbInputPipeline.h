@@ -0,0 +1,48 @@
+#pragma once
+
+//
+// USB interrupt IN transfer validation
+//   Decides whether a continuous reader completion carries a usable input report
+//   and counts the transfers that don't fit the expected layout. Pure code without
+//   WDF dependencies, the buffer and transferred length are supplied by the caller.
+//
+
+typedef enum _DS_USB_INPUT_TRANSFER
+{
+	//
+	// Starts with a complete report which should be processed
+	//
+	DsUsbInputTransferReport,
+
+	//
+	// Too short to hold a complete report
+	//
+	DsUsbInputTransferShort,
+
+	//
+	// Broken report some controllers occasionally send
+	//
+	DsUsbInputTransferBroken
+
+} DS_USB_INPUT_TRANSFER;
+
+typedef struct _DS_USB_INPUT_PIPELINE_STATS
+{
+	//
+	// Transfers too short to hold a complete report
+	//
+	ULONGLONG ShortTransferCount;
+
+	//
+	// Transfers carrying more than a single report, only the first one gets used
+	//
+	ULONGLONG OversizedTransferCount;
+
+} DS_USB_INPUT_PIPELINE_STATS, * PDS_USB_INPUT_PIPELINE_STATS;
+
+DS_USB_INPUT_TRANSFER
+DS_USB_INPUT_PIPELINE_VALIDATE(
+	_Inout_ PDS_USB_INPUT_PIPELINE_STATS Stats,
+	_In_reads_bytes_(NumBytesTransferred) const UCHAR* Buffer,
+	_In_ size_t NumBytesTransferred
+);
@@ -0,0 +1,286 @@
+//
+// Bluetooth input pipeline depth benchmark against a simulated BthPS3 target
+//
+//   The target thread emits a report every DS_SIM_REPORT_PERIOD_US and completes the oldest
+//   pending IOCTL_BTHPS3_HID_INTERRUPT_READ with it (first in, first out), a report arriving
+//   while no read is pending is lost. Completions are dispatched to one worker per pending
+//   read, mirroring DsBth_HidInterruptReadContinuousRequestCompleted: serialize on the read
+//   lock if more than one read is pending, process, re-post the read. A small share of the
+//   callbacks gets delayed before reaching the lock to emulate scheduling hiccups.
+//
+
+#define _GNU_SOURCE
+
+#include "DsPortable.h"
+#include "DsTest.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#define DS_SIM_REPORT_PERIOD_US		1000
+#define DS_SIM_REPORT_COUNT			1000
+#define DS_SIM_PROCESSING_US		20
+#define DS_SIM_STALL_US				2500
+#define DS_SIM_STALL_PERMILLE		20
+#define DS_SIM_MAX_DEPTH			8
+
+typedef struct _DS_SIM_COMPLETION
+{
+	ULONGLONG Sequence;
+	ULONGLONG EmittedNs;
+} DS_SIM_COMPLETION;
+
+typedef struct _DS_SIM_PIPELINE
+{
+	ULONG Depth;
+
+	//
+	// Target side: pending reads and completions not yet picked up by a worker
+	//
+	pthread_mutex_t TargetLock;
+	pthread_cond_t CompletionReady;
+	ULONG PendingReads;
+	DS_SIM_COMPLETION Completions[DS_SIM_MAX_DEPTH];
+	ULONG CompletionHead;
+	ULONG CompletionCount;
+	BOOLEAN IsStopped;
+
+	//
+	// Driver side
+	//
+	pthread_mutex_t ReadLock;
+	ULONGLONG AppliedSequence;
+
+	ULONGLONG Emitted;
+	ULONGLONG Lost;
+	ULONGLONG Delivered;
+	ULONGLONG OutOfOrder;
+	ULONG Latencies[DS_SIM_REPORT_COUNT];
+} DS_SIM_PIPELINE, * PDS_SIM_PIPELINE;
+
+static void SpinFor(ULONGLONG Ns)
+{
+	const ULONGLONG end = DsTestNowNs() + Ns;
+
+	while (DsTestNowNs() < end)
+	{
+	}
+}
+
+static void SleepFor(ULONGLONG Ns)
+{
+	struct timespec ts = { (time_t)(Ns / 1000000000ULL), (long)(Ns % 1000000000ULL) };
+
+	nanosleep(&ts, NULL);
+}
+
+static void* TargetThread(void* Parameter)
+{
+	const PDS_SIM_PIPELINE sim = (PDS_SIM_PIPELINE)Parameter;
+	ULONGLONG due = DsTestNowNs();
+
+	for (ULONGLONG sequence = 1; sequence <= DS_SIM_REPORT_COUNT; sequence++)
+	{
+		due += DS_SIM_REPORT_PERIOD_US * 1000ULL;
+
+		const ULONGLONG now = DsTestNowNs();
+
+		if (due > now)
+		{
+			SleepFor(due - now);
+		}
+
+		pthread_mutex_lock(&sim->TargetLock);
+		{
+			sim->Emitted++;
+
+			if (sim->PendingReads == 0)
+			{
+				sim->Lost++;
+			}
+			else
+			{
+				DS_SIM_COMPLETION* pCompletion = &sim->Completions[(sim->CompletionHead + sim->CompletionCount) % DS_SIM_MAX_DEPTH];
+
+				pCompletion->Sequence = sequence;
+				pCompletion->EmittedNs = DsTestNowNs();
+
+				sim->PendingReads--;
+				sim->CompletionCount++;
+
+				pthread_cond_signal(&sim->CompletionReady);
+			}
+		}
+		pthread_mutex_unlock(&sim->TargetLock);
+	}
+
+	//
+	// Let the last completions drain
+	//
+	SleepFor(DS_SIM_STALL_US * 4000ULL);
+
+	pthread_mutex_lock(&sim->TargetLock);
+	sim->IsStopped = TRUE;
+	pthread_cond_broadcast(&sim->CompletionReady);
+	pthread_mutex_unlock(&sim->TargetLock);
+
+	return NULL;
+}
+
+static void* CompletionThread(void* Parameter)
+{
+	const PDS_SIM_PIPELINE sim = (PDS_SIM_PIPELINE)Parameter;
+	const BOOLEAN isOrdered = (sim->Depth > 1);
+	unsigned int seed = (unsigned int)(uintptr_t)&seed;
+
+	for (;;)
+	{
+		DS_SIM_COMPLETION completion;
+
+		pthread_mutex_lock(&sim->TargetLock);
+		{
+			while (sim->CompletionCount == 0 && !sim->IsStopped)
+			{
+				pthread_cond_wait(&sim->CompletionReady, &sim->TargetLock);
+			}
+
+			if (sim->CompletionCount == 0)
+			{
+				pthread_mutex_unlock(&sim->TargetLock);
+				break;
+			}
+
+			completion = sim->Completions[sim->CompletionHead];
+			sim->CompletionHead = (sim->CompletionHead + 1) % DS_SIM_MAX_DEPTH;
+			sim->CompletionCount--;
+		}
+		pthread_mutex_unlock(&sim->TargetLock);
+
+		if ((ULONG)(rand_r(&seed) % 1000) < DS_SIM_STALL_PERMILLE)
+		{
+			SleepFor(DS_SIM_STALL_US * 1000ULL);
+		}
+
+		if (isOrdered)
+		{
+			pthread_mutex_lock(&sim->ReadLock);
+		}
+
+		SpinFor(DS_SIM_PROCESSING_US * 1000ULL);
+
+		if (completion.Sequence < sim->AppliedSequence)
+		{
+			sim->OutOfOrder++;
+		}
+
+		sim->AppliedSequence = completion.Sequence;
+		sim->Latencies[sim->Delivered++] = (ULONG)((DsTestNowNs() - completion.EmittedNs) / 1000);
+
+		if (isOrdered)
+		{
+			pthread_mutex_unlock(&sim->ReadLock);
+		}
+
+		//
+		// ContinuousRequestTargetAndContinueStreaming re-posts the read
+		//
+		pthread_mutex_lock(&sim->TargetLock);
+		sim->PendingReads++;
+		pthread_mutex_unlock(&sim->TargetLock);
+	}
+
+	return NULL;
+}
+
+static int CompareUlong(const void* Left, const void* Right)
+{
+	const ULONG left = *(const ULONG*)Left;
+	const ULONG right = *(const ULONG*)Right;
+
+	return (left > right) - (left < right);
+}
+
+static ULONGLONG RunPipeline(ULONG Depth)
+{
+	static DS_SIM_PIPELINE sim;
+	pthread_t target;
+	pthread_t workers[DS_SIM_MAX_DEPTH];
+
+	memset(&sim, 0, sizeof(sim));
+	sim.Depth = Depth;
+	sim.PendingReads = Depth;
+	pthread_mutex_init(&sim.TargetLock, NULL);
+	pthread_mutex_init(&sim.ReadLock, NULL);
+	pthread_cond_init(&sim.CompletionReady, NULL);
+
+	const ULONGLONG start = DsTestNowNs();
+
+	for (ULONG i = 0; i < Depth; i++)
+	{
+		pthread_create(&workers[i], NULL, CompletionThread, &sim);
+	}
+
+	pthread_create(&target, NULL, TargetThread, &sim);
+	pthread_join(target, NULL);
+
+	for (ULONG i = 0; i < Depth; i++)
+	{
+		pthread_join(workers[i], NULL);
+	}
+
+	const ULONGLONG elapsedUs = (DsTestNowNs() - start) / 1000;
+	ULONGLONG sum = 0;
+
+	for (ULONGLONG i = 0; i < sim.Delivered; i++)
+	{
+		sum += sim.Latencies[i];
+	}
+
+	qsort(sim.Latencies, (size_t)sim.Delivered, sizeof(ULONG), CompareUlong);
+
+	printf("depth %u: delivered %llu/%llu (%.0f reports/s), lost %llu, out of order %llu, latency mean %llu us, p99 %u us, max %u us\n",
+		Depth,
+		(unsigned long long)sim.Delivered,
+		(unsigned long long)sim.Emitted,
+		(double)sim.Delivered * 1000000.0 / (double)elapsedUs,
+		(unsigned long long)sim.Lost,
+		(unsigned long long)sim.OutOfOrder,
+		(unsigned long long)(sim.Delivered ? sum / sim.Delivered : 0),
+		sim.Delivered ? sim.Latencies[(sim.Delivered * 99) / 100] : 0,
+		sim.Delivered ? sim.Latencies[sim.Delivered - 1] : 0
+	);
+
+	DS_TEST_ASSERT_EQ(sim.Emitted, DS_SIM_REPORT_COUNT);
+	DS_TEST_ASSERT_EQ(sim.Delivered + sim.Lost, sim.Emitted);
+
+	pthread_cond_destroy(&sim.CompletionReady);
+	pthread_mutex_destroy(&sim.ReadLock);
+	pthread_mutex_destroy(&sim.TargetLock);
+
+	return sim.Lost;
+}
+
+static void BenchmarkDepth(void)
+{
+	const ULONG depths[] = { 1, 2, 4, 8 };
+	ULONGLONG lost[4];
+
+	for (ULONG i = 0; i < 4; i++)
+	{
+		lost[i] = RunPipeline(depths[i]);
+	}
+
+	//
+	// A single pending read loses every report arriving while its callback is stalled,
+	// more reads in flight must bridge those stalls
+	//
+	DS_TEST_ASSERT(lost[2] <= lost[0]);
+	DS_TEST_ASSERT(lost[3] <= lost[0]);
+}
+
+int main(void)
+{
+	DS_TEST_RUN(BenchmarkDepth);
+
+	return DS_TEST_RESULT();
+}
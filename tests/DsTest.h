@@ -0,0 +1,39 @@
+#pragma once
+
+//
+// Tiny assertion and timing helpers shared by the portable test executables
+//
+
+#include <stdio.h>
+#include <time.h>
+
+static int DsTestFailures = 0;
+
+#define DS_TEST_ASSERT(_expr_)	\
+	do { if (!(_expr_)) { fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #_expr_); DsTestFailures++; } } while (0)
+
+#define DS_TEST_ASSERT_EQ(_actual_, _expected_)	\
+	do { unsigned long long a_ = (unsigned long long)(_actual_), e_ = (unsigned long long)(_expected_);	\
+		if (a_ != e_) { fprintf(stderr, "%s:%d: %s == %llu, expected %llu\n", __FILE__, __LINE__, #_actual_, a_, e_); DsTestFailures++; } } while (0)
+
+#define DS_TEST_RUN(_test_)	\
+	do { const int before_ = DsTestFailures; _test_(); printf("%s %s\n", (DsTestFailures == before_) ? "PASS" : "FAIL", #_test_); } while (0)
+
+#define DS_TEST_RESULT()	((DsTestFailures == 0) ? 0 : 1)
+
+//
+// Monotonic clock in nanoseconds
+//
+static inline unsigned long long DsTestNowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((unsigned long long)ts.tv_sec * 1000000000ULL) + (unsigned long long)ts.tv_nsec;
+}
+
+//
+// Keeps the optimizer from discarding benchmarked work
+//
+#define DS_TEST_KEEP(_value_)	__asm__ volatile("" : : "g"(_value_) : "memory")
@@ -0,0 +1,262 @@
+#include "DsPortable.h"
+#include "InputInterval.h"
+#include "DsTest.h"
+
+//
+// Feeds Count arrivals spaced Interval microseconds apart, returns the last timestamp
+//
+static ULONGLONG Feed(PDS_INPUT_INTERVAL_STATS Stats, ULONGLONG Start, ULONG Interval, ULONG Count)
+{
+	ULONGLONG timestamp = Start;
+
+	for (ULONG i = 0; i < Count; i++)
+	{
+		timestamp += Interval;
+		DS_INPUT_INTERVAL_UPDATE(Stats, timestamp);
+	}
+
+	return timestamp;
+}
+
+static void InitResetsEverything(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+	ULONG mean;
+	ULONGLONG variance;
+
+	memset(&stats, 0xCD, sizeof(stats));
+	DS_INPUT_INTERVAL_INIT(&stats);
+
+	DS_TEST_ASSERT_EQ(stats.Count, 0);
+	DS_TEST_ASSERT_EQ(stats.LastTimestamp, 0);
+	DS_TEST_ASSERT_EQ(stats.MinInterval, MAXULONG);
+	DS_TEST_ASSERT_EQ(stats.GapCount, 0);
+
+	DS_INPUT_INTERVAL_SUMMARY(&stats, &mean, &variance);
+
+	DS_TEST_ASSERT_EQ(mean, 0);
+	DS_TEST_ASSERT_EQ(variance, 0);
+}
+
+static void FirstArrivalIsNoInterval(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+	DS_INPUT_INTERVAL_UPDATE(&stats, 1000);
+
+	DS_TEST_ASSERT_EQ(stats.Count, 0);
+	DS_TEST_ASSERT_EQ(stats.LastTimestamp, 1000);
+}
+
+static void RegularIntervals(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+	ULONG mean;
+	ULONGLONG variance;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+	Feed(&stats, 1, 4000, 101);
+
+	DS_INPUT_INTERVAL_SUMMARY(&stats, &mean, &variance);
+
+	DS_TEST_ASSERT_EQ(stats.Count, 100);
+	DS_TEST_ASSERT_EQ(stats.MinInterval, 4000);
+	DS_TEST_ASSERT_EQ(stats.MaxInterval, 4000);
+	DS_TEST_ASSERT_EQ(mean, 4000);
+	DS_TEST_ASSERT_EQ(variance, 0);
+	DS_TEST_ASSERT_EQ(stats.Buckets[4], 100);
+	DS_TEST_ASSERT_EQ(stats.GapCount, 0);
+	DS_TEST_ASSERT_EQ(stats.ExpectedInterval >> 4, 4000);
+}
+
+static void MeanAndVariance(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+	ULONGLONG timestamp = 1;
+	ULONG mean;
+	ULONGLONG variance;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+	DS_INPUT_INTERVAL_UPDATE(&stats, timestamp);
+
+	for (int i = 0; i < 50; i++)
+	{
+		timestamp = Feed(&stats, timestamp, 3000, 1);
+		timestamp = Feed(&stats, timestamp, 5000, 1);
+	}
+
+	DS_INPUT_INTERVAL_SUMMARY(&stats, &mean, &variance);
+
+	DS_TEST_ASSERT_EQ(mean, 4000);
+	DS_TEST_ASSERT_EQ(variance, 1000000);
+	DS_TEST_ASSERT_EQ(stats.Buckets[3], 50);
+	DS_TEST_ASSERT_EQ(stats.Buckets[5], 50);
+}
+
+static void LongIntervalsLandInLastBucket(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+	Feed(&stats, 1, 250000, 2);
+
+	DS_TEST_ASSERT_EQ(stats.Buckets[DS_INPUT_INTERVAL_BUCKET_COUNT - 1], 1);
+}
+
+static void GapDetection(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+
+	ULONGLONG timestamp = Feed(&stats, 1, 4000, DS_INPUT_INTERVAL_WARMUP_COUNT + 5);
+
+	//
+	// Two reports lost
+	//
+	timestamp = Feed(&stats, timestamp, 12000, 1);
+
+	DS_TEST_ASSERT_EQ(stats.GapCount, 1);
+	DS_TEST_ASSERT_EQ(stats.MissedReports, 2);
+
+	//
+	// Regular jitter below the gap factor doesn't count
+	//
+	timestamp = Feed(&stats, timestamp, 7900, 1);
+	Feed(&stats, timestamp, 4000, 1);
+
+	DS_TEST_ASSERT_EQ(stats.GapCount, 1);
+	DS_TEST_ASSERT_EQ(stats.ConsecutiveGaps, 0);
+
+	//
+	// Gaps don't feed into the expected interval
+	//
+	DS_TEST_ASSERT((stats.ExpectedInterval >> 4) < 4500);
+}
+
+static void NoGapsDuringWarmup(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+
+	ULONGLONG timestamp = Feed(&stats, 1, 4000, DS_INPUT_INTERVAL_WARMUP_COUNT / 2);
+	Feed(&stats, timestamp, 40000, 1);
+
+	DS_TEST_ASSERT_EQ(stats.GapCount, 0);
+}
+
+static void RebaselineAfterLastingRateChange(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+
+	ULONGLONG timestamp = Feed(&stats, 1, 1000, DS_INPUT_INTERVAL_WARMUP_COUNT + 5);
+
+	//
+	// Device drops to a quarter of the rate for good
+	//
+	timestamp = Feed(&stats, timestamp, 4000, DS_INPUT_INTERVAL_REBASELINE_COUNT);
+
+	DS_TEST_ASSERT_EQ(stats.GapCount, DS_INPUT_INTERVAL_REBASELINE_COUNT);
+	DS_TEST_ASSERT_EQ(stats.ExpectedInterval >> 4, 4000);
+
+	Feed(&stats, timestamp, 4000, 100);
+
+	DS_TEST_ASSERT_EQ(stats.GapCount, DS_INPUT_INTERVAL_REBASELINE_COUNT);
+}
+
+static void RestartForgetsPreviousArrival(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+
+	ULONGLONG timestamp = Feed(&stats, 1, 4000, DS_INPUT_INTERVAL_WARMUP_COUNT + 5);
+	timestamp = Feed(&stats, timestamp, 20000, 2);
+
+	DS_TEST_ASSERT_EQ(stats.ConsecutiveGaps, 2);
+
+	const ULONGLONG count = stats.Count;
+
+	DS_INPUT_INTERVAL_RESTART(&stats);
+
+	DS_TEST_ASSERT_EQ(stats.ConsecutiveGaps, 0);
+
+	//
+	// Time spent suspended isn't an interval
+	//
+	Feed(&stats, timestamp, 10 * 1000 * 1000, 1);
+
+	DS_TEST_ASSERT_EQ(stats.Count, count);
+	DS_TEST_ASSERT_EQ(stats.GapCount, 2);
+}
+
+static void BackwardsTimestampIsIgnored(void)
+{
+	DS_INPUT_INTERVAL_STATS stats;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+	DS_INPUT_INTERVAL_UPDATE(&stats, 10000);
+	DS_INPUT_INTERVAL_UPDATE(&stats, 5000);
+
+	DS_TEST_ASSERT_EQ(stats.Count, 0);
+	DS_TEST_ASSERT_EQ(stats.LastTimestamp, 5000);
+}
+
+//
+// Cost of a single update on the report arrival path, with jitter and the occasional gap
+//
+static void BenchmarkUpdate(void)
+{
+	const ULONG iterations = 20 * 1000 * 1000;
+	DS_INPUT_INTERVAL_STATS stats;
+	ULONGLONG timestamp = 1;
+	ULONG seed = 12345;
+
+	DS_INPUT_INTERVAL_INIT(&stats);
+
+	const unsigned long long start = DsTestNowNs();
+
+	for (ULONG i = 0; i < iterations; i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		timestamp += 3750 + ((seed >> 16) % 500) + (((seed >> 8) & 0xFF) == 0 ? 8000 : 0);
+		DS_INPUT_INTERVAL_UPDATE(&stats, timestamp);
+	}
+
+	const unsigned long long elapsed = DsTestNowNs() - start;
+	const double perUpdate = (double)elapsed / iterations;
+
+	DS_TEST_KEEP(stats.Sum);
+
+	printf("DS_INPUT_INTERVAL_UPDATE: %.2f ns/update (%u updates, %llu gaps)\n",
+		perUpdate, iterations, (unsigned long long)stats.GapCount);
+
+	DS_TEST_ASSERT_EQ(stats.Count, iterations - 1);
+	DS_TEST_ASSERT(stats.GapCount > 0);
+
+	//
+	// Expected to be in the tens of nanoseconds, the bound only catches gross regressions
+	//
+	DS_TEST_ASSERT(perUpdate < 500.0);
+}
+
+int main(void)
+{
+	DS_TEST_RUN(InitResetsEverything);
+	DS_TEST_RUN(FirstArrivalIsNoInterval);
+	DS_TEST_RUN(RegularIntervals);
+	DS_TEST_RUN(MeanAndVariance);
+	DS_TEST_RUN(LongIntervalsLandInLastBucket);
+	DS_TEST_RUN(GapDetection);
+	DS_TEST_RUN(NoGapsDuringWarmup);
+	DS_TEST_RUN(RebaselineAfterLastingRateChange);
+	DS_TEST_RUN(RestartForgetsPreviousArrival);
+	DS_TEST_RUN(BackwardsTimestampIsIgnored);
+	DS_TEST_RUN(BenchmarkUpdate);
+
+	return DS_TEST_RESULT();
+}
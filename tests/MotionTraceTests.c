@@ -0,0 +1,300 @@
+#include "DsPortable.h"
+#include <DsHidMini/Ds3Types.h>
+#include "Ds3.Motion.h"
+#include "DsTest.h"
+
+#include <stdlib.h>
+
+//
+// Replays sensor traces through the motion pipeline the way DSHM_ProcessHidInputReport does
+//
+//   Trace format: one sample per line, "idle,accelX,accelY,accelZ,gyro" with the raw 10-bit
+//   sensor values as reported by the device and idle being 1 if no input was engaged. Lines
+//   starting with # are comments. Additional traces (e.g. recorded from a device) can be
+//   passed on the command line, they get replayed and summarized without any expectations.
+//
+
+#define DS_TRACE_MAX_SAMPLES	4096
+
+typedef struct _DS_TRACE_SAMPLE
+{
+	BOOLEAN IsIdle;
+	USHORT AccelerometerX;
+	USHORT AccelerometerY;
+	USHORT AccelerometerZ;
+	USHORT Gyroscope;
+} DS_TRACE_SAMPLE;
+
+typedef struct _DS_TRACE_RESULT
+{
+	ULONG SampleCount;
+
+	//
+	// Final pipeline state
+	//
+	DS3_MOTION_STATE State;
+
+	//
+	// Sample index the first bias estimate got in, -1 if never
+	//
+	LONG CalibratedAt;
+
+	//
+	// Mean calibrated gyroscope output over the last quarter of the trace
+	//
+	LONG TailGyroscopeMean;
+} DS_TRACE_RESULT;
+
+static DS_TRACE_SAMPLE Samples[DS_TRACE_MAX_SAMPLES];
+
+static ULONG LoadTrace(const char* Path)
+{
+	FILE* file = fopen(Path, "r");
+	char line[256];
+	ULONG count = 0;
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "can't open trace %s\n", Path);
+		DsTestFailures++;
+		return 0;
+	}
+
+	while (fgets(line, sizeof(line), file) && count < DS_TRACE_MAX_SAMPLES)
+	{
+		unsigned int idle, ax, ay, az, gyro;
+
+		if (line[0] == '#' || sscanf(line, "%u,%u,%u,%u,%u", &idle, &ax, &ay, &az, &gyro) != 5)
+		{
+			continue;
+		}
+
+		Samples[count].IsIdle = (BOOLEAN)(idle != 0);
+		Samples[count].AccelerometerX = (USHORT)ax;
+		Samples[count].AccelerometerY = (USHORT)ay;
+		Samples[count].AccelerometerZ = (USHORT)az;
+		Samples[count].Gyroscope = (USHORT)gyro;
+		count++;
+	}
+
+	fclose(file);
+
+	return count;
+}
+
+static void ReplayTrace(const char* Path, const PDS_MOTION_SETTINGS Settings, DS_TRACE_RESULT* Result)
+{
+	DS3_RAW_INPUT_REPORT report;
+	LONGLONG tailSum = 0;
+	ULONG tailCount = 0;
+
+	memset(Result, 0, sizeof(*Result));
+	Result->CalibratedAt = -1;
+	Result->SampleCount = LoadTrace(Path);
+
+	DS3_MOTION_INIT(&Result->State);
+
+	for (ULONG i = 0; i < Result->SampleCount; i++)
+	{
+		memset(&report, 0, sizeof(report));
+		report.ReportId = 0x01;
+		report.LeftThumbX = report.LeftThumbY = 0x80;
+		report.RightThumbX = report.RightThumbY = 0x80;
+
+		//
+		// Handled controller, some button is held
+		//
+		if (!Samples[i].IsIdle)
+		{
+			report.Buttons.Individual.Cross = 1;
+		}
+
+		report.AccelerometerX = _byteswap_ushort(Samples[i].AccelerometerX);
+		report.AccelerometerY = _byteswap_ushort(Samples[i].AccelerometerY);
+		report.AccelerometerZ = _byteswap_ushort(Samples[i].AccelerometerZ);
+		report.Gyroscope = _byteswap_ushort(Samples[i].Gyroscope);
+
+		DS3_MOTION_UPDATE(&Result->State, Settings, &report, DS3_RAW_IS_IDLE(&report));
+
+		if (Result->CalibratedAt < 0 && (Result->State.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED))
+		{
+			Result->CalibratedAt = (LONG)i;
+		}
+
+		if (i >= Result->SampleCount - (Result->SampleCount / 4))
+		{
+			tailSum += Result->State.Sample.Gyroscope;
+			tailCount++;
+		}
+	}
+
+	Result->TailGyroscopeMean = tailCount ? (LONG)(tailSum / (LONGLONG)tailCount) : 0;
+
+	printf("%s: %u samples, calibrated at %d, bias %d.%02d counts, gyro tail mean %d (1/16 dps), pitch %d, roll %d (1/100 deg)\n",
+		Path,
+		Result->SampleCount,
+		Result->CalibratedAt,
+		Result->State.GyroscopeBias >> 8,
+		((Result->State.GyroscopeBias & 0xFF) * 100) >> 8,
+		Result->TailGyroscopeMean,
+		Result->State.Sample.Pitch,
+		Result->State.Sample.Roll
+	);
+}
+
+static DS_MOTION_SETTINGS DefaultSettings(void)
+{
+	DS_MOTION_SETTINGS settings;
+
+	//
+	// Same as the configuration defaults, with tilt estimation enabled
+	//
+	settings.IsCalibrationEnabled = TRUE;
+	settings.CalibrationWindow = 256;
+	settings.IsTiltEstimationEnabled = TRUE;
+	settings.TiltFilterWeight = 230;
+
+	return settings;
+}
+
+static LONG Abs(LONG Value)
+{
+	return (Value < 0) ? -Value : Value;
+}
+
+static void RestingFlatCalibrates(void)
+{
+	DS_MOTION_SETTINGS settings = DefaultSettings();
+	DS_TRACE_RESULT result;
+
+	ReplayTrace(DSHM_TRACES_DIR "/resting_flat.csv", &settings, &result);
+
+	DS_TEST_ASSERT(result.State.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED);
+	DS_TEST_ASSERT_EQ(result.CalibratedAt, settings.CalibrationWindow - 1);
+	DS_TEST_ASSERT(Abs(result.State.GyroscopeBias - (502 << 8)) <= 64);
+
+	//
+	// Noise of +-2 counts averages out to (almost) zero rate
+	//
+	DS_TEST_ASSERT(Abs(result.TailGyroscopeMean) <= 8);
+
+	DS_TEST_ASSERT(Abs(result.State.Sample.Pitch) <= 100);
+	DS_TEST_ASSERT(Abs(result.State.Sample.Roll) <= 100);
+
+	//
+	// 1 g on Z
+	//
+	DS_TEST_ASSERT(Abs(result.State.Sample.AccelerometerZ - DS3_MOTION_ACCELEROMETER_UNITS_PER_G) <= 150);
+}
+
+static void HandlingKeepsBias(void)
+{
+	DS_MOTION_SETTINGS settings = DefaultSettings();
+	DS_TRACE_RESULT result;
+
+	ReplayTrace(DSHM_TRACES_DIR "/rest_then_yaw.csv", &settings, &result);
+
+	DS_TEST_ASSERT(result.State.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED);
+
+	//
+	// Learned while resting, untouched while turning
+	//
+	DS_TEST_ASSERT(Abs(result.State.GyroscopeBias - (490 << 8)) <= 64);
+
+	//
+	// 58 counts * ~0.73 deg/s per count ~= 42 deg/s ~= 680 output units
+	//
+	const LONG expected = (58 * DS3_MOTION_GYROSCOPE_SCALE_Q8) >> 8;
+
+	DS_TEST_ASSERT(Abs(result.TailGyroscopeMean - expected) <= 16);
+}
+
+static void TiltEstimate(void)
+{
+	DS_MOTION_SETTINGS settings = DefaultSettings();
+	DS_TRACE_RESULT result;
+
+	ReplayTrace(DSHM_TRACES_DIR "/held_tilted.csv", &settings, &result);
+
+	//
+	// Never idle, stays on the nominal center
+	//
+	DS_TEST_ASSERT(!(result.State.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED));
+	DS_TEST_ASSERT(result.State.Sample.Flags & DS3_MOTION_FLAG_TILT_VALID);
+	DS_TEST_ASSERT(Abs(result.State.Sample.Pitch - 4500) <= 100);
+	DS_TEST_ASSERT(Abs(result.State.Sample.Roll + 3000) <= 100);
+
+	//
+	// Disabled tilt estimation reports nothing
+	//
+	settings.IsTiltEstimationEnabled = FALSE;
+
+	ReplayTrace(DSHM_TRACES_DIR "/held_tilted.csv", &settings, &result);
+
+	DS_TEST_ASSERT(!(result.State.Sample.Flags & DS3_MOTION_FLAG_TILT_VALID));
+	DS_TEST_ASSERT_EQ(result.State.Sample.Pitch, 0);
+	DS_TEST_ASSERT_EQ(result.State.Sample.Roll, 0);
+}
+
+static void VibrationPreventsCalibration(void)
+{
+	DS_MOTION_SETTINGS settings = DefaultSettings();
+	DS_TRACE_RESULT result;
+
+	ReplayTrace(DSHM_TRACES_DIR "/idle_vibrating.csv", &settings, &result);
+
+	DS_TEST_ASSERT(!(result.State.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED));
+	DS_TEST_ASSERT_EQ(result.State.GyroscopeBias, DS3_MOTION_GYROSCOPE_CENTER << 8);
+}
+
+static void DisabledCalibrationKeepsCenter(void)
+{
+	DS_MOTION_SETTINGS settings = DefaultSettings();
+	DS_TRACE_RESULT result;
+
+	settings.IsCalibrationEnabled = FALSE;
+
+	ReplayTrace(DSHM_TRACES_DIR "/resting_flat.csv", &settings, &result);
+
+	DS_TEST_ASSERT(!(result.State.Sample.Flags & DS3_MOTION_FLAG_CALIBRATED));
+	DS_TEST_ASSERT_EQ(result.State.GyroscopeBias, DS3_MOTION_GYROSCOPE_CENTER << 8);
+}
+
+//
+// Converters consume the re-centered raw field, a calibrated resting device reads the nominal center
+//
+static void ApplyRecentersRawGyroscope(void)
+{
+	DS_MOTION_SETTINGS settings = DefaultSettings();
+	DS_TRACE_RESULT result;
+	DS3_RAW_INPUT_REPORT report;
+
+	ReplayTrace(DSHM_TRACES_DIR "/rest_then_yaw.csv", &settings, &result);
+
+	memset(&report, 0, sizeof(report));
+	report.Gyroscope = _byteswap_ushort(490);
+
+	DS3_MOTION_APPLY(&result.State, &report);
+
+	DS_TEST_ASSERT(Abs((LONG)_byteswap_ushort(report.Gyroscope) - DS3_MOTION_GYROSCOPE_CENTER) <= 1);
+}
+
+int main(int argc, char* argv[])
+{
+	DS_TEST_RUN(RestingFlatCalibrates);
+	DS_TEST_RUN(HandlingKeepsBias);
+	DS_TEST_RUN(TiltEstimate);
+	DS_TEST_RUN(VibrationPreventsCalibration);
+	DS_TEST_RUN(DisabledCalibrationKeepsCenter);
+	DS_TEST_RUN(ApplyRecentersRawGyroscope);
+
+	for (int i = 1; i < argc; i++)
+	{
+		DS_MOTION_SETTINGS settings = DefaultSettings();
+		DS_TRACE_RESULT result;
+
+		ReplayTrace(argv[i], &settings, &result);
+	}
+
+	return DS_TEST_RESULT();
+}
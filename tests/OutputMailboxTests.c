@@ -0,0 +1,438 @@
+#define _GNU_SOURCE
+
+#include "DsPortable.h"
+#include "OutputMailbox.h"
+#include "DsTest.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+//
+// USB layout: report ID precedes the common layout
+//
+#define DS_TEST_HEADER_LENGTH	1
+#define DS_TEST_REPORT_LENGTH	(DS_TEST_HEADER_LENGTH + 48)
+#define DS_TEST_RUMBLE_OFFSET	(DS_TEST_HEADER_LENGTH + 1)
+#define DS_TEST_LED_OFFSET		(DS_TEST_HEADER_LENGTH + 9)
+
+static void UpdateDetectsChangedLanes(void)
+{
+	DS_OUTPUT_MAILBOX mailbox;
+	UCHAR report[DS_TEST_REPORT_LENGTH] = { 0x01 };
+
+	DS_OUTPUT_MAILBOX_INIT(&mailbox, DS_TEST_HEADER_LENGTH);
+
+	//
+	// First content is new in its entirety
+	//
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), DS_OUTPUT_LANE_FLAGS_ALL);
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), 0);
+
+	report[DS_TEST_RUMBLE_OFFSET + 2] = 0xFF;
+
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), DS_OUTPUT_LANE_FLAG(DsOutputLaneRumble));
+
+	report[DS_TEST_LED_OFFSET] = 0x02;
+	report[0] = 0x02;
+
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)),
+		DS_OUTPUT_LANE_FLAG(DsOutputLaneLed) | DS_OUTPUT_LANE_FLAG(DsOutputLaneControl));
+
+	//
+	// A different length or lost device state counts as changed entirely
+	//
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report) - 1), DS_OUTPUT_LANE_FLAGS_ALL);
+
+	DS_OUTPUT_MAILBOX_INVALIDATE(&mailbox);
+
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report) - 1), DS_OUTPUT_LANE_FLAGS_ALL);
+}
+
+static void PostsCoalesceIntoOneTake(void)
+{
+	DS_OUTPUT_MAILBOX mailbox;
+	UCHAR report[DS_TEST_REPORT_LENGTH] = { 0x01 };
+	UCHAR taken[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+	ULONG length, lanes;
+
+	DS_OUTPUT_MAILBOX_INIT(&mailbox, DS_TEST_HEADER_LENGTH);
+
+	DS_TEST_ASSERT(!DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, sizeof(taken), &length, &lanes));
+
+	for (UCHAR value = 1; value <= 10; value++)
+	{
+		report[DS_TEST_RUMBLE_OFFSET] = value;
+		DS_OUTPUT_MAILBOX_POST(&mailbox, DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), 5);
+	}
+
+	report[DS_TEST_LED_OFFSET] = 0x1E;
+	DS_OUTPUT_MAILBOX_POST(&mailbox, DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), 5);
+
+	DS_TEST_ASSERT(DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, sizeof(taken), &length, &lanes));
+	DS_TEST_ASSERT_EQ(length, DS_TEST_REPORT_LENGTH);
+	DS_TEST_ASSERT_EQ(taken[DS_TEST_RUMBLE_OFFSET], 10);
+	DS_TEST_ASSERT_EQ(taken[DS_TEST_LED_OFFSET], 0x1E);
+	DS_TEST_ASSERT(lanes & DS_OUTPUT_LANE_FLAG(DsOutputLaneRumble));
+	DS_TEST_ASSERT(lanes & DS_OUTPUT_LANE_FLAG(DsOutputLaneLed));
+
+	DS_TEST_ASSERT_EQ(mailbox.PostCount, 11);
+	DS_TEST_ASSERT_EQ(mailbox.CoalescedCount, 10);
+	DS_TEST_ASSERT_EQ(mailbox.TakeCount, 1);
+
+	//
+	// Nothing left behind
+	//
+	DS_TEST_ASSERT(!DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, sizeof(taken), &length, &lanes));
+	DS_TEST_ASSERT_EQ(mailbox.PendingPriority, MAXULONG);
+}
+
+static void PriorityKeepsMostUrgent(void)
+{
+	DS_OUTPUT_MAILBOX mailbox;
+	UCHAR report[DS_TEST_REPORT_LENGTH] = { 0x01 };
+	UCHAR taken[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+	ULONG length, lanes;
+
+	DS_OUTPUT_MAILBOX_INIT(&mailbox, DS_TEST_HEADER_LENGTH);
+	DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report));
+
+	//
+	// Escalating an empty mailbox has no effect
+	//
+	DS_OUTPUT_MAILBOX_ESCALATE(&mailbox, 0);
+
+	DS_TEST_ASSERT_EQ(mailbox.PendingPriority, MAXULONG);
+
+	DS_OUTPUT_MAILBOX_POST(&mailbox, DS_OUTPUT_LANE_FLAG(DsOutputLaneRumble), 2);
+	DS_OUTPUT_MAILBOX_POST(&mailbox, DS_OUTPUT_LANE_FLAG(DsOutputLaneLed), 7);
+
+	DS_TEST_ASSERT_EQ(mailbox.PendingPriority, 2);
+
+	DS_OUTPUT_MAILBOX_ESCALATE(&mailbox, 1);
+
+	DS_TEST_ASSERT_EQ(mailbox.PendingPriority, 1);
+	DS_TEST_ASSERT_EQ(mailbox.PostCount, 2);
+
+	//
+	// Too small a buffer leaves the posts pending
+	//
+	DS_TEST_ASSERT(!DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, DS_TEST_REPORT_LENGTH - 1, &length, &lanes));
+	DS_TEST_ASSERT(DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, sizeof(taken), &length, &lanes));
+	DS_TEST_ASSERT_EQ(lanes, DS_OUTPUT_LANE_FLAG(DsOutputLaneRumble) | DS_OUTPUT_LANE_FLAG(DsOutputLaneLed));
+}
+
+//
+// Bursty posts on a virtual clock against a worker taking once per send period: the oldest
+// pending post is never older than one period when taken, and what's taken is the latest
+//
+static void QueuedLatencyWithinSendPeriod(void)
+{
+	const ULONG period = 4000;
+	DS_OUTPUT_MAILBOX mailbox;
+	UCHAR report[DS_TEST_REPORT_LENGTH] = { 0x01 };
+	UCHAR taken[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+	ULONG length, lanes;
+	ULONGLONG clock = 0;
+	ULONGLONG nextTake = period;
+	ULONGLONG pendingSince = 0;
+	ULONGLONG maxAge = 0;
+	unsigned int seed = 1;
+	UCHAR latest = 0;
+
+	DS_OUTPUT_MAILBOX_INIT(&mailbox, DS_TEST_HEADER_LENGTH);
+
+	for (ULONG i = 0; i < 100000; i++)
+	{
+		//
+		// Bursts of back-to-back posts separated by idle stretches of up to three periods
+		//
+		clock += ((rand_r(&seed) % 16) == 0) ? ((ULONG)rand_r(&seed) % (3 * period)) : ((ULONG)rand_r(&seed) % 200);
+
+		while (nextTake <= clock)
+		{
+			if (DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, sizeof(taken), &length, &lanes))
+			{
+				maxAge = max(maxAge, nextTake - pendingSince);
+
+				DS_TEST_ASSERT_EQ(taken[DS_TEST_RUMBLE_OFFSET], latest);
+			}
+
+			nextTake += period;
+		}
+
+		report[DS_TEST_RUMBLE_OFFSET] = latest = (UCHAR)(latest + 1);
+
+		if (mailbox.PendingLanes == 0)
+		{
+			pendingSince = clock;
+		}
+
+		DS_OUTPUT_MAILBOX_POST(&mailbox, DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), 5);
+	}
+
+	printf("virtual clock: %llu posts, %llu sends, max queued latency %llu us (send period %u us)\n",
+		(unsigned long long)mailbox.PostCount,
+		(unsigned long long)mailbox.TakeCount,
+		(unsigned long long)maxAge,
+		period
+	);
+
+	DS_TEST_ASSERT(maxAge <= period);
+	DS_TEST_ASSERT(mailbox.CoalescedCount > mailbox.TakeCount);
+}
+
+//
+// Stress: several producers post as fast as games and tools would, one worker sends at most
+// once per send period like DSHM_EvtOutputReportWork does. The age of the oldest pending post
+// at the time it gets taken must stay within one send period, however many posts arrive.
+//
+
+#define DS_STRESS_SEND_PERIOD_US	4000
+#define DS_STRESS_SEND_US			1000
+#define DS_STRESS_PRODUCERS			4
+#define DS_STRESS_DURATION_MS		1000
+#define DS_STRESS_MAX_TAKES			((DS_STRESS_DURATION_MS * 1000 / DS_STRESS_SEND_PERIOD_US) + 16)
+
+typedef struct _DS_STRESS
+{
+	pthread_mutex_t Lock;
+	pthread_cond_t WorkReady;
+	DS_OUTPUT_MAILBOX Mailbox;
+	UCHAR Report[DS_TEST_REPORT_LENGTH];
+
+	//
+	// Time the oldest not yet taken post arrived
+	//
+	ULONGLONG PendingSince;
+
+	//
+	// Last value any producer posted
+	//
+	UCHAR LatestValue;
+
+	BOOLEAN IsStopped;
+
+	ULONG Latencies[DS_STRESS_MAX_TAKES];
+	ULONG TakeCount;
+	ULONG StaleTakes;
+} DS_STRESS, * PDS_STRESS;
+
+static void StressSleepUs(ULONG Us)
+{
+	struct timespec ts = { 0, (long)Us * 1000 };
+
+	nanosleep(&ts, NULL);
+}
+
+static void* StressProducer(void* Parameter)
+{
+	const PDS_STRESS stress = (PDS_STRESS)Parameter;
+	unsigned int seed = (unsigned int)(uintptr_t)&seed;
+	const ULONGLONG end = DsTestNowNs() + (DS_STRESS_DURATION_MS * 1000000ULL);
+
+	while (DsTestNowNs() < end)
+	{
+		pthread_mutex_lock(&stress->Lock);
+		{
+			const UCHAR value = (UCHAR)(stress->LatestValue + 1);
+
+			stress->Report[DS_TEST_RUMBLE_OFFSET] = value;
+			stress->Report[DS_TEST_LED_OFFSET] = (UCHAR)(value >> 4);
+			stress->LatestValue = value;
+
+			const ULONG lanes = DS_OUTPUT_MAILBOX_UPDATE(&stress->Mailbox, stress->Report, sizeof(stress->Report));
+
+			if (stress->Mailbox.PendingLanes == 0)
+			{
+				stress->PendingSince = DsTestNowNs();
+			}
+
+			DS_OUTPUT_MAILBOX_POST(&stress->Mailbox, lanes, 5);
+
+			pthread_cond_signal(&stress->WorkReady);
+		}
+		pthread_mutex_unlock(&stress->Lock);
+
+		StressSleepUs(50 + (rand_r(&seed) % 250));
+	}
+
+	return NULL;
+}
+
+static void* StressWorker(void* Parameter)
+{
+	const PDS_STRESS stress = (PDS_STRESS)Parameter;
+	UCHAR taken[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+	ULONGLONG lastSend = 0;
+	ULONG length, lanes;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&stress->Lock);
+
+		while (stress->Mailbox.PendingLanes == 0 && !stress->IsStopped)
+		{
+			pthread_cond_wait(&stress->WorkReady, &stress->Lock);
+		}
+
+		if (stress->Mailbox.PendingLanes == 0)
+		{
+			pthread_mutex_unlock(&stress->Lock);
+			break;
+		}
+
+		//
+		// Rate control: one send per period at most
+		//
+		const ULONGLONG now = DsTestNowNs();
+		const ULONGLONG due = lastSend + (DS_STRESS_SEND_PERIOD_US * 1000ULL);
+
+		if (lastSend != 0 && now < due)
+		{
+			pthread_mutex_unlock(&stress->Lock);
+			StressSleepUs((ULONG)((due - now) / 1000));
+			continue;
+		}
+
+		DS_OUTPUT_MAILBOX_TAKE(&stress->Mailbox, taken, sizeof(taken), &length, &lanes);
+
+		lastSend = DsTestNowNs();
+
+		if (stress->TakeCount < DS_STRESS_MAX_TAKES)
+		{
+			stress->Latencies[stress->TakeCount++] = (ULONG)((lastSend - stress->PendingSince) / 1000);
+		}
+
+		//
+		// Latest wins: whatever got taken is the most recent state
+		//
+		if (taken[DS_TEST_RUMBLE_OFFSET] != stress->LatestValue)
+		{
+			stress->StaleTakes++;
+		}
+
+		pthread_mutex_unlock(&stress->Lock);
+
+		//
+		// The send itself happens outside of the lock
+		//
+		StressSleepUs(DS_STRESS_SEND_US);
+	}
+
+	return NULL;
+}
+
+static int CompareUlong(const void* Left, const void* Right)
+{
+	const ULONG left = *(const ULONG*)Left;
+	const ULONG right = *(const ULONG*)Right;
+
+	return (left > right) - (left < right);
+}
+
+static void StressQueuedLatency(void)
+{
+	static DS_STRESS stress;
+	pthread_t producers[DS_STRESS_PRODUCERS];
+	pthread_t worker;
+
+	memset(&stress, 0, sizeof(stress));
+	pthread_mutex_init(&stress.Lock, NULL);
+	pthread_cond_init(&stress.WorkReady, NULL);
+	DS_OUTPUT_MAILBOX_INIT(&stress.Mailbox, DS_TEST_HEADER_LENGTH);
+	stress.Report[0] = 0x01;
+
+	pthread_create(&worker, NULL, StressWorker, &stress);
+
+	for (ULONG i = 0; i < DS_STRESS_PRODUCERS; i++)
+	{
+		pthread_create(&producers[i], NULL, StressProducer, &stress);
+	}
+
+	for (ULONG i = 0; i < DS_STRESS_PRODUCERS; i++)
+	{
+		pthread_join(producers[i], NULL);
+	}
+
+	pthread_mutex_lock(&stress.Lock);
+	stress.IsStopped = TRUE;
+	pthread_cond_signal(&stress.WorkReady);
+	pthread_mutex_unlock(&stress.Lock);
+
+	pthread_join(worker, NULL);
+
+	qsort(stress.Latencies, stress.TakeCount, sizeof(ULONG), CompareUlong);
+
+	const ULONG p99 = stress.Latencies[(stress.TakeCount * 99) / 100];
+	const ULONG maximum = stress.Latencies[stress.TakeCount - 1];
+
+	printf("mailbox stress: %llu posts, %llu coalesced, %llu sends, queued latency median %u us, p99 %u us, max %u us (send period %u us)\n",
+		(unsigned long long)stress.Mailbox.PostCount,
+		(unsigned long long)stress.Mailbox.CoalescedCount,
+		(unsigned long long)stress.Mailbox.TakeCount,
+		stress.Latencies[stress.TakeCount / 2],
+		p99,
+		maximum,
+		DS_STRESS_SEND_PERIOD_US
+	);
+
+	DS_TEST_ASSERT_EQ(stress.StaleTakes, 0);
+	DS_TEST_ASSERT(stress.Mailbox.PostCount > stress.Mailbox.TakeCount * 2);
+	DS_TEST_ASSERT_EQ(stress.Mailbox.PostCount, stress.Mailbox.CoalescedCount + stress.Mailbox.TakeCount);
+
+	//
+	// Nothing queues up behind a send. Host timer overshoot shows in the tail, the strict
+	// bound is checked on the virtual clock by QueuedLatencyWithinSendPeriod
+	//
+	DS_TEST_ASSERT(stress.Latencies[stress.TakeCount / 2] <= DS_STRESS_SEND_PERIOD_US + 500);
+
+	pthread_cond_destroy(&stress.WorkReady);
+	pthread_mutex_destroy(&stress.Lock);
+}
+
+//
+// Cost of an update and post pair, the part running on the caller's thread
+//
+static void BenchmarkUpdateAndPost(void)
+{
+	const ULONG iterations = 5 * 1000 * 1000;
+	DS_OUTPUT_MAILBOX mailbox;
+	UCHAR report[DS_TEST_REPORT_LENGTH] = { 0x01 };
+	UCHAR taken[DS_OUTPUT_MAILBOX_REPORT_SIZE];
+	ULONG length, lanes;
+
+	DS_OUTPUT_MAILBOX_INIT(&mailbox, DS_TEST_HEADER_LENGTH);
+
+	const ULONGLONG start = DsTestNowNs();
+
+	for (ULONG i = 0; i < iterations; i++)
+	{
+		report[DS_TEST_RUMBLE_OFFSET] = (UCHAR)i;
+		DS_OUTPUT_MAILBOX_POST(&mailbox, DS_OUTPUT_MAILBOX_UPDATE(&mailbox, report, sizeof(report)), 5);
+
+		if ((i & 0xF) == 0)
+		{
+			DS_OUTPUT_MAILBOX_TAKE(&mailbox, taken, sizeof(taken), &length, &lanes);
+		}
+	}
+
+	const double perPost = (double)(DsTestNowNs() - start) / iterations;
+
+	DS_TEST_KEEP(mailbox.PostCount);
+
+	printf("DS_OUTPUT_MAILBOX_UPDATE + POST: %.2f ns/post\n", perPost);
+
+	DS_TEST_ASSERT(perPost < 2000.0);
+}
+
+int main(void)
+{
+	DS_TEST_RUN(UpdateDetectsChangedLanes);
+	DS_TEST_RUN(PostsCoalesceIntoOneTake);
+	DS_TEST_RUN(PriorityKeepsMostUrgent);
+	DS_TEST_RUN(QueuedLatencyWithinSendPeriod);
+	DS_TEST_RUN(StressQueuedLatency);
+	DS_TEST_RUN(BenchmarkUpdateAndPost);
+
+	return DS_TEST_RESULT();
+}
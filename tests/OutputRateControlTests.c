@@ -0,0 +1,295 @@
+#include "DsPortable.h"
+#include "OutputRateControl.h"
+#include "DsTest.h"
+
+//
+// Virtual clock in microseconds, starts at an arbitrary non-zero time
+//
+static ULONGLONG Clock;
+
+//
+// Waits out the current period, sends, and completes after Latency microseconds
+//
+static void Send(PDS_OUTPUT_RATE_CONTROL Control, ULONG Latency, BOOLEAN IsSuccess)
+{
+	Clock += DS_OUTPUT_RATE_CONTROL_GET_DELAY(Control, Clock);
+
+	const ULONGLONG sent = Clock;
+
+	Clock += Latency;
+
+	DS_OUTPUT_RATE_CONTROL_COMPLETE(Control, sent, Clock, IsSuccess);
+}
+
+static void Reset(PDS_OUTPUT_RATE_CONTROL Control, ULONG MinPeriod, ULONG MaxPeriod)
+{
+	Clock = 1000000;
+
+	DS_OUTPUT_RATE_CONTROL_INIT(Control, MinPeriod, MaxPeriod);
+}
+
+static void InitStartsAtMinimum(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 2000, 64000);
+
+	DS_TEST_ASSERT_EQ(control.Period, 2000);
+	DS_TEST_ASSERT_EQ(control.PeakPeriod, 2000);
+	DS_TEST_ASSERT_EQ(control.SendCount, 0);
+
+	//
+	// Inverted bounds collapse to the maximum
+	//
+	Reset(&control, 8000, 4000);
+
+	DS_TEST_ASSERT_EQ(control.MinPeriod, 4000);
+	DS_TEST_ASSERT_EQ(control.Period, 4000);
+}
+
+static void DelayHonorsPeriod(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 4000, 64000);
+
+	//
+	// Nothing sent yet
+	//
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_RATE_CONTROL_GET_DELAY(&control, Clock), 0);
+
+	Send(&control, 500, TRUE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 4000);
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_RATE_CONTROL_GET_DELAY(&control, Clock), 4000);
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_RATE_CONTROL_GET_DELAY(&control, Clock + 1500), 2500);
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_RATE_CONTROL_GET_DELAY(&control, Clock + 4000), 0);
+
+	//
+	// A clock going backwards never blocks
+	//
+	DS_TEST_ASSERT_EQ(DS_OUTPUT_RATE_CONTROL_GET_DELAY(&control, Clock - 1), 0);
+}
+
+static void SlowSendBacksOff(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 1000, 64000);
+
+	//
+	// Slower than the doubled period, wait at least as long as the send took
+	//
+	Send(&control, 3000, TRUE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 3000);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 1);
+
+	//
+	// Just slower than the period, multiplicative increase
+	//
+	Send(&control, 3100, TRUE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 6000);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 2);
+	DS_TEST_ASSERT_EQ(control.PeakPeriod, 6000);
+	DS_TEST_ASSERT_EQ(control.FailureCount, 0);
+}
+
+static void FailureBacksOff(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 4000, 64000);
+
+	Send(&control, 200, FALSE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 8000);
+	DS_TEST_ASSERT_EQ(control.FailureCount, 1);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 1);
+}
+
+static void BackoffStopsAtMaximum(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 4000, 20000);
+
+	for (int i = 0; i < 10; i++)
+	{
+		Send(&control, 200, FALSE);
+	}
+
+	DS_TEST_ASSERT_EQ(control.Period, 20000);
+	DS_TEST_ASSERT_EQ(control.PeakPeriod, 20000);
+
+	//
+	// 8000, 16000, 20000, no increase beyond that
+	//
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 3);
+	DS_TEST_ASSERT_EQ(control.FailureCount, 10);
+}
+
+static void ZeroMinimumBacksOffByAtLeastOneStep(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 0, 64000);
+
+	Send(&control, 0, FALSE);
+
+	DS_TEST_ASSERT_EQ(control.Period, DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US);
+}
+
+static void TimelySendsDecreaseToMinimum(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 1000, 64000);
+
+	//
+	// Only failures, the average completion time stays negligible
+	//
+	Send(&control, 10, FALSE);
+	Send(&control, 10, FALSE);
+	Send(&control, 10, FALSE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 8000);
+
+	for (ULONG expected = 7000; expected >= 1000; expected -= 1000)
+	{
+		Send(&control, 10, TRUE);
+
+		DS_TEST_ASSERT_EQ(control.Period, expected);
+	}
+
+	Send(&control, 10, TRUE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 1000);
+	DS_TEST_ASSERT_EQ(control.PeakPeriod, 8000);
+}
+
+//
+// The decrease never undercuts the smoothed completion time, which itself decays
+// towards the current latency, so the period follows it down instead of stepping
+//
+static void DecreaseFollowsAverageFloor(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 1000, 64000);
+
+	//
+	// One slow send seeds the average with 5000
+	//
+	Send(&control, 5000, TRUE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 5000);
+	DS_TEST_ASSERT_EQ(control.SmoothedCompletion / DS_OUTPUT_RATE_CONTROL_SMOOTHING, 5000);
+
+	ULONG previous = control.Period;
+	int flooredSteps = 0;
+
+	for (int i = 0; i < 64; i++)
+	{
+		Send(&control, 100, TRUE);
+
+		const ULONG average = control.SmoothedCompletion / DS_OUTPUT_RATE_CONTROL_SMOOTHING;
+		const ULONG stepped = (previous > DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US)
+			? previous - DS_OUTPUT_RATE_CONTROL_DECREASE_STEP_US
+			: 0;
+
+		DS_TEST_ASSERT_EQ(control.Period, max(max(stepped, average), control.MinPeriod));
+		DS_TEST_ASSERT(control.Period <= previous);
+
+		if (average > stepped && average > control.MinPeriod)
+		{
+			flooredSteps++;
+		}
+
+		previous = control.Period;
+	}
+
+	//
+	// First step: average (35100 / 8 = 4387) beats 5000 - 1000
+	//
+	DS_TEST_ASSERT(flooredSteps > 0);
+	DS_TEST_ASSERT_EQ(control.Period, 1000);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 1);
+}
+
+//
+// A steady latency settles exactly on it, without oscillating between backoff and decrease
+//
+static void SteadyLatencySettles(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 1000, 64000);
+
+	for (int i = 0; i < 100; i++)
+	{
+		Send(&control, 2500, TRUE);
+	}
+
+	DS_TEST_ASSERT_EQ(control.Period, 2500);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 1);
+	DS_TEST_ASSERT_EQ(control.SendCount, 100);
+}
+
+//
+// A single spike backs off, the recovery is bounded below by the average it inflated
+//
+static void SpikeRecovery(void)
+{
+	DS_OUTPUT_RATE_CONTROL control;
+
+	Reset(&control, 1000, 64000);
+
+	for (int i = 0; i < 50; i++)
+	{
+		Send(&control, 2500, TRUE);
+	}
+
+	Send(&control, 9000, TRUE);
+
+	DS_TEST_ASSERT_EQ(control.Period, 9000);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 2);
+
+	const ULONGLONG recoveryStart = Clock;
+	int sends = 0;
+
+	while (control.Period > 2500 && sends < 100)
+	{
+		Send(&control, 2500, TRUE);
+		sends++;
+
+		DS_TEST_ASSERT(control.Period >= 2500);
+	}
+
+	DS_TEST_ASSERT_EQ(control.Period, 2500);
+	DS_TEST_ASSERT_EQ(control.BackoffCount, 2);
+
+	//
+	// 9000 to 2500 in 1000 steps, slowed down by the floor
+	//
+	DS_TEST_ASSERT(sends >= 7);
+
+	printf("spike recovery: %d sends, %llu us\n", sends, (unsigned long long)(Clock - recoveryStart));
+}
+
+int main(void)
+{
+	DS_TEST_RUN(InitStartsAtMinimum);
+	DS_TEST_RUN(DelayHonorsPeriod);
+	DS_TEST_RUN(SlowSendBacksOff);
+	DS_TEST_RUN(FailureBacksOff);
+	DS_TEST_RUN(BackoffStopsAtMaximum);
+	DS_TEST_RUN(ZeroMinimumBacksOffByAtLeastOneStep);
+	DS_TEST_RUN(TimelySendsDecreaseToMinimum);
+	DS_TEST_RUN(DecreaseFollowsAverageFloor);
+	DS_TEST_RUN(SteadyLatencySettles);
+	DS_TEST_RUN(SpikeRecovery);
+
+	return DS_TEST_RESULT();
+}
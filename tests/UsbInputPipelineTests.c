@@ -0,0 +1,396 @@
+//
+// USB interrupt IN reader tests against a simulated completion source
+//
+//   The device emits a report every DS_SIM_REPORT_PERIOD_US. A report arriving while a read is
+//   pending completes it, one arriving while none is pending is lost. Each completion reaches
+//   DsUsb_EvtUsbInterruptPipeReadComplete after a dispatch delay, a small share gets stalled on
+//   the way to emulate scheduling hiccups. The framework doesn't serialize the callbacks, so with
+//   more than one pending read a stalled completion gets applied after younger ones. The read is
+//   re-posted once the callback returned, like the WDF continuous reader does.
+//
+//   Some transfers are injected as short packets or broken reports, a misbehaving hub may hold
+//   a report back and deliver it together with the next one if the transfer length allows.
+//   Everything runs on a virtual clock, results only depend on the reader settings.
+//
+
+#include "DsPortable.h"
+#include <DsHidMini/Ds3Types.h>
+#include "UsbInputPipeline.h"
+#include "InputInterval.h"
+#include "DsTest.h"
+
+#define DS_SIM_REPORT_PERIOD_US		1000
+#define DS_SIM_REPORT_COUNT			5000
+#define DS_SIM_DISPATCH_US			50
+#define DS_SIM_PROCESSING_US		20
+#define DS_SIM_STALL_US				2500
+#define DS_SIM_STALL_PERMILLE		20
+#define DS_SIM_SHORT_PERMILLE		5
+#define DS_SIM_SHORT_LENGTH			16
+#define DS_SIM_BROKEN_PERMILLE		2
+#define DS_SIM_BATCH_PERMILLE		10
+#define DS_SIM_MAX_DEPTH			10
+#define DS_SIM_MAX_TRANSFER_LENGTH	1024
+
+typedef struct _DS_SIM_COMPLETION
+{
+	BOOLEAN IsInUse;
+	BOOLEAN IsApplied;
+
+	//
+	// Callback entry and return time
+	//
+	ULONGLONG Start;
+	ULONGLONG End;
+
+	size_t NumBytesTransferred;
+	UCHAR Buffer[DS_SIM_MAX_TRANSFER_LENGTH];
+} DS_SIM_COMPLETION;
+
+typedef struct _DS_SIM_READER
+{
+	//
+	// Reader settings under test
+	//
+	ULONG RequestCount;
+	ULONG TransferLength;
+
+	ULONG PendingReads;
+	DS_SIM_COMPLETION Completions[DS_SIM_MAX_DEPTH];
+
+	//
+	// What the completion routine maintains
+	//
+	DS_USB_INPUT_PIPELINE_STATS Stats;
+	DS_INPUT_INTERVAL_STATS Interval;
+	USHORT AppliedSequence;
+
+	//
+	// Source side accounting
+	//
+	ULONGLONG Lost;
+	ULONGLONG Batched;
+	ULONGLONG Delivered;
+	ULONGLONG Broken;
+	ULONGLONG OutOfOrder;
+} DS_SIM_READER, * PDS_SIM_READER;
+
+//
+// Deterministic per-report decision, the same reports get disturbed whatever the settings
+//
+static BOOLEAN Chance(ULONG Sequence, ULONG Salt, ULONG Permille)
+{
+	ULONG hash = (Sequence * 2654435761u) ^ (Salt * 40503u);
+
+	hash ^= hash >> 15;
+	hash *= 2246822519u;
+	hash ^= hash >> 13;
+
+	return (BOOLEAN)((hash % 1000) < Permille);
+}
+
+static void WriteReport(UCHAR* Buffer, USHORT Sequence)
+{
+	DS3_RAW_INPUT_REPORT report;
+
+	memset(&report, 0, sizeof(report));
+	report.ReportId = 0x01;
+	report.Reserved0 = Chance(Sequence, 3, DS_SIM_BROKEN_PERMILLE) ? 0xFF : 0x00;
+	report.AccelerometerX = Sequence;
+
+	memcpy(Buffer, &report, sizeof(report));
+}
+
+//
+// DsUsb_EvtUsbInterruptPipeReadComplete up to the point the report gets converted
+//
+static void ApplyCompletion(PDS_SIM_READER Reader, DS_SIM_COMPLETION* Completion)
+{
+	switch (DS_USB_INPUT_PIPELINE_VALIDATE(&Reader->Stats, Completion->Buffer, Completion->NumBytesTransferred))
+	{
+	case DsUsbInputTransferShort:
+		return;
+	case DsUsbInputTransferBroken:
+		Reader->Broken++;
+		return;
+	default:
+		break;
+	}
+
+	const USHORT sequence = ((const DS3_RAW_INPUT_REPORT*)Completion->Buffer)->AccelerometerX;
+
+	DS_INPUT_INTERVAL_UPDATE(&Reader->Interval, Completion->Start);
+
+	if (sequence < Reader->AppliedSequence)
+	{
+		Reader->OutOfOrder++;
+	}
+
+	Reader->AppliedSequence = sequence;
+	Reader->Delivered++;
+}
+
+//
+// Runs all callback entries and returns up to and including Now, earliest first
+//
+static void Advance(PDS_SIM_READER Reader, ULONGLONG Now)
+{
+	for (;;)
+	{
+		DS_SIM_COMPLETION* pNext = NULL;
+		ULONGLONG next = 0;
+
+		for (ULONG i = 0; i < DS_SIM_MAX_DEPTH; i++)
+		{
+			DS_SIM_COMPLETION* pCompletion = &Reader->Completions[i];
+			const ULONGLONG due = pCompletion->IsApplied ? pCompletion->End : pCompletion->Start;
+
+			if (pCompletion->IsInUse && due <= Now && (pNext == NULL || due < next))
+			{
+				pNext = pCompletion;
+				next = due;
+			}
+		}
+
+		if (pNext == NULL)
+		{
+			return;
+		}
+
+		if (!pNext->IsApplied)
+		{
+			ApplyCompletion(Reader, pNext);
+			pNext->IsApplied = TRUE;
+		}
+		else
+		{
+			//
+			// Callback returned, the framework re-posts the read
+			//
+			pNext->IsInUse = FALSE;
+			Reader->PendingReads++;
+		}
+	}
+}
+
+static void RunReader(PDS_SIM_READER Reader, ULONG RequestCount, ULONG TransferLength)
+{
+	memset(Reader, 0, sizeof(*Reader));
+	Reader->RequestCount = RequestCount;
+	Reader->TransferLength = TransferLength;
+	Reader->PendingReads = RequestCount;
+	DS_INPUT_INTERVAL_INIT(&Reader->Interval);
+
+	const BOOLEAN canBatch = (TransferLength >= sizeof(DS3_RAW_INPUT_REPORT) * 2);
+	BOOLEAN isHeldBack = FALSE;
+
+	for (USHORT sequence = 1; sequence <= DS_SIM_REPORT_COUNT; sequence++)
+	{
+		const ULONGLONG now = (ULONGLONG)sequence * DS_SIM_REPORT_PERIOD_US;
+
+		Advance(Reader, now);
+
+		//
+		// Hub holds this one back and sends it along with the next
+		//
+		if (canBatch && !isHeldBack && sequence < DS_SIM_REPORT_COUNT && Chance(sequence, 1, DS_SIM_BATCH_PERMILLE))
+		{
+			isHeldBack = TRUE;
+			continue;
+		}
+
+		if (Reader->PendingReads == 0)
+		{
+			Reader->Lost += isHeldBack ? 2 : 1;
+			isHeldBack = FALSE;
+			continue;
+		}
+
+		DS_SIM_COMPLETION* pCompletion = NULL;
+
+		for (ULONG i = 0; i < DS_SIM_MAX_DEPTH && pCompletion == NULL; i++)
+		{
+			if (!Reader->Completions[i].IsInUse)
+			{
+				pCompletion = &Reader->Completions[i];
+			}
+		}
+
+		Reader->PendingReads--;
+
+		pCompletion->IsInUse = TRUE;
+		pCompletion->IsApplied = FALSE;
+		pCompletion->Start = now + DS_SIM_DISPATCH_US + (Chance(sequence, 2, DS_SIM_STALL_PERMILLE) ? DS_SIM_STALL_US : 0);
+		pCompletion->End = pCompletion->Start + DS_SIM_PROCESSING_US;
+
+		if (isHeldBack)
+		{
+			WriteReport(pCompletion->Buffer, sequence - 1);
+			WriteReport(pCompletion->Buffer + sizeof(DS3_RAW_INPUT_REPORT), sequence);
+			pCompletion->NumBytesTransferred = sizeof(DS3_RAW_INPUT_REPORT) * 2;
+
+			Reader->Batched++;
+			isHeldBack = FALSE;
+		}
+		else if (Chance(sequence, 4, DS_SIM_SHORT_PERMILLE))
+		{
+			WriteReport(pCompletion->Buffer, sequence);
+			pCompletion->NumBytesTransferred = DS_SIM_SHORT_LENGTH;
+		}
+		else
+		{
+			WriteReport(pCompletion->Buffer, sequence);
+			pCompletion->NumBytesTransferred = sizeof(DS3_RAW_INPUT_REPORT);
+		}
+	}
+
+	Advance(Reader, MAXULONG);
+
+	//
+	// Same figures as the UsbInputPipelineStatistics event of the validation mode
+	//
+	printf("%2u reads x %4u bytes: delivered %llu, lost %llu, gaps %llu (%llu missed), short %llu, oversized %llu, broken %llu, out of order %llu\n",
+		Reader->RequestCount,
+		Reader->TransferLength,
+		(unsigned long long)Reader->Delivered,
+		(unsigned long long)Reader->Lost,
+		(unsigned long long)Reader->Interval.GapCount,
+		(unsigned long long)Reader->Interval.MissedReports,
+		(unsigned long long)Reader->Stats.ShortTransferCount,
+		(unsigned long long)Reader->Stats.OversizedTransferCount,
+		(unsigned long long)Reader->Broken,
+		(unsigned long long)Reader->OutOfOrder
+	);
+
+	//
+	// Every report is accounted for, a batched transfer only yields its first report
+	//
+	DS_TEST_ASSERT_EQ(
+		Reader->Delivered + Reader->Broken + Reader->Stats.ShortTransferCount + Reader->Batched + Reader->Lost,
+		DS_SIM_REPORT_COUNT
+	);
+	DS_TEST_ASSERT_EQ(Reader->Stats.OversizedTransferCount, Reader->Batched);
+
+	//
+	// Only processed reports reach the interval statistics
+	//
+	DS_TEST_ASSERT_EQ(Reader->Interval.Count, Reader->Delivered - 1);
+}
+
+static void ValidateExactReport(void)
+{
+	DS_USB_INPUT_PIPELINE_STATS stats = { 0 };
+	UCHAR buffer[DS_SIM_MAX_TRANSFER_LENGTH] = { 0 };
+
+	WriteReport(buffer, 1);
+	((PDS3_RAW_INPUT_REPORT)buffer)->Reserved0 = 0x00;
+
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, sizeof(DS3_RAW_INPUT_REPORT)), DsUsbInputTransferReport);
+
+	//
+	// Anything below two complete reports is a single one with some trailing bytes
+	//
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, sizeof(DS3_RAW_INPUT_REPORT) * 2 - 1), DsUsbInputTransferReport);
+	DS_TEST_ASSERT_EQ(stats.ShortTransferCount, 0);
+	DS_TEST_ASSERT_EQ(stats.OversizedTransferCount, 0);
+}
+
+static void ValidateShortPackets(void)
+{
+	DS_USB_INPUT_PIPELINE_STATS stats = { 0 };
+	UCHAR buffer[DS_SIM_MAX_TRANSFER_LENGTH];
+
+	//
+	// Content is never looked at
+	//
+	memset(buffer, 0xFF, sizeof(buffer));
+
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, 0), DsUsbInputTransferShort);
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, DS_SIM_SHORT_LENGTH), DsUsbInputTransferShort);
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, sizeof(DS3_RAW_INPUT_REPORT) - 1), DsUsbInputTransferShort);
+	DS_TEST_ASSERT_EQ(stats.ShortTransferCount, 3);
+	DS_TEST_ASSERT_EQ(stats.OversizedTransferCount, 0);
+}
+
+static void ValidateOversizedTransfers(void)
+{
+	DS_USB_INPUT_PIPELINE_STATS stats = { 0 };
+	UCHAR buffer[DS_SIM_MAX_TRANSFER_LENGTH] = { 0 };
+
+	WriteReport(buffer, 1);
+	((PDS3_RAW_INPUT_REPORT)buffer)->Reserved0 = 0x00;
+
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, sizeof(DS3_RAW_INPUT_REPORT) * 2), DsUsbInputTransferReport);
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, DS_SIM_MAX_TRANSFER_LENGTH), DsUsbInputTransferReport);
+	DS_TEST_ASSERT_EQ(stats.OversizedTransferCount, 2);
+
+	//
+	// A broken leading report still counts the transfer as oversized
+	//
+	((PDS3_RAW_INPUT_REPORT)buffer)->Reserved0 = 0xFF;
+
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, sizeof(DS3_RAW_INPUT_REPORT) * 2), DsUsbInputTransferBroken);
+	DS_TEST_ASSERT_EQ(DS_USB_INPUT_PIPELINE_VALIDATE(&stats, buffer, sizeof(DS3_RAW_INPUT_REPORT)), DsUsbInputTransferBroken);
+	DS_TEST_ASSERT_EQ(stats.OversizedTransferCount, 3);
+	DS_TEST_ASSERT_EQ(stats.ShortTransferCount, 0);
+}
+
+//
+// Reader depth and transfer length within the configurable range
+//
+static void SimulatedReaderSettings(void)
+{
+	static DS_SIM_READER reader;
+	const ULONG depths[] = { 1, 2, 4, 10 };
+	ULONGLONG lost[4], gaps[4], outOfOrder[4];
+
+	for (ULONG i = 0; i < 4; i++)
+	{
+		RunReader(&reader, depths[i], 128);
+
+		lost[i] = reader.Lost;
+		gaps[i] = reader.Interval.GapCount;
+		outOfOrder[i] = reader.OutOfOrder;
+
+		DS_TEST_ASSERT(reader.Batched > 0);
+	}
+
+	//
+	// A single read can't be reordered but loses everything arriving during a stalled callback
+	//
+	DS_TEST_ASSERT_EQ(outOfOrder[0], 0);
+	DS_TEST_ASSERT(lost[0] > 0);
+	DS_TEST_ASSERT(gaps[0] > 0);
+
+	//
+	// More reads in flight bridge the stalls, at the price of stalled completions applying late
+	//
+	DS_TEST_ASSERT(lost[1] < lost[0]);
+	DS_TEST_ASSERT_EQ(lost[2], 0);
+	DS_TEST_ASSERT_EQ(lost[3], 0);
+	DS_TEST_ASSERT(gaps[2] < gaps[0]);
+	DS_TEST_ASSERT(outOfOrder[2] > 0);
+
+	//
+	// The smallest transfer length can't carry two reports, held back ones arrive separately
+	//
+	RunReader(&reader, 2, 64);
+
+	DS_TEST_ASSERT_EQ(reader.Batched, 0);
+	DS_TEST_ASSERT_EQ(reader.Stats.OversizedTransferCount, 0);
+	DS_TEST_ASSERT(reader.Stats.ShortTransferCount > 0);
+
+	RunReader(&reader, 2, DS_SIM_MAX_TRANSFER_LENGTH);
+
+	DS_TEST_ASSERT(reader.Stats.OversizedTransferCount > 0);
+}
+
+int main(void)
+{
+	DS_TEST_RUN(ValidateExactReport);
+	DS_TEST_RUN(ValidateShortPackets);
+	DS_TEST_RUN(ValidateOversizedTransfers);
+	DS_TEST_RUN(SimulatedReaderSettings);
+
+	return DS_TEST_RESULT();
+}
@@ -0,0 +1,4 @@
+//
+// Stand-in for the Windows SDK header of the same name
+//
+#pragma pack(pop)